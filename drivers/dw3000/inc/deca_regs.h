@@ -1,25 +1,26 @@
-! ---------------------------------------------------------------------------
+/*! ---------------------------------------------------------------------------
   @file    deca_regs.h
   @brief   DW3000 Register Definitions
            This file supports Assembly and C development for DW3000 enabled devices
- 
+
   @author  Decawave Software
   @attention
   Copyright 2019 - 2020 (c) Decawave Ltd, Dublin, Ireland.
   All rights reserved.
+ */
  
 
 #ifndef __DECA_REGS_H
 #define __DECA_REGS_H                         1
 
 #ifdef __cplusplus
-extern C {
+extern "C" {
 #endif
 
-#include deca_vals.h
+/* deca_vals.h is not part of this driver release */
 
 
- @brief Bit definitions for register DEV_ID
+/* @brief Bit definitions for register DEV_ID */
 
 #define DEV_ID_ID                            0x0                  
 #define DEV_ID_LEN                           (4U)                
@@ -38,7 +39,7 @@ extern C {
 #define DEV_ID_REV_BIT_MASK                  0xfU                 
 
 
- @brief Bit definitions for register EUI_64_LO
+/* @brief Bit definitions for register EUI_64_LO */
 
 #define EUI_64_LO_ID                         0x4                  
 #define EUI_64_LO_LEN                        (4U)                
@@ -48,7 +49,7 @@ extern C {
 #define EUI_64_LO_EUI_64_BIT_MASK            0xffffffffUL         
 
 
- @brief Bit definitions for register EUI_64_HI
+/* @brief Bit definitions for register EUI_64_HI */
 
 #define EUI_64_HI_ID                         0x8                  
 #define EUI_64_HI_LEN                        (4U)                
@@ -58,7 +59,7 @@ extern C {
 #define EUI_64_HI_EUI_64_BIT_MASK            0xffffffffUL         
 
 
- @brief Bit definitions for register PANADR
+/* @brief Bit definitions for register PANADR */
 
 #define PANADR_ID                            0xc                  
 #define PANADR_LEN                           (4U)                
@@ -71,7 +72,7 @@ extern C {
 #define PANADR_SHORTADDR_BIT_MASK            0xffffU              
 
 
- @brief Bit definitions for register SYS_CFG
+/* @brief Bit definitions for register SYS_CFG */
 
 #define SYS_CFG_ID                           0x10                 
 #define SYS_CFG_LEN                          (4U)                
@@ -126,7 +127,7 @@ extern C {
 #define SYS_CFG_FFEN_BIT_MASK                0x1U                 
 
 
- @brief Bit definitions for register ADR_FILT_CFG
+/* @brief Bit definitions for register ADR_FILT_CFG */
 
 #define ADR_FILT_CFG_ID                      0x14                 
 #define ADR_FILT_CFG_LEN                     (4U)                
@@ -181,7 +182,7 @@ extern C {
 #define ADR_FILT_CFG_FFAB_BIT_MASK           0x1U                 
 
 
- @brief Bit definitions for register SPICRC_CFG
+/* @brief Bit definitions for register SPICRC_CFG */
 
 #define SPICRC_CFG_ID                        0x18                 
 #define SPICRC_CFG_LEN                       (4U)                
@@ -191,7 +192,7 @@ extern C {
 #define SPICRC_CFG_SPI_RD_CRC_BIT_MASK       0xffU                
 
 
- @brief Bit definitions for register SYS_TIME
+/* @brief Bit definitions for register SYS_TIME */
 
 #define SYS_TIME_ID                          0x1c                 
 #define SYS_TIME_LEN                         (4U)                
@@ -201,7 +202,7 @@ extern C {
 #define SYS_TIME_SYS_TIME_BIT_MASK           0xfffffffeUL         
 
 
- @brief Bit definitions for register TX_FCTRL
+/* @brief Bit definitions for register TX_FCTRL */
 
 #define TX_FCTRL_ID                          0x24                 
 #define TX_FCTRL_LEN                         (4U)                
@@ -223,7 +224,7 @@ extern C {
 #define TX_FCTRL_TXFLEN_BIT_MASK             0x3ffU               
 
 
- @brief Bit definitions for register TX_FCTRL_HI
+/* @brief Bit definitions for register TX_FCTRL_HI */
 
 #define TX_FCTRL_HI_ID                       0x28                 
 #define TX_FCTRL_HI_LEN                      (4U)                
@@ -233,7 +234,7 @@ extern C {
 #define TX_FCTRL_HI_FINE_PLEN_BIT_MASK       0xff00U              
 
 
- @brief Bit definitions for register DX_TIME
+/* @brief Bit definitions for register DX_TIME */
 
 #define DX_TIME_ID                           0x2c                 
 #define DX_TIME_LEN                          (4U)                
@@ -243,7 +244,7 @@ extern C {
 #define DX_TIME_DX_TIME_BIT_MASK             0xfffffffeUL         
 
 
- @brief Bit definitions for register DREF_TIME
+/* @brief Bit definitions for register DREF_TIME */
 
 #define DREF_TIME_ID                         0x30                 
 #define DREF_TIME_LEN                        (4U)                
@@ -253,7 +254,7 @@ extern C {
 #define DREF_TIME_DREF_BIT_MASK              0xfffffffeUL         
 
 
- @brief Bit definitions for register RX_FWTO
+/* @brief Bit definitions for register RX_FWTO */
 
 #define RX_FWTO_ID                           0x34                 
 #define RX_FWTO_LEN                          (4U)                
@@ -263,7 +264,7 @@ extern C {
 #define RX_FWTO_FWTO_BIT_MASK                0xfffffUL            
 
 
- @brief Bit definitions for register SYS_ENABLE_LO
+/* @brief Bit definitions for register SYS_ENABLE_LO */
 
 #define SYS_ENABLE_LO_ID                     0x3c                 
 #define SYS_ENABLE_LO_LEN                    (4U)                
@@ -354,7 +355,7 @@ extern C {
 #define SYS_ENABLE_LO_CP_LOCK_ENABLE_BIT_MASK   0x2U                 
 
 
- @brief Bit definitions for register SYS_ENABLE_HI
+/* @brief Bit definitions for register SYS_ENABLE_HI */
 
 #define SYS_ENABLE_HI_ID                     0x40                 
 #define SYS_ENABLE_HI_LEN                    (4U)                
@@ -392,7 +393,7 @@ extern C {
                  
 
 
- @brief Bit definitions for register SYS_STATUS
+/* @brief Bit definitions for register SYS_STATUS */
 
 #define SYS_STATUS_ID                        0x44                 
 #define SYS_STATUS_LEN                       (4U)                
@@ -486,7 +487,7 @@ extern C {
 #define SYS_STATUS_IRQS_BIT_MASK             0x1U                 
 
 
- @brief Bit definitions for register SYS_STATUS_HI
+/* @brief Bit definitions for register SYS_STATUS_HI */
 
 #define SYS_STATUS_HI_ID                     0x48                 
 #define SYS_STATUS_HI_LEN                    (4U)                
@@ -524,7 +525,7 @@ extern C {
               
 
 
- @brief Bit definitions for register RX_FINFO
+/* @brief Bit definitions for register RX_FINFO */
 
 #define RX_FINFO_ID                          0x4c                 
 #define RX_FINFO_LEN                         (4U)                
@@ -556,7 +557,7 @@ extern C {
 
 
 
- @brief Bit definitions for register RX_TIME_0
+/* @brief Bit definitions for register RX_TIME_0 */
 
 #define RX_TIME_0_ID                         0x64                 
 #define RX_TIME_0_LEN                        (4U)                
@@ -565,7 +566,7 @@ extern C {
 
 
 
- @brief Bit definitions for register RX_TIME_RAW
+/* @brief Bit definitions for register RX_TIME_RAW */
 
 #define RX_TIME_RAW_ID                         0x70                 
 #define RX_TIME_RAW_LEN                        (4U)                
@@ -575,7 +576,7 @@ extern C {
 #define RX_TIME_RX_RAWST_BIT_MASK 0xffffffffUL         
 
 
- @brief Bit definitions for register TX_TIME_LO
+/* @brief Bit definitions for register TX_TIME_LO */
 
 #define TX_TIME_LO_ID                        0x74                 
 #define TX_TIME_LO_LEN                       (4U)                
@@ -583,7 +584,7 @@ extern C {
 
 
 
- @brief Bit definitions for register TX_TIME_RAW
+/* @brief Bit definitions for register TX_TIME_RAW */
 
 #define TX_TIME_RAW_ID                         0x10000              
 #define TX_TIME_RAW_LEN                        (4U)                
@@ -593,14 +594,14 @@ extern C {
 #define TX_TIME_TX_RAWST_BIT_MASK 0xffffffffUL         
 
 
- @brief Bit definitions for register TX_ANTD
+/* @brief Bit definitions for register TX_ANTD */
 
 #define TX_ANTD_ID                           0x10004              
 #define TX_ANTD_LEN                          (4U)                
 #define TX_ANTD_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register ACK_RESP
+/* @brief Bit definitions for register ACK_RESP */
 
 #define ACK_RESP_ID                          0x10008              
 #define ACK_RESP_LEN                         (4U)                
@@ -610,14 +611,14 @@ extern C {
 #define ACK_RESP_W4R_TIM_BIT_MASK      0xfffffUL            
 
 
- @brief Bit definitions for register TX_POWER
+/* @brief Bit definitions for register TX_POWER */
 
 #define TX_POWER_ID                          0x1000c              
 #define TX_POWER_LEN                         (4U)                
 #define TX_POWER_MASK                        0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register CHAN_CTRL
+/* @brief Bit definitions for register CHAN_CTRL */
 
 #define CHAN_CTRL_ID                         0x10014              
 #define CHAN_CTRL_LEN                        (4U)                
@@ -636,14 +637,14 @@ extern C {
 #define CHAN_CTRL_RF_CHAN_BIT_MASK           0x1U                 
 
 
- @brief Bit definitions for register LE_PEND_01
+/* @brief Bit definitions for register LE_PEND_01 */
 
 #define LE_PEND_01_ID                        0x10018              
 #define LE_PEND_01_LEN                       (4U)                
 #define LE_PEND_01_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register LE_PEND_23
+/* @brief Bit definitions for register LE_PEND_23 */
 
 #define LE_PEND_23_ID                        0x1001c              
 #define LE_PEND_23_LEN                       (4U)                
@@ -651,7 +652,7 @@ extern C {
 
 
 
- @brief Bit definitions for register RDB_STATUS
+/* @brief Bit definitions for register RDB_STATUS */
 
 #define RDB_STATUS_ID                        0x10024              
 #define RDB_STATUS_LEN                       (4U)                
@@ -682,7 +683,7 @@ extern C {
 #define RDB_STATUS_RXFCG0_BIT_MASK           0x1U                 
 
 
- @brief Bit definitions for register RDB_DIAG_MODE
+/* @brief Bit definitions for register RDB_DIAG_MODE */
 
 #define RDB_DIAG_MODE_ID                     0x10028              
 #define RDB_DIAG_MODE_LEN                    (4U)                
@@ -693,7 +694,7 @@ extern C {
 
 
 
- @brief Bit definitions for register AES_CFG
+/* @brief Bit definitions for register AES_CFG */
 
 #define AES_CFG_ID                           0x10030              
 #define AES_CFG_LEN                          (4U)                
@@ -724,35 +725,35 @@ extern C {
 #define AES_CFG_MODE_BIT_MASK            0x1U                 
 
 
- @brief Bit definitions for register AES_IV0
+/* @brief Bit definitions for register AES_IV0 */
 
 #define AES_IV0_ID                           0x10034              
 #define AES_IV0_LEN                          (4U)                
 #define AES_IV0_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register AES_IV1
+/* @brief Bit definitions for register AES_IV1 */
 
 #define AES_IV1_ID                           0x10038              
 #define AES_IV1_LEN                          (4U)                
 #define AES_IV1_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register AES_IV2
+/* @brief Bit definitions for register AES_IV2 */
 
 #define AES_IV2_ID                           0x1003c              
 #define AES_IV2_LEN                          (4U)                
 #define AES_IV2_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register AES_IV3
+/* @brief Bit definitions for register AES_IV3 */
 
 #define AES_IV3_ID                           0x10040              
 #define AES_IV3_LEN                          (4U)                
 #define AES_IV3_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DMA_CFG0
+/* @brief Bit definitions for register DMA_CFG0 */
 
 #define DMA_CFG0_ID                          0x10044              
 #define DMA_CFG0_LEN                         (4U)                
@@ -774,7 +775,7 @@ extern C {
 #define DMA_CFG0_SRC_PORT_BIT_MASK       0x7U                 
 
 
- @brief Bit definitions for register DMA_CFG1
+/* @brief Bit definitions for register DMA_CFG1 */
 
 #define DMA_CFG1_ID                          0x10048              
 #define DMA_CFG1_LEN                         (4U)                
@@ -787,7 +788,7 @@ extern C {
 #define DMA_CFG1_HDR_SIZE_BIT_MASK       0x7fU                
 
 
- @brief Bit definitions for register AES_START
+/* @brief Bit definitions for register AES_START */
 
 #define AES_START_ID                         0x1004c              
 #define AES_START_LEN                        (4U)                
@@ -797,7 +798,7 @@ extern C {
 #define AES_START_AES_START_BIT_MASK         0x1U                 
 
 
- @brief Bit definitions for register AES_STS
+/* @brief Bit definitions for register AES_STS */
 
 #define AES_STS_ID                           0x10050              
 #define AES_STS_LEN                          (4U)                
@@ -822,35 +823,35 @@ extern C {
 #define AES_STS_AES_DONE_BIT_MASK            0x1U                 
 
 
- @brief Bit definitions for register AES_KEY0
+/* @brief Bit definitions for register AES_KEY0 */
 
 #define AES_KEY0_ID                          0x10054              
 #define AES_KEY0_LEN                         (4U)                
 #define AES_KEY0_MASK                        0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register AES_KEY1
+/* @brief Bit definitions for register AES_KEY1 */
 
 #define AES_KEY1_ID                          0x10058              
 #define AES_KEY1_LEN                         (4U)                
 #define AES_KEY1_MASK                        0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register AES_KEY2
+/* @brief Bit definitions for register AES_KEY2 */
 
 #define AES_KEY2_ID                          0x1005c              
 #define AES_KEY2_LEN                         (4U)                
 #define AES_KEY2_MASK                        0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register AES_KEY3
+/* @brief Bit definitions for register AES_KEY3 */
 
 #define AES_KEY3_ID                          0x10060              
 #define AES_KEY3_LEN                         (4U)                
 #define AES_KEY3_MASK                        0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_CFG0
+/* @brief Bit definitions for register STS_CFG0 */
 
 #define STS_CFG0_ID                           0x20000              
 #define STS_CFG0_LEN                          (4U)                
@@ -860,7 +861,7 @@ extern C {
 #define STS_CFG0_CPS_LEN_BIT_MASK           0xffU                
 
 
- @brief Bit definitions for register STS_CTRL
+/* @brief Bit definitions for register STS_CTRL */
 
 #define STS_CTRL_ID                           0x20004              
 #define STS_CTRL_LEN                          (4U)                
@@ -873,7 +874,7 @@ extern C {
 #define STS_CTRL_LOAD_IV_BIT_MASK          0x1U                 
 
 
- @brief Bit definitions for register STS_STS
+/* @brief Bit definitions for register STS_STS */
 
 #define STS_STS_ID                            0x20008              
 #define STS_STS_LEN                           (4U)                
@@ -883,68 +884,68 @@ extern C {
 #define STS_STS_ACC_QUAL_BIT_MASK             0xfffU               
 
 
- @brief Bit definitions for register STS_KEY0
+/* @brief Bit definitions for register STS_KEY0 */
 
 #define STS_KEY0_ID                           0x2000c              
 #define STS_KEY0_LEN                          (4U)                
 #define STS_KEY0_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_KEY1
+/* @brief Bit definitions for register STS_KEY1 */
 
 #define STS_KEY1_ID                           0x20010              
 #define STS_KEY1_LEN                          (4U)                
 #define STS_KEY1_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_KEY2
+/* @brief Bit definitions for register STS_KEY2 */
 
 #define STS_KEY2_ID                           0x20014              
 #define STS_KEY2_LEN                          (4U)                
 #define STS_KEY2_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_KEY3
+/* @brief Bit definitions for register STS_KEY3 */
 
 #define STS_KEY3_ID                           0x20018              
 #define STS_KEY3_LEN                          (4U)                
 #define STS_KEY3_MASK                         0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_IV0
+/* @brief Bit definitions for register STS_IV0 */
 
 #define STS_IV0_ID                            0x2001c              
 #define STS_IV0_LEN                           (4U)                
 #define STS_IV0_MASK                          0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_IV1
+/* @brief Bit definitions for register STS_IV1 */
 
 #define STS_IV1_ID                            0x20020              
 #define STS_IV1_LEN                           (4U)                
 #define STS_IV1_MASK                          0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_IV2
+/* @brief Bit definitions for register STS_IV2 */
 
 #define STS_IV2_ID                            0x20024              
 #define STS_IV2_LEN                           (4U)                
 #define STS_IV2_MASK                          0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_IV3
+/* @brief Bit definitions for register STS_IV3 */
 
 #define STS_IV3_ID                            0x20028              
 #define STS_IV3_LEN                           (4U)                
 #define STS_IV3_MASK                          0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register LCSS_MARGIN
+/* @brief Bit definitions for register LCSS_MARGIN */
 
 #define LCSS_MARGIN_ID                       0x20034              
 
 
- @brief Bit definitions for register DGC_CFG
+/* @brief Bit definitions for register DGC_CFG */
 
 #define DGC_CFG_ID                           0x30018              
 #define DGC_CFG_LEN                          (4U)                
@@ -957,70 +958,70 @@ extern C {
 #define DGC_CFG_RX_TUNE_EN_BIT_MASK          0x1U                 
 
 
- @brief Bit definitions for register DGC_CFG0
+/* @brief Bit definitions for register DGC_CFG0 */
 
 #define DGC_CFG0_ID              0x3001c              
 #define DGC_CFG0_LEN             (4U)                
 #define DGC_CFG0_MASK            0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_CFG1
+/* @brief Bit definitions for register DGC_CFG1 */
 
 #define DGC_CFG1_ID             0x30020              
 #define DGC_CFG1_LEN            (4U)                
 #define DGC_CFG1_MASK           0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_LUT_0_CFG
+/* @brief Bit definitions for register DGC_LUT_0_CFG */
 
 #define DGC_LUT_0_CFG_ID                 0x30038              
 #define DGC_LUT_0_CFG_LEN                (4U)                
 #define DGC_LUT_0_CFG_MASK               0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_LUT_1_CFG
+/* @brief Bit definitions for register DGC_LUT_1_CFG */
 
 #define DGC_LUT_1_CFG_ID                 0x3003c              
 #define DGC_LUT_1_CFG_LEN                (4U)                
 #define DGC_LUT_1_CFG_MASK               0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_LUT_2_CFG
+/* @brief Bit definitions for register DGC_LUT_2_CFG */
 
 #define DGC_LUT_2_CFG_ID                 0x30040              
 #define DGC_LUT_2_CFG_LEN                (4U)                
 #define DGC_LUT_2_CFG_MASK               0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_LUT_3_CFG
+/* @brief Bit definitions for register DGC_LUT_3_CFG */
 
 #define DGC_LUT_3_CFG_ID                 0x30044              
 #define DGC_LUT_3_CFG_LEN                (4U)                
 #define DGC_LUT_3_CFG_MASK               0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_LUT_4_CFG
+/* @brief Bit definitions for register DGC_LUT_4_CFG */
 
 #define DGC_LUT_4_CFG_ID                 0x30048              
 #define DGC_LUT_4_CFG_LEN                (4U)                
 #define DGC_LUT_4_CFG_MASK               0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_LUT_5_CFG
+/* @brief Bit definitions for register DGC_LUT_5_CFG */
 
 #define DGC_LUT_5_CFG_ID                 0x3004c              
 #define DGC_LUT_5_CFG_LEN                (4U)                
 #define DGC_LUT_5_CFG_MASK               0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register DGC_LUT_6_CFG
+/* @brief Bit definitions for register DGC_LUT_6_CFG */
 
 #define DGC_LUT_6_CFG_ID                 0x30050              
 #define DGC_LUT_6_CFG_LEN                (4U)                
 #define DGC_LUT_6_CFG_MASK               0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register EC_CTRL
+/* @brief Bit definitions for register EC_CTRL */
 
 #define EC_CTRL_ID                           0x40000              
 #define EC_CTRL_LEN                          (4U)                
@@ -1033,7 +1034,7 @@ extern C {
 #define EC_CTRL_OSTS_WAIT_BIT_MASK           0x7f8U               
 
 
- @brief Bit definitions for register RX_CAL_CFG
+/* @brief Bit definitions for register RX_CAL_CFG */
 
 #define RX_CAL_CFG_ID                       0x4000c              
 #define RX_CAL_CFG_LEN                      (4U)                
@@ -1050,7 +1051,7 @@ extern C {
 
 
 
- @brief Bit definitions for register RX_CAL_RESI
+/* @brief Bit definitions for register RX_CAL_RESI */
 
 #define RX_CAL_RESI_ID                       0x40014              
 #define RX_CAL_RESI_LEN                      (4U)                
@@ -1058,14 +1059,14 @@ extern C {
 
 
 
- @brief Bit definitions for register RX_CAL_RESQ
+/* @brief Bit definitions for register RX_CAL_RESQ */
 
 #define RX_CAL_RESQ_ID                       0x4001c              
 #define RX_CAL_RESQ_LEN                      (4U)                
 #define RX_CAL_RESQ_MASK                     0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register RX_CAL_STS
+/* @brief Bit definitions for register RX_CAL_STS */
 
 #define RX_CAL_STS_ID                       0x40020              
 #define RX_CAL_STS_LEN                      (4U)                
@@ -1073,7 +1074,7 @@ extern C {
 
 
 
- @brief Bit definitions for register GPIO_MODE
+/* @brief Bit definitions for register GPIO_MODE */
 
 #define GPIO_MODE_ID                         0x50000              
 #define GPIO_MODE_LEN                        (4U)                
@@ -1108,7 +1109,7 @@ extern C {
 
 
 
- @brief Bit definitions for register GPIO_DIR
+/* @brief Bit definitions for register GPIO_DIR */
 
 #define GPIO_DIR_ID                          0x50008              
 #define GPIO_DIR_LEN                         (4U)                
@@ -1142,7 +1143,7 @@ extern C {
 #define GPIO_DIR_GDP0_BIT_MASK          0x1U                 
 
 
- @brief Bit definitions for register GPIO_OUT
+/* @brief Bit definitions for register GPIO_OUT */
 
 #define GPIO_OUT_ID                          0x5000c              
 #define GPIO_OUT_LEN                         (4U)                
@@ -1176,7 +1177,7 @@ extern C {
 #define GPIO_OUT_GOP0_BIT_MASK          0x1U                 
 
 
- @brief Bit definitions for register GPIO_IRQE
+/* @brief Bit definitions for register GPIO_IRQE */
 
 #define GPIO_IRQE_ID                       0x50010              
 #define GPIO_IRQE_LEN                      (4U)                
@@ -1210,7 +1211,7 @@ extern C {
 #define GPIO_IRQE_GIRQE0_BIT_MASK    0x1U                 
 
 
- @brief Bit definitions for register GPIO_ISTS
+/* @brief Bit definitions for register GPIO_ISTS */
 
 #define GPIO_ISTS_ID                   0x50014              
 #define GPIO_ISTS_LEN                  (4U)                
@@ -1244,7 +1245,7 @@ extern C {
 #define GPIO_ISTS_GISTS0_BIT_MASK 0x1U                 
 
 
- @brief Bit definitions for register GPIO_ISEN
+/* @brief Bit definitions for register GPIO_ISEN */
 
 #define GPIO_ISEN_ID                     0x50018              
 #define GPIO_ISEN_LEN                    (4U)                
@@ -1278,7 +1279,7 @@ extern C {
 #define GPIO_ISEN_GISEN0_BIT_MASK 0x1U                 
 
 
- @brief Bit definitions for register GPIO_IMODE
+/* @brief Bit definitions for register GPIO_IMODE */
 
 #define GPIO_IMODE_ID                     0x5001c              
 #define GPIO_IMODE_LEN                    (4U)                
@@ -1312,7 +1313,7 @@ extern C {
 #define GPIO_IMODE_GIMOD0_BIT_MASK 0x1U                 
 
 
- @brief Bit definitions for register GPIO_IBES
+/* @brief Bit definitions for register GPIO_IBES */
 
 #define GPIO_IBES_ID                    0x50020              
 #define GPIO_IBES_LEN                   (4U)                
@@ -1346,7 +1347,7 @@ extern C {
 #define GPIO_IBES_GIBES0_BIT_MASK 0x1U                 
 
 
- @brief Bit definitions for register GPIO_ICLR
+/* @brief Bit definitions for register GPIO_ICLR */
 
 #define GPIO_ICLR_ID                      0x50024              
 #define GPIO_ICLR_LEN                     (4U)                
@@ -1380,7 +1381,7 @@ extern C {
 #define GPIO_ICLR_GICLR0_BIT_MASK  0x1U                 
 
 
- @brief Bit definitions for register GPIO_IDBE
+/* @brief Bit definitions for register GPIO_IDBE */
 
 #define GPIO_IDBE_ID                      0x50028              
 #define GPIO_IDBE_LEN                     (4U)                
@@ -1414,7 +1415,7 @@ extern C {
 #define GPIO_IDBE_GIDBE0_BIT_MASK  0x1U                 
 
 
- @brief Bit definitions for register GPIO_RAW
+/* @brief Bit definitions for register GPIO_RAW */
 
 #define GPIO_RAW_ID                     0x5002c              
 #define GPIO_RAW_LEN                    (4U)                
@@ -1448,7 +1449,7 @@ extern C {
 #define GPIO_RAW_GRAWP0_BIT_MASK 0x1U                 
 
 
- @brief Bit definitions for register DTUNE0
+/* @brief Bit definitions for register DTUNE0 */
 
 #define DTUNE0_ID                            0x60000              
 #define DTUNE0_LEN                           (4U)                
@@ -1461,7 +1462,7 @@ extern C {
 #define DTUNE0_PRE_PAC_SYM_BIT_MASK          0x3U                 
 
 
- @brief Bit definitions for register DTUNE1
+/* @brief Bit definitions for register DTUNE1 */
 
 #define DTUNE1_ID                            0x60004              
 #define DTUNE1_LEN                           (4U)                
@@ -1472,7 +1473,7 @@ extern C {
 
 
 
- @brief Bit definitions for register DTUNE3
+/* @brief Bit definitions for register DTUNE3 */
 
 #define DTUNE3_ID                            0x6000c              
 #define DTUNE3_LEN                           (4U)                
@@ -1486,7 +1487,7 @@ extern C {
 
 
 
- @brief Bit definitions for register DRX_DIAG3
+/* @brief Bit definitions for register DRX_DIAG3 */
 
 #define DRX_DIAG3_ID                         0x60029                
 #define DRX_DIAG3_LEN                        (4U)                
@@ -1500,7 +1501,7 @@ extern C {
 
 
 
- @brief Bit definitions for register RF_ENABLE
+/* @brief Bit definitions for register RF_ENABLE */
 
 #define RF_ENABLE_ID                            0x70000              
 #define RF_ENABLE_LEN                           (4U)                
@@ -1522,7 +1523,7 @@ extern C {
 #define RF_ENABLE_TX_BIAS_EN_BIT_MASK           0x400U               
 
 
- @brief Bit definitions for register RF_CTRL_MASK
+/* @brief Bit definitions for register RF_CTRL_MASK */
 
 #define RF_CTRL_MASK_ID                      0x70004              
 #define RF_CTRL_MASK_LEN                     (4U)                
@@ -1531,28 +1532,28 @@ extern C {
 
 
 
- @brief Bit definitions for register RX_CTRL_HI
+/* @brief Bit definitions for register RX_CTRL_HI */
 
 #define RX_CTRL_HI_ID                        0x70010              
 #define RX_CTRL_HI_LEN                       (4U)                
 #define RX_CTRL_HI_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register RF_SWITCH
+/* @brief Bit definitions for register RF_SWITCH */
 
 #define RF_SWITCH_CTRL_ID                         0x70014              
 #define RF_SWITCH_CTRL_LEN                        (4U)                
 #define RF_SWITCH_CTRL_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register TX_CTRL_LO
+/* @brief Bit definitions for register TX_CTRL_LO */
 
 #define TX_CTRL_LO_ID                        0x70018              
 #define TX_CTRL_LO_LEN                       (4U)                
 #define TX_CTRL_LO_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register TX_CTRL_HI
+/* @brief Bit definitions for register TX_CTRL_HI */
 
 #define TX_CTRL_HI_ID                        0x7001c              
 #define TX_CTRL_HI_LEN                       (4U)                
@@ -1563,7 +1564,7 @@ extern C {
 
 
 
- @brief Bit definitions for register TX_TEST
+/* @brief Bit definitions for register TX_TEST */
 
 #define TX_TEST_ID                           0x70028              
 #define TX_TEST_LEN                          (4U)                
@@ -1584,7 +1585,7 @@ extern C {
 
 
 
- @brief Bit definitions for register SAR_TEST
+/* @brief Bit definitions for register SAR_TEST */
 
 #define SAR_TEST_ID                          0x70034              
 #define SAR_TEST_LEN                         (4U)                
@@ -1595,14 +1596,14 @@ extern C {
 
 
 
- @brief Bit definitions for register LDO_TUNE_LO
+/* @brief Bit definitions for register LDO_TUNE_LO */
 
 #define LDO_TUNE_LO_ID                       0x70040              
 #define LDO_TUNE_LO_LEN                      (4U)                
 #define LDO_TUNE_LO_MASK                     0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register LDO_TUNE_HI
+/* @brief Bit definitions for register LDO_TUNE_HI */
 
 #define LDO_TUNE_HI_ID                       0x70044              
 #define LDO_TUNE_HI_LEN                      (4U)                
@@ -1612,7 +1613,7 @@ extern C {
 #define LDO_TUNE_HI_LDO_HVAUX_TUNE_BIT_MASK  0xf000U              
 
 
- @brief Bit definitions for register LDO_CTRL
+/* @brief Bit definitions for register LDO_CTRL */
 
 #define LDO_CTRL_ID                          0x70048              
 #define LDO_CTRL_LEN                         (4U)                
@@ -1653,7 +1654,7 @@ extern C {
 
 
 
- @brief Bit definitions for register LDO_RLOAD
+/* @brief Bit definitions for register LDO_RLOAD */
 
 #define LDO_RLOAD_ID                         0x70050              
 #define LDO_RLOAD_LEN                        (4U)                
@@ -1662,7 +1663,7 @@ extern C {
 
 
 
- @brief Bit definitions for register SAR_CTRL
+/* @brief Bit definitions for register SAR_CTRL */
 
 #define SAR_CTRL_ID                          0x80000              
 #define SAR_CTRL_LEN                         (4U)                
@@ -1672,7 +1673,7 @@ extern C {
 #define SAR_CTRL_SAR_START_BIT_MASK          0x1U                 
 
 
- @brief Bit definitions for register SAR_STATUS
+/* @brief Bit definitions for register SAR_STATUS */
 
 #define SAR_STATUS_ID                        0x80004              
 #define SAR_STATUS_LEN                       (4U)                
@@ -1682,7 +1683,7 @@ extern C {
 #define SAR_STATUS_SAR_DONE_BIT_MASK    0x1U                 
 
 
- @brief Bit definitions for register SAR_READING
+/* @brief Bit definitions for register SAR_READING */
 
 #define SAR_READING_ID                       0x80008              
 #define SAR_READING_LEN                      (4U)                
@@ -1695,7 +1696,7 @@ extern C {
 #define SAR_READING_SAR_READING_VBAT_BIT_MASK 0xffU                
 
 
- @brief Bit definitions for register SAR_WAKE_RD
+/* @brief Bit definitions for register SAR_WAKE_RD */
 
 
 #define SAR_WAKE_RD_ID                      0x8000c              
@@ -1709,7 +1710,7 @@ extern C {
 #define SAR_WAKE_RD_SAR_LAST_VBAT_BIT_MASK  0xffU                
 
 
- @brief Bit definitions for register PGC_CTRL
+/* @brief Bit definitions for register PGC_CTRL */
 
 #define PGC_CTRL_ID                          0x80010              
 #define PGC_CTRL_LEN                         (4U)                
@@ -1722,7 +1723,7 @@ extern C {
 #define PGC_CTRL_PGC_START_BIT_MASK          0x1U                 
 
 
- @brief Bit definitions for register PGC_STATUS
+/* @brief Bit definitions for register PGC_STATUS */
 
 #define PGC_STATUS_ID                        0x80014              
 #define PGC_STATUS_LEN                       (4U)                
@@ -1735,7 +1736,7 @@ extern C {
 #define PGC_STATUS_PG_DELAY_COUNT_BIT_MASK   0xfffU               
 
 
- @brief Bit definitions for register PG_TEST
+/* @brief Bit definitions for register PG_TEST */
 
 #define PG_TEST_ID                           0x80018              
 #define PG_TEST_LEN                          (4U)                
@@ -1754,7 +1755,7 @@ extern C {
 #define PG_TEST_TX_TEST_CH1_BIT_MASK         0xfU                 
 
 
- @brief Bit definitions for register PG_CAL_TARGET
+/* @brief Bit definitions for register PG_CAL_TARGET */
 
 #define PG_CAL_TARGET_ID                     0x8001c              
 #define PG_CAL_TARGET_LEN                    (4U)                
@@ -1768,7 +1769,7 @@ extern C {
 
 
 
- @brief Bit definitions for register PLL_CFG
+/* @brief Bit definitions for register PLL_CFG */
 
 #define PLL_CFG_ID                           0x90000              
 #define PLL_CFG_LEN                          (4U)                
@@ -1776,7 +1777,7 @@ extern C {
 
 
 
- @brief Bit definitions for register PLL_CAL
+/* @brief Bit definitions for register PLL_CAL */
 
 #define PLL_CAL_ID                           0x90008              
 #define PLL_CAL_LEN                          (4U)                
@@ -1785,7 +1786,7 @@ extern C {
 
 
 
- @brief Bit definitions for register XTAL
+/* @brief Bit definitions for register XTAL */
 
 #define XTAL_ID                              0x90014              
 #define XTAL_LEN                             (4U)                
@@ -1796,7 +1797,7 @@ extern C {
 
 
 
- @brief Bit definitions for register AON_DIG_CFG
+/* @brief Bit definitions for register AON_DIG_CFG */
 
 #define AON_DIG_CFG_ID                       0xa0000              
 #define AON_DIG_CFG_LEN                      (4U)                
@@ -1815,7 +1816,7 @@ extern C {
 #define AON_DIG_CFG_ONWAKE_AON_DLD_BIT_MASK  0x1U                 
 
 
- @brief Bit definitions for register AON_CTRL
+/* @brief Bit definitions for register AON_CTRL */
 
 #define AON_CTRL_ID                          0xa0004              
 #define AON_CTRL_LEN                         (4U)                
@@ -1843,7 +1844,7 @@ extern C {
 #define AON_CTRL_ARRAY_RESTORE_BIT_MASK     0x1U                 
 
 
- @brief Bit definitions for register AON_RDATA
+/* @brief Bit definitions for register AON_RDATA */
 
 #define AON_RDATA_ID                         0xa0008              
 #define AON_RDATA_LEN                        (4U)                
@@ -1853,7 +1854,7 @@ extern C {
 #define AON_RDATA_RDATA_BIT_MASK             0xffU                
 
 
- @brief Bit definitions for register AON_ADDR
+/* @brief Bit definitions for register AON_ADDR */
 
 #define AON_ADDR_ID                          0xa000c              
 #define AON_ADDR_LEN                         (4U)                
@@ -1863,7 +1864,7 @@ extern C {
 #define AON_ADDR_ADDR_BIT_MASK               0x1ffU               
 
 
- @brief Bit definitions for register AON_WDATA
+/* @brief Bit definitions for register AON_WDATA */
 
 #define AON_WDATA_ID                         0xa0010              
 #define AON_WDATA_LEN                        (4U)                
@@ -1873,7 +1874,7 @@ extern C {
 #define AON_WDATA_WDATA_BIT_MASK             0xffU                
 
 
- @brief Bit definitions for register ANA_CFG
+/* @brief Bit definitions for register ANA_CFG */
 
 #define ANA_CFG_ID                           0xa0014              
 #define ANA_CFG_LEN                          (4U)                
@@ -1898,7 +1899,7 @@ extern C {
 #define ANA_CFG_SLEEP_EN_BIT_MASK            0x1U                 
 
 
- @brief Bit definitions for register OTP_WDATA
+/* @brief Bit definitions for register OTP_WDATA */
 
 #define OTP_WDATA_ID                         0xb0000              
 #define OTP_WDATA_LEN                        (4U)                
@@ -1908,7 +1909,7 @@ extern C {
 #define OTP_WDATA_OTP_WDATA_BIT_MASK         0xffffffffUL         
 
 
- @brief Bit definitions for register OTP_ADDR
+/* @brief Bit definitions for register OTP_ADDR */
 
 #define OTP_ADDR_ID                          0xb0004              
 #define OTP_ADDR_LEN                         (4U)                
@@ -1918,7 +1919,7 @@ extern C {
 #define OTP_ADDR_OTP_ADDR_BIT_MASK           0x7ffU               
 
 
- @brief Bit definitions for register OTP_CFG
+/* @brief Bit definitions for register OTP_CFG */
 
 #define OTP_CFG_ID                           0xb0008              
 #define OTP_CFG_LEN                          (4U)                
@@ -1955,7 +1956,7 @@ extern C {
 #define OTP_CFG_OTP_MAN_CTR_EN_BIT_MASK      0x1U                 
 
 
- @brief Bit definitions for register OTP_STATUS
+/* @brief Bit definitions for register OTP_STATUS */
 
 #define OTP_STATUS_ID                        0xb000c              
 #define OTP_STATUS_LEN                       (4U)                
@@ -1968,7 +1969,7 @@ extern C {
 #define OTP_STATUS_OTP_PROG_DONE_BIT_MASK    0x1U                 
 
 
- @brief Bit definitions for register OTP_RDATA
+/* @brief Bit definitions for register OTP_RDATA */
 
 #define OTP_RDATA_ID                         0xb0010              
 #define OTP_RDATA_LEN                        (4U)                
@@ -1979,7 +1980,7 @@ extern C {
 
 
 
- @brief Bit definitions for register IP_TOA_LO
+/* @brief Bit definitions for register IP_TOA_LO */
 
 #define IP_TOA_LO_ID                         0xc0000              
 #define IP_TOA_LO_LEN                        (4U)                
@@ -1989,7 +1990,7 @@ extern C {
 #define IP_TOA_LO_IP_TOA_BIT_MASK            0xffffffffUL         
 
 
- @brief Bit definitions for register IP_TOA_HI
+/* @brief Bit definitions for register IP_TOA_HI */
 
 #define IP_TOA_HI_ID                         0xc0004              
 #define IP_TOA_HI_LEN                        (4U)                
@@ -2005,7 +2006,7 @@ extern C {
 #define IP_TOA_HI_IP_TOA_BIT_MASK            0xffU                
 
 
- @brief Bit definitions for register STS_TOA_LO
+/* @brief Bit definitions for register STS_TOA_LO */
 
 #define STS_TOA_LO_ID                        0xc0008              
 #define STS_TOA_LO_LEN                       (4U)                
@@ -2015,7 +2016,7 @@ extern C {
 #define STS_TOA_LO_STS_TOA_BIT_MASK           0xffffffffUL         
 
 
- @brief Bit definitions for register STS_TOA_HI
+/* @brief Bit definitions for register STS_TOA_HI */
 
 #define STS_TOA_HI_ID                        0xc000c              
 #define STS_TOA_HI_LEN                       (4U)                
@@ -2031,7 +2032,7 @@ extern C {
 #define STS_TOA_HI_STS_TOA_BIT_MASK            0xffU                
 
 
- @brief Bit definitions for register STS1_TOA_LO
+/* @brief Bit definitions for register STS1_TOA_LO */
 
 #define STS1_TOA_LO_ID                        0xc0010              
 #define STS1_TOA_LO_LEN                       (4U)                
@@ -2041,7 +2042,7 @@ extern C {
 #define STS1_TOA_LO_STS1_TOA_BIT_MASK           0xffffffffUL         
 
 
- @brief Bit definitions for register STS1_TOA_HI
+/* @brief Bit definitions for register STS1_TOA_HI */
 
 #define STS1_TOA_HI_ID                        0xc0014              
 #define STS1_TOA_HI_LEN                       (4U)                
@@ -2057,7 +2058,7 @@ extern C {
 #define STS1_TOA_HI_STS1_TOA_BIT_MASK            0xffU                
 
 
- @brief Bit definitions for register CIA_TDOA_0
+/* @brief Bit definitions for register CIA_TDOA_0 */
 
 #define CIA_TDOA_0_ID                        0xc0018              
 #define CIA_TDOA_0_LEN                       (4U)                
@@ -2067,7 +2068,7 @@ extern C {
 #define CIA_TDOA_0_TDOA_BIT_MASK          0xffffffffUL         
 
 
- @brief Bit definitions for register CIA_TDOA_1_PDOA
+/* @brief Bit definitions for register CIA_TDOA_1_PDOA */
 
 #define CIA_TDOA_1_PDOA_ID                   0xc001c              
 #define CIA_TDOA_1_PDOA_LEN                  (4U)                
@@ -2083,7 +2084,7 @@ extern C {
 #define CIA_TDOA_1_PDOA_TDOA_BIT_MASK     0x1ffU               
 
 
- @brief Bit definitions for register CIA_DIAG_0
+/* @brief Bit definitions for register CIA_DIAG_0 */
 
 #define CIA_DIAG_0_ID                        0xc0020              
 #define CIA_DIAG_0_LEN                       (4U)                
@@ -2093,133 +2094,133 @@ extern C {
 #define CIA_DIAG_0_COE_PPM_BIT_MASK       0x1fffU              
 
 
- @brief Bit definitions for register CIA_DIAG_1
+/* @brief Bit definitions for register CIA_DIAG_1 */
 
 #define CIA_DIAG_1_ID                        0xc0024              
 #define CIA_DIAG_1_LEN                       (4U)                
 #define CIA_DIAG_1_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_0
+/* @brief Bit definitions for register IP_DIAG_0 */
 
 #define IP_DIAG_0_ID                         0xc0028              
 #define IP_DIAG_0_LEN                        (4U)                
 #define IP_DIAG_0_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_1
+/* @brief Bit definitions for register IP_DIAG_1 */
 
 #define IP_DIAG_1_ID                         0xc002c              
 #define IP_DIAG_1_LEN                        (4U)                
 #define IP_DIAG_1_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_2
+/* @brief Bit definitions for register IP_DIAG_2 */
 
 #define IP_DIAG_2_ID                         0xc0030              
 #define IP_DIAG_2_LEN                        (4U)                
 #define IP_DIAG_2_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_3
+/* @brief Bit definitions for register IP_DIAG_3 */
 
 #define IP_DIAG_3_ID                         0xc0034              
 #define IP_DIAG_3_LEN                        (4U)                
 #define IP_DIAG_3_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_4
+/* @brief Bit definitions for register IP_DIAG_4 */
 
 #define IP_DIAG_4_ID                         0xc0038              
 #define IP_DIAG_4_LEN                        (4U)                
 #define IP_DIAG_4_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_5
+/* @brief Bit definitions for register IP_DIAG_5 */
 
 #define IP_DIAG_5_ID                         0xc003c              
 #define IP_DIAG_5_LEN                        (4U)                
 #define IP_DIAG_5_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_6
+/* @brief Bit definitions for register IP_DIAG_6 */
 
 #define IP_DIAG_6_ID                         0xc0040              
 #define IP_DIAG_6_LEN                        (4U)                
 #define IP_DIAG_6_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_7
+/* @brief Bit definitions for register IP_DIAG_7 */
 
 #define IP_DIAG_7_ID                         0xc0044              
 #define IP_DIAG_7_LEN                        (4U)                
 #define IP_DIAG_7_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_8
+/* @brief Bit definitions for register IP_DIAG_8 */
 
 #define IP_DIAG_8_ID                         0xc0048              
 #define IP_DIAG_8_LEN                        (4U)                
 #define IP_DIAG_8_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_9
+/* @brief Bit definitions for register IP_DIAG_9 */
 
 #define IP_DIAG_9_ID                         0xc004c              
 #define IP_DIAG_9_LEN                        (4U)                
 #define IP_DIAG_9_MASK                       0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_10
+/* @brief Bit definitions for register IP_DIAG_10 */
 
 #define IP_DIAG_10_ID                        0xc0050              
 #define IP_DIAG_10_LEN                       (4U)                
 #define IP_DIAG_10_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_11
+/* @brief Bit definitions for register IP_DIAG_11 */
 
 #define IP_DIAG_11_ID                        0xc0054              
 #define IP_DIAG_11_LEN                       (4U)                
 #define IP_DIAG_11_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register IP_DIAG_12
+/* @brief Bit definitions for register IP_DIAG_12 */
 
 #define IP_DIAG_12_ID                        0xc0058              
 #define IP_DIAG_12_LEN                       (4U)                
 #define IP_DIAG_12_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_DIAG_0
+/* @brief Bit definitions for register STS_DIAG_0 */
 
 #define STS_DIAG_0_ID                        0xc005c              
 #define STS_DIAG_0_LEN                       (4U)                
 #define STS_DIAG_0_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_DIAG_1
+/* @brief Bit definitions for register STS_DIAG_1 */
 
 #define STS_DIAG_1_ID                        0xc0060              
 #define STS_DIAG_1_LEN                       (4U)                
 #define STS_DIAG_1_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_DIAG_2
+/* @brief Bit definitions for register STS_DIAG_2 */
 
 #define STS_DIAG_2_ID                        0xc0064              
 #define STS_DIAG_2_LEN                       (4U)                
 #define STS_DIAG_2_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_DIAG_3
+/* @brief Bit definitions for register STS_DIAG_3 */
 
 #define STS_DIAG_3_ID                        0xc0068              
 #define STS_DIAG_3_LEN                       (4U)                
 #define STS_DIAG_3_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_DIAG_4
+/* @brief Bit definitions for register STS_DIAG_4 */
 
 #define STS_DIAG_4_ID                        0xd0000              
 #define STS_DIAG_4_LEN                       (4U)                
@@ -2228,102 +2229,102 @@ extern C {
 
 
 
- @brief Bit definitions for register STS_DIAG_5
+/* @brief Bit definitions for register STS_DIAG_5 */
 
 #define STS_DIAG_5_ID                        0xd0004              
 
 
- @brief Bit definitions for register STS_DIAG_6
+/* @brief Bit definitions for register STS_DIAG_6 */
 
 #define STS_DIAG_6_ID                        0xd0008              
 
 
- @brief Bit definitions for register STS_DIAG_7
+/* @brief Bit definitions for register STS_DIAG_7 */
 
 #define STS_DIAG_7_ID                        0xd000c              
 
 
- @brief Bit definitions for register STS_DIAG_8
+/* @brief Bit definitions for register STS_DIAG_8 */
 
 #define STS_DIAG_8_ID                        0xd0010              
 
 
- @brief Bit definitions for register STS_DIAG_9
+/* @brief Bit definitions for register STS_DIAG_9 */
 
 #define STS_DIAG_9_ID                        0xd0014              
 
 
- @brief Bit definitions for register STS_DIAG_10
+/* @brief Bit definitions for register STS_DIAG_10 */
 
 #define STS_DIAG_10_ID                       0xd0018              
 
 
- @brief Bit definitions for register STS_DIAG_11
+/* @brief Bit definitions for register STS_DIAG_11 */
 
 #define STS_DIAG_11_ID                       0xd001c              
 
 
- @brief Bit definitions for register STS_DIAG_12
+/* @brief Bit definitions for register STS_DIAG_12 */
 
 #define STS_DIAG_12_ID                       0xd0020              
 #define STS_DIAG_12_LEN                      (4U)                
 #define STS_DIAG_12_MASK                     0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS_DIAG_13
+/* @brief Bit definitions for register STS_DIAG_13 */
 
 #define STS_DIAG_13_ID                       0xd0024    
 
 
- @brief Bit definitions for register STS_DIAG_14
+/* @brief Bit definitions for register STS_DIAG_14 */
 
 #define STS_DIAG_14_ID                       0xd0028    
 
 
- @brief Bit definitions for register STS_DIAG_15
+/* @brief Bit definitions for register STS_DIAG_15 */
 
 #define STS_DIAG_15_ID                       0xd002C    
 
 
- @brief Bit definitions for register STS_DIAG_16
+/* @brief Bit definitions for register STS_DIAG_16 */
 
 #define STS_DIAG_16_ID                       0xd0030    
 
 
- @brief Bit definitions for register STS_DIAG_17
+/* @brief Bit definitions for register STS_DIAG_17 */
 
 #define STS_DIAG_17_ID                       0xd0034    
 
 
- @brief Bit definitions for register STS1_DIAG_0
+/* @brief Bit definitions for register STS1_DIAG_0 */
 
 #define STS1_DIAG_0_ID                        0xd0038              
 #define STS1_DIAG_0_LEN                       (4U)                
 #define STS1_DIAG_0_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS1_DIAG_1
+/* @brief Bit definitions for register STS1_DIAG_1 */
 
 #define STS1_DIAG_1_ID                        0xd003c              
 #define STS1_DIAG_1_LEN                       (4U)                
 #define STS1_DIAG_1_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS1_DIAG_2
+/* @brief Bit definitions for register STS1_DIAG_2 */
 
 #define STS1_DIAG_2_ID                        0xd0040              
 #define STS1_DIAG_2_LEN                       (4U)                
 #define STS1_DIAG_2_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS1_DIAG_3
+/* @brief Bit definitions for register STS1_DIAG_3 */
 
 #define STS1_DIAG_3_ID                        0xd0044              
 #define STS1_DIAG_3_LEN                       (4U)                
 #define STS1_DIAG_3_MASK                      0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register STS1_DIAG_4
+/* @brief Bit definitions for register STS1_DIAG_4 */
 
 #define STS1_DIAG_4_ID                        0xd0048              
 #define STS1_DIAG_4_LEN                       (4U)                
@@ -2331,22 +2332,22 @@ extern C {
 
 
 
- @brief Bit definitions for register STS1_DIAG_5
+/* @brief Bit definitions for register STS1_DIAG_5 */
 
 #define STS1_DIAG_5_ID                        0xd004c              
 
 
- @brief Bit definitions for register STS1_DIAG_6
+/* @brief Bit definitions for register STS1_DIAG_6 */
 
 #define STS1_DIAG_6_ID                        0xd0050              
 
 
- @brief Bit definitions for register STS1_DIAG_7
+/* @brief Bit definitions for register STS1_DIAG_7 */
 
 #define STS1_DIAG_7_ID                        0xd0054              
 
 
- @brief Bit definitions for register STS1_DIAG_8
+/* @brief Bit definitions for register STS1_DIAG_8 */
 
 #define STS1_DIAG_8_ID                        0xd0058              
 #define STS1_DIAG_8_LEN                       (4U)                
@@ -2354,29 +2355,29 @@ extern C {
 
 
 
- @brief Bit definitions for register STS1_DIAG_9
+/* @brief Bit definitions for register STS1_DIAG_9 */
 
 #define STS1_DIAG_9_ID                        0xd005c              
 
 
- @brief Bit definitions for register STS1_DIAG_10
+/* @brief Bit definitions for register STS1_DIAG_10 */
 
 #define STS1_DIAG_10_ID                       0xd0060              
 
 
- @brief Bit definitions for register STS1_DIAG_11
+/* @brief Bit definitions for register STS1_DIAG_11 */
 
 #define STS1_DIAG_11_ID                       0xd0064              
 
 
- @brief Bit definitions for register STS1_DIAG_12
+/* @brief Bit definitions for register STS1_DIAG_12 */
 
 #define STS1_DIAG_12_ID                       0xd0068              
 #define STS1_DIAG_12_LEN                      (4U)                
 #define STS1_DIAG_12_MASK                     0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register CIA_CONF
+/* @brief Bit definitions for register CIA_CONF */
 
 #define CIA_CONF_ID                  0xe0000              
 #define CIA_CONF_LEN                 (4U)                
@@ -2389,7 +2390,7 @@ extern C {
 #define CIA_CONF_RXANTD_BIT_MASK 0xffffU              
 
 
- @brief Bit definitions for register FP_CONF
+/* @brief Bit definitions for register FP_CONF */
 
 #define FP_CONF_ID               0xe0004              
 #define FP_CONF_LEN              (4U)                
@@ -2406,7 +2407,7 @@ extern C {
                
 
 
- @brief Bit definitions for register IP_CONFIG_LO
+/* @brief Bit definitions for register IP_CONFIG_LO */
 
 #define IP_CONFIG_LO_ID                      0xe000c              
 #define IP_CONFIG_LO_LEN                     (2U)                
@@ -2419,9 +2420,9 @@ extern C {
 #define IP_CONFIG_LO_IP_NTM_BIT_MASK 0x1fU                
 
 
- @brief Bit definitions for register IP_CONFIG_HI
+/* @brief Bit definitions for register IP_CONFIG_HI */
 
-#define IP_CONFIG_HI_ID                      0xe000e                { aliased = true}  
+#define IP_CONFIG_HI_ID                      0xe000e                /* { aliased = true} */
 #define IP_CONFIG_HI_LEN                     (4U)
 #define IP_CONFIG_HI_MASK                    0xFFFFFFFFUL
 #define IP_CONFIG_HI_IP_RTM_BIT_OFFSET (0U)
@@ -2429,9 +2430,9 @@ extern C {
 #define IP_CONFIG_HI_IP_RTM_BIT_MASK 0x1fU
 
 
- @brief Bit definitions for register STS_CONFIG_LO
+/* @brief Bit definitions for register STS_CONFIG_LO */
 
-#define STS_CONFIG_LO_ID                      0xe0012                { aliased = true}  
+#define STS_CONFIG_LO_ID                      0xe0012                /* { aliased = true} */
 #define STS_CONFIG_LO_LEN                     (4U)
 #define STS_CONFIG_LO_MASK                    0xFFFFFFFFUL
 #define STS_CONFIG_LO_STS_MAN_TH_BIT_OFFSET (16U)
@@ -2445,9 +2446,9 @@ extern C {
 #define STS_CONFIG_LO_STS_NTM_BIT_MASK 0x1fU
 
 
- @brief Bit definitions for register STS_CONFIG_HI
+/* @brief Bit definitions for register STS_CONFIG_HI */
 
-#define STS_CONFIG_HI_ID                      0xe0016                { aliased = true}  
+#define STS_CONFIG_HI_ID                      0xe0016                /* { aliased = true} */
 #define STS_CONFIG_HI_LEN                     (4U)
 #define STS_CONFIG_HI_MASK                    0xFFFFFFFFUL
 #define STS_CONFIG_HI_STS_PGR_EN_BIT_OFFSET (31U)
@@ -2464,9 +2465,9 @@ extern C {
 #define STS_CONFIG_HI_FP_AGREED_EN_BIT_MASK   0x10000000UL
 
 
- @brief Bit definitions for register CIA_ADJUST
+/* @brief Bit definitions for register CIA_ADJUST */
 
-#define CIA_ADJUST_ID            0xe001a               {aliased=true} 
+#define CIA_ADJUST_ID            0xe001a               /* {aliased=true} */
 #define CIA_ADJUST_LEN           (4U)
 #define CIA_ADJUST_MASK          0xFFFFFFFFUL
 #define CIA_ADJUST_PDOA_ADJ_OFFSET_BIT_OFFSET (0U)
@@ -2474,17 +2475,17 @@ extern C {
 #define CIA_ADJUST_PDOA_ADJ_OFFSET_BIT_MASK 0x3fffU
 
 
- @brief Bit definitions for register PGF_DELAY_COMP_LO
+/* @brief Bit definitions for register PGF_DELAY_COMP_LO */
 
-#define PGF_DELAY_COMP_LO_ID                 0xe001e               {aliased=true} 
+#define PGF_DELAY_COMP_LO_ID                 0xe001e               /* {aliased=true} */
 
 
- @brief Bit definitions for register PGF_DELAY_COMP_HI
+/* @brief Bit definitions for register PGF_DELAY_COMP_HI */
 
-#define PGF_DELAY_COMP_HI_ID                 0xe0022               {aliased=true} 
+#define PGF_DELAY_COMP_HI_ID                 0xe0022               /* {aliased=true} */
 
 
- @brief Bit definitions for register EVENT_CTRL
+/* @brief Bit definitions for register EVENT_CTRL */
 
 #define EVC_CTRL_ID                        0xf0000              
 #define EVC_CTRL_LEN                       (4U)                
@@ -2497,7 +2498,7 @@ extern C {
 #define EVC_CTRL_EVC_EN_BIT_MASK   0x1U                 
 
 
- @brief Bit definitions for register EVC_COUNT0
+/* @brief Bit definitions for register EVC_COUNT0 */
 
 #define EVC_COUNT0_ID                      0xf0004              
 #define EVC_COUNT0_LEN                     (4U)                
@@ -2510,7 +2511,7 @@ extern C {
 #define EVC_COUNT0_EVC_PHE_BIT_MASK    0xfffU               
 
 
- @brief Bit definitions for register EVC_COUNT1
+/* @brief Bit definitions for register EVC_COUNT1 */
 
 #define EVC_COUNT1_ID                      0xf0008              
 #define EVC_COUNT1_LEN                     (4U)                
@@ -2523,7 +2524,7 @@ extern C {
 #define EVC_COUNT1_EVC_FCG_BIT_MASK    0xfffU               
 
 
- @brief Bit definitions for register EVC_COUNT2
+/* @brief Bit definitions for register EVC_COUNT2 */
 
 #define EVC_COUNT2_ID                      0xf000c              
 #define EVC_COUNT2_LEN                     (4U)                
@@ -2536,7 +2537,7 @@ extern C {
 #define EVC_COUNT2_EVC_FFR_BIT_MASK     0xffU                
 
 
- @brief Bit definitions for register EVC_COUNT3
+/* @brief Bit definitions for register EVC_COUNT3 */
 
 #define EVC_COUNT3_ID                      0xf0010              
 #define EVC_COUNT3_LEN                     (4U)                
@@ -2549,7 +2550,7 @@ extern C {
 #define EVC_COUNT3_EVC_STO_BIT_MASK    0xfffU               
 
 
- @brief Bit definitions for register EVC_COUNT4
+/* @brief Bit definitions for register EVC_COUNT4 */
 
 #define EVC_COUNT4_ID                      0xf0014              
 #define EVC_COUNT4_LEN                     (4U)                
@@ -2562,7 +2563,7 @@ extern C {
 #define EVC_COUNT4_EVC_FWTO_BIT_MASK     0xffU                
 
 
- @brief Bit definitions for register EVC_COUNT5
+/* @brief Bit definitions for register EVC_COUNT5 */
 
 #define EVC_COUNT5_ID                      0xf0018              
 #define EVC_COUNT5_LEN                     (4U)                
@@ -2575,7 +2576,7 @@ extern C {
 #define EVC_COUNT5_EVC_HPW_BIT_MASK   0xffU                
 
 
- @brief Bit definitions for register EVC_COUNT6
+/* @brief Bit definitions for register EVC_COUNT6 */
 
 #define EVC_COUNT6_ID                      0xf001c              
 #define EVC_COUNT6_LEN                     (4U)                
@@ -2587,7 +2588,7 @@ extern C {
 
 
 
- @brief Bit definitions for register TEST_CTRL0
+/* @brief Bit definitions for register TEST_CTRL0 */
 
 #define TEST_CTRL0_ID                        0xf0024              
 #define TEST_CTRL0_LEN                       (4U)                
@@ -2606,7 +2607,7 @@ extern C {
 #define TEST_CTRL0_TX_PSTM_BIT_MASK            0x10U                
 
 
- @brief Bit definitions for register EVC_COUNT7
+/* @brief Bit definitions for register EVC_COUNT7 */
 
 #define EVC_COUNT7_ID                      0xf0028              
 #define EVC_COUNT7_LEN                     (4U)                
@@ -2619,7 +2620,7 @@ extern C {
 #define EVC_COUNT7_EVC_CPQE_BIT_MASK    0xffU                
 
 
- @brief Bit definitions for register SPI_MODE
+/* @brief Bit definitions for register SPI_MODE */
 
 #define SPI_MODE_ID                          0xf002c              
 #define SPI_MODE_LEN                         (4U)                
@@ -2629,7 +2630,7 @@ extern C {
 #define SPI_MODE_SPI_MODE_BIT_MASK           0x3U                 
 
 
- @brief Bit definitions for register SYS_STATE_LO
+/* @brief Bit definitions for register SYS_STATE_LO */
 
 #define SYS_STATE_LO_ID                      0xf0030              
 #define SYS_STATE_LO_LEN                     (4U)                
@@ -2638,7 +2639,7 @@ extern C {
 
 
 
- @brief Bit definitions for register FCMD_STATUS
+/* @brief Bit definitions for register FCMD_STATUS */
 
 #define FCMD_STATUS_ID                       0xf003c              
 #define FCMD_STATUS_LEN                      (4U)                
@@ -2648,7 +2649,7 @@ extern C {
 #define FCMD_STATUS_FCMD_STATUS_BIT_MASK     0x1fU                
 
 
- @brief Bit definitions for register CTR_DBG
+/* @brief Bit definitions for register CTR_DBG */
 
 #define CTR_DBG_ID                           0xf0048   
 #define CTR_DBG_LEN                          (4U)
@@ -2658,14 +2659,14 @@ extern C {
 #define CTR_DBG_CTR_DBG_BIT_MASK             0xffffffffUL
 
 
- @brief Bit definitions for register SOFT_RST
+/* @brief Bit definitions for register SOFT_RST */
 
 #define SOFT_RST_ID                          0x110000             
 #define SOFT_RST_LEN                         (4U)                
 #define SOFT_RST_MASK                        0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register CLK_CTRL
+/* @brief Bit definitions for register CLK_CTRL */
 
 #define CLK_CTRL_ID                          0x110004             
 #define CLK_CTRL_LEN                         (4U)                
@@ -2714,7 +2715,7 @@ extern C {
 #define CLK_CTRL_SYS_CLK_SEL_BIT_MASK        0x3U                 
 
 
- @brief Bit definitions for register SEQ_CTRL
+/* @brief Bit definitions for register SEQ_CTRL */
 
 #define SEQ_CTRL_ID                          0x110008             
 #define SEQ_CTRL_LEN                         (4U)                
@@ -2745,7 +2746,7 @@ extern C {
                           
 
 
- @brief Bit definitions for register PWR_UP_TIMES_LO
+/* @brief Bit definitions for register PWR_UP_TIMES_LO */
 
 #define PWR_UP_TIMES_LO_ID                   0x110010             
 #define PWR_UP_TIMES_LO_LEN                  (4U)                
@@ -2756,7 +2757,7 @@ extern C {
 
 
 
- @brief Bit definitions for register LED_CTRL
+/* @brief Bit definitions for register LED_CTRL */
 
 #define LED_CTRL_ID                          0x110016               
 #define LED_CTRL_LEN                         (4U)                
@@ -2769,9 +2770,9 @@ extern C {
 #define LED_CTRL_BLINK_EN_BIT_MASK           0x100U               
 
 
- @brief Bit definitions for register RX_SNIFF
+/* @brief Bit definitions for register RX_SNIFF */
 
-#define RX_SNIFF_ID                            0x11001a               { aliased = true}  
+#define RX_SNIFF_ID                            0x11001a               /* { aliased = true} */
 #define RX_SNIFF_LEN                           (4U)                
 #define RX_SNIFF_MASK                          0xFFFFFFFFUL        
 #define RX_SNIFF_SNIFF_OFF_BIT_OFFSET            (8U)                
@@ -2783,7 +2784,7 @@ extern C {
 
 
 
- @brief Bit definitions for register BIAS_CTRL
+/* @brief Bit definitions for register BIAS_CTRL */
 
 #define BIAS_CTRL_ID                         0x11001f               
 #define BIAS_CTRL_LEN                        (4U)                
@@ -2793,7 +2794,16 @@ extern C {
 #define BIAS_CTRL_BIAS_MASK  0x1fU                
 
 
- @brief Bit definitions for register FINT_STAT
+/* @brief Register files RX_BUFFER_0, RX_BUFFER_1 and TX_BUFFER */
+
+#define RX_BUFFER_0_ID                       0x120000
+#define RX_BUFFER_1_ID                       0x130000
+#define RX_BUFFER_LEN                        (1024U)
+#define TX_BUFFER_ID                         0x140000
+#define TX_BUFFER_LEN                        (1024U)
+
+
+/* @brief Bit definitions for register FINT_STAT */
 
 #define FINT_STAT_ID                         0x1F0000             
 #define FINT_STAT_LEN                        (4U)                
@@ -2808,28 +2818,28 @@ extern C {
 #define FINT_STAT_TXOK_BIT_MASK              0x1U 
 
 
- @brief Bit definitions for register INDIRECT_ADDR_A
+/* @brief Bit definitions for register INDIRECT_ADDR_A */
 
 #define INDIRECT_ADDR_A_ID                   0x1f0004             
 #define INDIRECT_ADDR_A_LEN                  (4U)                
 #define INDIRECT_ADDR_A_MASK                 0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register ADDR_OFFSET_A
+/* @brief Bit definitions for register ADDR_OFFSET_A */
 
 #define ADDR_OFFSET_A_ID                     0x1f0008             
 #define ADDR_OFFSET_A_LEN                    (4U)                
 #define ADDR_OFFSET_A_MASK                   0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register INDIRECT_ADDR_B
+/* @brief Bit definitions for register INDIRECT_ADDR_B */
 
 #define INDIRECT_ADDR_B_ID                   0x1f000c             
 #define INDIRECT_ADDR_B_LEN                  (4U)                
 #define INDIRECT_ADDR_B_MASK                 0xFFFFFFFFUL        
 
 
- @brief Bit definitions for register ADDR_OFFSET_B
+/* @brief Bit definitions for register ADDR_OFFSET_B */
 
 #define ADDR_OFFSET_B_ID                     0x1f0010             
 #define ADDR_OFFSET_B_LEN                    (4U)                
@@ -2838,4 +2848,4 @@ extern C {
 #ifdef __cplusplus
 }
 #endif
-#endif  __DECA_REGS_H 
+#endif /* __DECA_REGS_H */
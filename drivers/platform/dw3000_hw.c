@@ -3,6 +3,8 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
 
+#include <string.h>
+
 #include "deca_device_api.h"
 #include "dw3000_hw.h"
 #include "dw3000_spi.h"
@@ -14,6 +16,20 @@ LOG_MODULE_REGISTER(dw3000, CONFIG_DW3000_LOG_LEVEL);
 static struct gpio_callback gpio_cb;
 static struct k_work dw3000_isr_work;
 
+#ifdef CONFIG_DW3000_ISR_WORKQ
+K_THREAD_STACK_DEFINE(dw3000_workq_stack, CONFIG_DW3000_ISR_WORKQ_STACK_SIZE);
+static struct k_work_q dw3000_workq;
+static bool dw3000_workq_started;
+#endif
+
+#ifdef CONFIG_DW3000_IRQ_LATENCY
+/* cycle counter at the first IRQ edge of the pending work */
+static volatile uint32_t irq_cycles;
+/* written by the ISR work, read and reset from other threads */
+static struct dw3000_irq_stats irq_stats;
+static struct k_spinlock irq_stats_lock;
+#endif
+
 struct dw3000_config {
 	struct gpio_dt_spec gpio_irq;
 	struct gpio_dt_spec gpio_reset;
@@ -64,21 +80,61 @@ int dw3000_hw_init()
 	return dw3000_spi_init();
 }
 
+#ifdef CONFIG_DW3000_IRQ_LATENCY
+static void dw3000_hw_irq_latency(uint32_t cycles)
+{
+	uint32_t us = k_cyc_to_us_floor32(cycles);
+	uint32_t bucket = 0;
+
+	while (bucket < DW3000_IRQ_HIST_BUCKETS - 1 && us >= (16U << bucket)) {
+		bucket++;
+	}
+	k_spinlock_key_t key = k_spin_lock(&irq_stats_lock);
+	irq_stats.hist[bucket]++;
+	irq_stats.irqs++;
+	irq_stats.max_us = MAX(irq_stats.max_us, us);
+	k_spin_unlock(&irq_stats_lock, key);
+}
+#endif
+
 static void dw3000_hw_isr_work_handler(struct k_work* item)
 {
+#ifdef CONFIG_DW3000_IRQ_LATENCY
+	dw3000_hw_irq_latency(k_cycle_get_32() - irq_cycles);
+#endif
 	dwt_isr();
 }
 
 static void dw3000_hw_isr(const struct device* dev, struct gpio_callback* cb,
 						  uint32_t pins)
 {
+#ifdef CONFIG_DW3000_IRQ_LATENCY
+	/* an edge while the work is queued is handled by the same dwt_isr() */
+	if (!k_work_is_pending(&dw3000_isr_work)) {
+		irq_cycles = k_cycle_get_32();
+	}
+#endif
+#ifdef CONFIG_DW3000_ISR_WORKQ
+	k_work_submit_to_queue(&dw3000_workq, &dw3000_isr_work);
+#else
 	k_work_submit(&dw3000_isr_work);
+#endif
 }
 
 int dw3000_hw_init_interrupt(void)
 {
 	if (conf.gpio_irq.port) {
 		k_work_init(&dw3000_isr_work, dw3000_hw_isr_work_handler);
+#ifdef CONFIG_DW3000_ISR_WORKQ
+		if (!dw3000_workq_started) {
+			const struct k_work_queue_config workq_cfg = {.name = "dw3000_workq"};
+
+			k_work_queue_start(&dw3000_workq, dw3000_workq_stack,
+							   K_THREAD_STACK_SIZEOF(dw3000_workq_stack),
+							   CONFIG_DW3000_ISR_WORKQ_PRIORITY, &workq_cfg);
+			dw3000_workq_started = true;
+		}
+#endif
 
 		gpio_pin_configure_dt(&conf.gpio_irq, GPIO_INPUT);
 		gpio_init_callback(&gpio_cb, dw3000_hw_isr, BIT(conf.gpio_irq.pin));
@@ -108,6 +164,26 @@ void dw3000_hw_interrupt_disable(void)
 	}
 }
 
+void dw3000_hw_get_irq_stats(struct dw3000_irq_stats* stats)
+{
+#ifdef CONFIG_DW3000_IRQ_LATENCY
+	k_spinlock_key_t key = k_spin_lock(&irq_stats_lock);
+	*stats = irq_stats;
+	k_spin_unlock(&irq_stats_lock, key);
+#else
+	memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void dw3000_hw_reset_irq_stats(void)
+{
+#ifdef CONFIG_DW3000_IRQ_LATENCY
+	k_spinlock_key_t key = k_spin_lock(&irq_stats_lock);
+	memset(&irq_stats, 0, sizeof(irq_stats));
+	k_spin_unlock(&irq_stats_lock, key);
+#endif
+}
+
 void dw3000_hw_fini(void)
 {
 	// TODO
@@ -5,6 +5,19 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
+/* Buckets of the IRQ latency histogram, bucket n counts latencies below
+ * 16 << n us, the last bucket everything above */
+#define DW3000_IRQ_HIST_BUCKETS 8
+
+/* IRQ edge to dwt_isr() latency (CONFIG_DW3000_IRQ_LATENCY) */
+struct dw3000_irq_stats {
+	uint32_t irqs;
+	uint32_t max_us;
+	uint32_t hist[DW3000_IRQ_HIST_BUCKETS];
+};
+
 int dw3000_hw_init(void);
 int dw3000_hw_init_interrupt(void);
 void dw3000_hw_fini(void);
@@ -13,6 +26,9 @@ void dw3000_hw_wakeup(void);
 void dw3000_hw_wakeup_pin_low(void);
 void dw3000_hw_interrupt_enable(void);
 void dw3000_hw_interrupt_disable(void);
+void dw3000_hw_get_irq_stats(struct dw3000_irq_stats* stats);
+/* Called with each new measurement setup */
+void dw3000_hw_reset_irq_stats(void);
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,8 @@ static const struct device* spi;
 static struct spi_cs_control cs_ctrl = SPI_CS_CONTROL_INIT(DT_NODELABEL(dwm3000), 0);
 static struct spi_config spi_cfgs[2] = {0}; // configs for slow and fast
 static struct spi_config* spi_cfg;
+static atomic_t spi_reads;
+static atomic_t spi_writes;
 
 int dw3000_spi_init(void)
 {
@@ -102,6 +104,7 @@ int dw3000_spi_write_crc(uint16_t headerLength, const uint8_t* headerBuffer,
 		.count = ARRAY_SIZE(tx_buf),
 	};
 
+	atomic_inc(&spi_writes);
 	return spi_transceive(spi, spi_cfg, &tx, NULL);
 }
 
@@ -123,6 +126,7 @@ int dw3000_spi_write(uint16_t headerLength, const uint8_t* headerBuffer,
 		.count = ARRAY_SIZE(tx_buf),
 	};
 
+	atomic_inc(&spi_writes);
 	return spi_transceive(spi, spi_cfg, &tx, NULL);
 }
 
@@ -152,6 +156,7 @@ int dw3000_spi_read(uint16_t headerLength, uint8_t* headerBuffer,
 		.count = ARRAY_SIZE(rx_buf),
 	};
 
+	atomic_inc(&spi_reads);
 	int ret = spi_transceive(spi, spi_cfg, &tx, &rx);
 
 #if (CONFIG_SOC_NRF52840_QIAA)
@@ -171,6 +176,38 @@ int dw3000_spi_read(uint16_t headerLength, uint8_t* headerBuffer,
 	return ret;
 }
 
+/* Full address header: read/write | 1 | base[4:0] | sub[6:0] | mode 00 */
+static void dw3000_spi_reg_header(uint32_t reg_id, bool write, uint8_t* header)
+{
+	uint8_t base = (reg_id >> 16) & 0x1F;
+	uint8_t sub = reg_id & 0x7F;
+
+	header[0] = (write ? 0x80 : 0x00) | 0x40 | (base << 1) | (sub >> 6);
+	header[1] = (sub << 2) & 0xFC;
+}
+
+int dw3000_spi_read_reg(uint32_t reg_id, uint16_t length, uint8_t* buffer)
+{
+	uint8_t header[2];
+
+	dw3000_spi_reg_header(reg_id, false, header);
+	return dw3000_spi_read(sizeof(header), header, length, buffer);
+}
+
+int dw3000_spi_write_reg(uint32_t reg_id, uint16_t length, const uint8_t* buffer)
+{
+	uint8_t header[2];
+
+	dw3000_spi_reg_header(reg_id, true, header);
+	return dw3000_spi_write(sizeof(header), header, length, buffer);
+}
+
+void dw3000_spi_get_stats(struct dw3000_spi_stats* stats)
+{
+	stats->reads = (uint32_t)atomic_get(&spi_reads);
+	stats->writes = (uint32_t)atomic_get(&spi_writes);
+}
+
 void dw3000_spi_wakeup()
 {
 	gpio_pin_set_dt(&cs_ctrl.gpio, 1);
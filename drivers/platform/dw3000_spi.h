@@ -7,6 +7,12 @@ extern "C" {
 
 #include <stdint.h>
 
+/* SPI transactions since boot */
+struct dw3000_spi_stats {
+	uint32_t reads;
+	uint32_t writes;
+};
+
 int dw3000_spi_init(void);
 void dw3000_spi_fini(void);
 void dw3000_spi_wakeup(void);
@@ -19,6 +25,11 @@ int dw3000_spi_write(uint16_t headerLength, const uint8_t* headerBuffer,
 int dw3000_spi_write_crc(uint16_t headerLength, const uint8_t* headerBuffer,
 						 uint16_t bodyLength, const uint8_t* bodyBuffer,
 						 uint8_t crc8);
+/* Read length bytes of a register file, reg_id = base << 16 | sub address */
+int dw3000_spi_read_reg(uint32_t reg_id, uint16_t length, uint8_t* buffer);
+/* Write length bytes of a register file, sub address 0..127 */
+int dw3000_spi_write_reg(uint32_t reg_id, uint16_t length, const uint8_t* buffer);
+void dw3000_spi_get_stats(struct dw3000_spi_stats* stats);
 #ifdef __cplusplus
 }
 #endif
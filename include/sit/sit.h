@@ -51,16 +51,40 @@ extern uint32_t measurements;
 * [
 *	-1 -> dwt_initialise failed,
 *	-2 -> dwt_configure failed,
-*   -3 -> dwt_probe failed
+*   -3 -> dwt_probe failed,
+*   -4 -> DW3000 IRQ init failed (CONFIG_SIT_IRQ)
 * ]
 ****************************************************************************/
 uint8_t sit_init();
 void sit_run_forever();
 
+/***************************************************************************
+* Apply all DW3000 settings which are not part of dwt_config_t: TX power,
+* antenna delays, LNA/PA, CIA diagnostics, frame filter and interrupt mask.
+* Has to follow every dwt_configure().
+*
+* @return None
+****************************************************************************/
+void sit_radio_restore();
+
+/***************************************************************************
+* Signal a new setup from BLE. The ranging thread takes it over before the
+* next measurement, so the state of the ranging code is only changed there.
+*
+* @return None
+****************************************************************************/
+void sit_setup_changed();
+
 void sit_sstwr_initiator();
 void sit_sstwr_responder();
 
 void sit_dstwr_initiator(); 
 void sit_dstwr_responder();
 
+void sit_dstwr_all_initiator();
+void sit_dstwr_all_responder();
+
+void sit_tdoa_tag();
+void sit_tdoa_anchor();
+
 void reset_sequence();
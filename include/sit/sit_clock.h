@@ -0,0 +1,98 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_clock.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Clock model of the peers.
+ *
+ * For every peer the skew of its clock to the own clock is tracked with a
+ * scalar Kalman filter. Measurements are the carrier integrator of every
+ * received frame and the TX/RX times of two sync frames. The last sync is
+ * kept to measure the skew over the next sync period. The TDoA code
+ * queries the filtered skew instead of the carrier integrator of a single
+ * frame.
+ *
+ * skew = peer clock rate / own clock rate - 1
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_CLOCK_H__
+#define __SIT_CLOCK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint8_t peer_id;
+    bool valid;             ///< skew holds at least one measurement
+    bool sync_valid;        ///< sync_peer_ts and sync_local_ts are set
+    float skew;             ///< filtered skew
+    float variance;         ///< variance of the skew
+    uint64_t sync_peer_ts;  ///< TX time of the last sync (peer clock)
+    uint64_t sync_local_ts; ///< RX time of the last sync (own clock)
+    int64_t update_ms;      ///< uptime of the last update
+    uint32_t updates;
+} sit_clock_peer_t;
+
+/***************************************************************************
+ * Forget all peers, called for every new setup
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_clock_reset(void);
+
+/***************************************************************************
+ * Update the skew of a peer with the carrier integrator of a received
+ * frame of this peer.
+ *
+ * @param peer_id   ->  device ID of the peer
+ * @param ci        ->  dwt_readcarrierintegrator() of the frame
+ *
+ * @return filtered skew of the peer
+ *
+****************************************************************************/
+float sit_clock_update_ci(uint8_t peer_id, int32_t ci);
+
+/***************************************************************************
+ * Update the skew of a peer with a sync frame
+ *
+ * @param peer_id   ->  device ID of the peer
+ * @param peer_ts   ->  40 bit TX time of the sync (peer clock)
+ * @param local_ts  ->  40 bit RX time of the sync (own clock)
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_clock_update_sync(uint8_t peer_id, uint64_t peer_ts, uint64_t local_ts);
+
+/***************************************************************************
+ * Filtered skew of a peer
+ *
+ * @param peer_id   ->  device ID of the peer
+ *
+ * @return skew, 0 if there was no measurement of the peer
+ *
+****************************************************************************/
+float sit_clock_skew(uint8_t peer_id);
+
+#endif // __SIT_CLOCK_H__
@@ -38,6 +38,9 @@
 #include <stdbool.h>
 
 #include <deca_device_api.h>
+#include <zephyr/toolchain.h>
+
+#include "sit_ts.h"
 
 #include <sit_json/sit_json_config.h>
 
@@ -66,9 +69,10 @@ typedef enum {
 
 typedef enum {
     ss_twr,
-    ds_3_twr,
-    ds_4_twr, ///< not Implemented yet
-    ds_all_twr, ///< not Implemnted yet
+    ds_3_twr, ///< poll, response and final, the responder calculates the distance
+    ds_4_twr, ///< poll, response, final and final response for every responder
+    ds_all_twr, ///< all nodes send one frame per round, every node ranges to all peers
+    ul_tdoa,    ///< tags send blinks, synchronised anchors report the RX times
     simple_calibration,
     extended_calibration,
     two_device_calibration,
@@ -87,6 +91,8 @@ typedef struct {
     bool diagnostic;
     uint32_t min_measurement;
     uint32_t max_measurement;
+    uint8_t tdma_slot;   ///< TDMA slot of this initiator
+    uint8_t tdma_slots;  ///< TDMA slots per superframe, 0 -> TDMA disabled
 } device_settings_t;
 
 extern device_settings_t device_settings;
@@ -105,50 +111,114 @@ typedef enum {
     sensing_2,
     sensing_3,
     sensing_resp,
+    tdma_beacon,
+    tdoa_blink,
+    tdoa_sync,
 } msg_id_t;
 
-typedef struct {
-    msg_id_t id;
+#define SIT_BROADCAST_ID 0xFF
+
+/* 802.15.4 frame control: data frame, PAN ID compression, short destination and source address */
+#define SIT_FRAME_CTRL 0x8841
+#define SIT_PAN_ID 0xDECA
+/* Increment if the layout of a frame changes, frames of other versions are dropped */
+#define SIT_FRAME_VERSION 1
+/* Message byte of the header: msg_id_t in bits 0..5, SIT_FRAME_VERSION in bits 6..7 */
+#define SIT_MSG_ID_MASK 0x3F
+#define SIT_MSG_VERSION_SHIFT 6
+#define SIT_MSG_BYTE(msg_id, version) \
+        ((uint8_t)(((msg_id) & SIT_MSG_ID_MASK) | ((version) << SIT_MSG_VERSION_SHIFT)))
+
+/**
+ * 802.15.4 MAC header followed by the SIT message ID. The device ID is the
+ * low byte of the short address, SIT_BROADCAST_ID is sent as 0xFFFF.
+ *
+ * All frames are packed, timestamps take 5 bytes (sit_ts40_t). The crc
+ * field at the end of every frame is the place of the FCS, it is not
+ * uploaded and filled in by the DW3000.
+*/
+typedef struct __packed {
+    uint8_t frame_ctrl[2];
     uint8_t sequence;
-    uint8_t source;
+    uint8_t pan_id[2];
     uint8_t dest;
+    uint8_t dest_hi;
+    uint8_t source;
+    uint8_t source_hi;
+    uint8_t msg;            ///< SIT_MSG_BYTE(), read with sit_frame_id()
 } header_t;
 
-typedef struct {
+#define SIT_HEADER(msg_id, seq, src, dst) {                             \
+        .frame_ctrl = {SIT_FRAME_CTRL & 0xFF, SIT_FRAME_CTRL >> 8},     \
+        .sequence = (seq),                                              \
+        .pan_id = {SIT_PAN_ID & 0xFF, SIT_PAN_ID >> 8},                 \
+        .dest = (dst),                                                  \
+        .dest_hi = ((dst) == SIT_BROADCAST_ID) ? 0xFF : 0x00,           \
+        .source = (src),                                                \
+        .msg = SIT_MSG_BYTE(msg_id, SIT_FRAME_VERSION),                 \
+    }
+
+typedef struct __packed {
     header_t header;
     uint16_t crc;
 } msg_simple_t;
 
+typedef struct __packed {
+    header_t header;
+    sit_ts40_t tx_ts;   // TX time of a sync (reference clock), 0 for a blink
+    uint16_t crc;
+} msg_tdoa_t;
+
+typedef struct __packed {
+    header_t header;
+    uint8_t slots;        // initiator slots in this superframe
+    uint8_t responders;   // DS-TWR exchanges in every slot
+    uint16_t slot_uus;    // length of one slot in UWB microseconds
+    uint16_t crc;
+} msg_tdma_beacon_t;
+
 typedef struct {
     uint8_t nlos; // NLOS percentage
     float rssi; // Recived Signal Strangth Index (Recived Path Index)
     float fpi; // First Path Index
 } diagnostic_info;
 
-typedef struct {
+typedef struct __packed {
     header_t header;
-    uint32_t poll_rx_ts;
-    uint32_t resp_tx_ts;
+    sit_ts40_t poll_rx_ts;
+    sit_ts40_t resp_tx_ts;
     uint16_t crc;
 } msg_ss_twr_final_t;
 
-typedef struct {
+typedef struct __packed {
     header_t header;
-    uint32_t poll_tx_ts;
-    uint32_t resp_rx_ts;
-    uint32_t final_tx_ts;
+    sit_ts40_t poll_tx_ts;
+    sit_ts40_t resp_rx_ts;
+    sit_ts40_t final_tx_ts;
     uint16_t crc;
 } msg_ds_twr_final_t;
 
-typedef struct {
+typedef struct __packed {
     header_t header;
-    uint32_t poll_rx_ts;
-    uint32_t resp_tx_ts;
-    uint32_t final_rx_ts;
+    sit_ts40_t poll_rx_ts;
+    sit_ts40_t resp_tx_ts;
+    sit_ts40_t final_rx_ts;
     uint16_t crc;
 } msg_ds_twr_resp_t;
 
-typedef struct {
+/* Frame of the all to all DS-TWR, node 0 is the initiator, node n the responder 99 + n */
+#define DS_ALL_MAX_RESPONDER CONFIG_SIT_TWR_MAX_RESPONDER
+#define DS_ALL_MAX_NODES (DS_ALL_MAX_RESPONDER + 1)
+
+typedef struct __packed {
+    header_t header;
+    sit_ts40_t tx_ts;   // TX time of this frame
+    uint32_t rx_mask;   // bit n set -> rx_ts[n] is valid
+    sit_ts40_t rx_ts[DS_ALL_MAX_NODES];  // RX time of the last frame of node n
+    uint16_t crc;
+} msg_ds_all_twr_t;
+
+typedef struct __packed {
     header_t header;
     uint32_t sensing_1_tx;
     uint32_t sensing_2_rx;
@@ -156,7 +226,7 @@ typedef struct {
     uint16_t crc;
 } msg_sensing_3_t;
 
-typedef struct {
+typedef struct __packed {
     header_t header;
     uint32_t sensing_1_rx;
     uint32_t sensing_2_tx;
@@ -228,27 +298,50 @@ typedef struct {
     json_td_data_t data;
 } json_simple_td_msg_t;
 
-extern dwt_config_t sit_device_config;
+typedef struct {
+    uint64_t rx_ts;         // RX time of the blink (anchor clock)
+    uint64_t sync_tx_ts;    // TX time of the last sync (reference clock)
+    uint64_t sync_rx_ts;    // RX time of the last sync (anchor clock)
+    float clock_offset;     // anchor clock / reference clock - 1
+    uint8_t tag;
+    uint8_t anchor;
+    uint8_t blink_sequence;
+    uint8_t sync_sequence;
+} json_tdoa_data_t;
 
-/* Delay between frames, in UWB microseconds. */
-// #define POLL_TX_TO_RESP_RX_DLY_UUS 250 // 240 * 1,026us ->
-#define POLL_TX_TO_RESP_RX_DLY_UUS 1000 // 240 * 1,026us ->
-/* Delay between frames, in UWB microseconds. */
-#define POLL_RX_TO_RESP_TX_DLY_UUS 1350 // 650 * 1,026us ->
-#define RESP_TX_TO_FINAL_RX_DLY_UUS 500 // 650 * 1,026us ->
-/* Receive response timeout. */
-#define RESP_RX_TIMEOUT_UUS 2000 // 400 * 1,026us ->
+typedef struct {
+    json_simple_header_t header;
+    json_tdoa_data_t data;
+} json_tdoa_msg_t;
+
+typedef struct {
+    float x;                // position in m
+    float y;
+    float z;
+    float residual;         // RMS of the range residuals in m
+    uint8_t anchors;        // ranges used for the position
+    uint8_t iterations;
+} json_position_data_t;
 
+typedef struct {
+    json_simple_header_t header;
+    json_position_data_t data;
+} json_position_msg_t;
+
+extern dwt_config_t sit_device_config;
 
-#define CPU_PROCESSING_TIME 400
-#define DS_POLL_TX_TO_RESP_RX_DLY_UUS (1100 + CPU_PROCESSING_TIME)
-#define DS_RESP_RX_TO_FINAL_TX_DLY_UUS (1000 + CPU_PROCESSING_TIME)
+/* Reply delays of the DS-TWR and SS-TWR exchanges are set by sit_reply.h,
+ * RX timeouts are derived from the active PHY profile (sit_profile.h) */
 #define DS_RESP_RX_TIMEOUT_UUS 1200
-#define DS_PRE_TIMEOUT 5
 
-#define DS_POLL_RX_TO_RESP_TX_DLY_UUS 1600
-#define DS_RESP_TX_TO_FINAL_RX_DLY_UUS 1200
-#define DS_FINAL_RX_TIMEOUT 1800
+/* All to all DS-TWR: node n > 0 sends at poll + DS_ALL_RESP_DLY_UUS + (n - 1) * DS_ALL_SLOT_UUS */
+#define DS_ALL_POLL_DLY_UUS 1000
+#define DS_ALL_RESP_DLY_UUS 1800
+/* processing time between two slots, the slot is this plus the airtime of a frame */
+#define DS_ALL_SLOT_GAP_UUS 900
+#define DS_ALL_SLOT_UUS (DS_ALL_SLOT_GAP_UUS + sit_profile_airtime_uus(sizeof(msg_ds_all_twr_t)))
+#define DS_ALL_FINAL_DLY_UUS 1000
+#define DS_ALL_RX_MARGIN_UUS 100
 
 
 /**
@@ -266,5 +359,6 @@ void set_max_measurement(uint32_t measurement);
 void set_measurement_type(char *measurement_type);
 void set_rx_ant_dly(uint16_t dly);
 void set_tx_ant_dly(uint16_t dly);
+void set_tdma_slot(uint8_t slot, uint8_t slots);
 
 #endif // __SIT_CONFIG_H__
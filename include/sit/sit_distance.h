@@ -41,6 +41,52 @@
 
 extern diagnostic_info diagnostic;
 
+typedef struct {
+    uint32_t delivered;     ///< good frames read by the ranging code
+    uint32_t filtered;      ///< frames discarded by the DW3000 frame filter
+} sit_frame_stats_t;
+
+/***************************************************************************
+ * Let the DW3000 discard frames which are not addressed to this device
+ * or broadcast. Only writes the DW3000 if the setting or the device ID
+ * changed.
+ *
+ * @param enable    ->  true: filter on short address device ID and SIT_PAN_ID
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_frame_filter(bool enable);
+
+/***************************************************************************
+ * Forget the frame filter setting, the next sit_frame_filter() writes the
+ * DW3000 again. Called after dwt_configure().
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_frame_filter_reset(void);
+
+void sit_get_frame_stats(sit_frame_stats_t *stats);
+
+/***************************************************************************
+ * RX time of the last frame taken with a sit_check_*() function, without
+ * another SPI transaction
+ *
+ * @return 40 bit RX time
+ *
+****************************************************************************/
+uint64_t sit_rx_timestamp(void);
+
+/***************************************************************************
+ * TX time of the last sent frame, read with the last received frame.
+ * Use get_tx_timestamp_u64() if no frame was received after the TX.
+ *
+ * @return 40 bit TX time
+ *
+****************************************************************************/
+uint64_t sit_tx_timestamp(void);
+
 void sit_receive_now(uint16_t preamble_detction_timeout, uint32_t rx_timeout);
 
 /***************************************************************************
@@ -55,6 +101,17 @@ void sit_receive_now(uint16_t preamble_detction_timeout, uint32_t rx_timeout);
 ****************************************************************************/
 void sit_start_poll(uint8_t* msg_data, uint16_t msg_size);
 
+/***************************************************************************
+ * Send a msg immediately without waiting for a response
+ *
+ * @param uint8_t* msg_data ->  pointer to the data you like to send
+ * @param uint16_t msg_size ->  length of the data you like to send
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_send_now(uint8_t* msg_data, uint16_t size);
+
 /***************************************************************************
  * Send a
  *
@@ -69,17 +126,53 @@ void sit_start_poll(uint8_t* msg_data, uint16_t msg_size);
 ****************************************************************************/
 bool sit_send_at(uint8_t* msg_data, uint16_t size, uint32_t tx_time);
 bool sit_send_at_with_response(uint8_t* msg_data, uint16_t size, uint32_t tx_time);
+
 /***************************************************************************
- * Start ranging with a poll msg
+ * Send a frame which is already in the TX buffer, see sit_tx_template.h
  *
- * @param uint8_t* msg_data ->  pointer to the data you like to send with
- *                              the poll msg
- * @param uint32_t msg_size ->  length of the data you like to send
+ * @param offset    ->  TX buffer offset of the frame
+ * @param size      ->  frame length incl. FCS
+ * @param tx_time   ->  start sending msg at this system time
+ * @param response  ->  enable the receiver after the TX
  *
- * @return None
+ * @return bool true  -> if  the msg is send at the tx_time
+ *         bool false -> if the msg is send to late
+ *
+****************************************************************************/
+bool sit_send_buffer_at(uint16_t offset, uint16_t size, uint32_t tx_time, bool response);
+
+/***************************************************************************
+ * Enable the receiver at the time set with dwt_setdelayedtrxtime()
+ *
+ * @param uint32_t timeout  ->  RX timeout in UWB microseconds, 0 -> disabled
+ *
+ * @return bool true  -> if the receiver is enabled
+ *         bool false -> if the RX start time has already passed
+ *
+****************************************************************************/
+bool sit_receive_at(uint32_t timeout);
+
+/***************************************************************************
+ * Wait for the next RX event, frames discarded by the frame filter are
+ * skipped. Sleeps on the event queue with CONFIG_SIT_IRQ.
+ *
+ * @return SYS_STATUS low register of the event
+ *
+****************************************************************************/
+uint32_t sit_msg_receive();
+
+/***************************************************************************
+ * Take the frame of an RX event returned by sit_msg_receive()
+ *
+ * @param status    ->  SYS_STATUS low register of the RX event
+ * @param id        ->  expected message ID
+ * @param message   ->  buffer for the frame
+ * @param size      ->  expected frame length incl. FCS
+ *
+ * @return true if a good frame with this length and ID was received
  *
 ****************************************************************************/
-void sit_receive_at(uint32_t timeout);
+bool sit_take_msg_id(uint32_t status, msg_id_t id, void* message, uint16_t size);
 
 bool sit_check_msg_id(msg_id_t id, msg_simple_t * message);
 
@@ -89,10 +182,24 @@ bool sit_check_ds_final_msg_id(msg_id_t id, msg_ds_twr_final_t* message);
 
 bool sit_check_ds_resp_msg_id(msg_id_t id, msg_ds_twr_resp_t* message);
 
+bool sit_check_ds_all_msg_id(msg_id_t id, msg_ds_all_twr_t* message);
+
 bool sit_check_sensing_3_msg_id(msg_id_t id, msg_sensing_3_t * message);
 
 bool sit_check_sensing_info_msg_id(msg_id_t id, msg_sensing_info_t * message);
 
+bool sit_check_tdma_beacon_msg_id(msg_id_t id, msg_tdma_beacon_t * message);
+
+/***************************************************************************
+ * Receive a TDoA frame, blinks and syncs have the same length
+ *
+ * @param msg_tdoa_t* message ->  received blink or sync
+ *
+ * @return bool true  -> if a blink or a sync is received
+ *
+****************************************************************************/
+bool sit_check_tdoa_msg(msg_tdoa_t * message);
+
 void sit_set_rx_tx_delay_and_rx_timeout(uint32_t delay_us,uint16_t timeout);
 void sit_set_rx_after_tx_delay(uint32_t delay_us);
 void sit_set_rx_timeout(uint16_t timeout);
@@ -0,0 +1,157 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_ds_all.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief All to all DS-TWR.
+ *
+ * Every node sends one broadcast frame per round in its own slot, the
+ * initiator sends the poll and the final. A frame carries its own TX time
+ * and the RX time of the last frame of every other node. For every pair
+ * the frames a(k) -> b(k) -> a(k+1) form a DS-TWR exchange, so each node
+ * gets the distance to all peers from N + 2 frames per round.
+ *
+ * round: | poll (node 0) | resp node 1 | ... | resp node n | final (node 0) |
+ *
+ * All times are kept as 40 bit values in an uint64_t, the exchanges of two
+ * responders span a whole round and would wrap a 32 bit time (67 ms). The
+ * four spans of one exchange are 40 bit differences, an exchange with a
+ * span of 2^32 dtu or more (a peer missed for longer than 67 ms) is
+ * dropped, sit_tof_ds_q8 works on 32 bit spans.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_DS_ALL_H__
+#define __SIT_DS_ALL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sit_config.h"
+
+typedef struct {
+    uint8_t id;         ///< device ID of the peer
+    bool valid;         ///< tx_ts and rx_ts hold the last frame of the peer
+    uint64_t tx_ts;     ///< TX time of the last frame of the peer (peer clock)
+    uint64_t rx_ts;     ///< RX time of the last frame of the peer (own clock)
+} ds_all_peer_t;
+
+typedef struct {
+    uint8_t node;       ///< own node index
+    uint8_t nodes;      ///< initiator + responders
+    bool tx_valid;
+    uint64_t tx_ts;     ///< TX time of the last own frame
+    ds_all_peer_t peer[DS_ALL_MAX_NODES];
+} ds_all_ctx_t;
+
+typedef struct {
+    uint8_t peer_id;
+    uint32_t time_round_1;
+    uint32_t time_reply_1;
+    uint32_t time_round_2;
+    uint32_t time_reply_2;
+    int32_t distance_mm;
+} ds_all_result_t;
+
+/***************************************************************************
+ * Node index of a device, 0 for the initiator, n for the responder 99 + n
+ *
+ * @param device_id ->  device ID
+ *
+ * @return node index
+ *
+****************************************************************************/
+uint8_t sit_ds_all_node_index(uint8_t device_id);
+
+/***************************************************************************
+ * Reset the context
+ *
+ * @param ctx       ->  context of the own node
+ * @param device_id ->  own device ID
+ * @param nodes     ->  initiator + responders in the round
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_ds_all_init(ds_all_ctx_t *ctx, uint8_t device_id, uint8_t nodes);
+
+/***************************************************************************
+ * Start of a slot relative to the poll in UWB microseconds. Slot 0 is the
+ * poll, slot n the response of node n and slot nodes the final.
+ *
+ * @param slot  ->  slot in the round
+ * @param nodes ->  initiator + responders in the round
+ *
+ * @return offset to the poll in UWB microseconds
+ *
+****************************************************************************/
+uint32_t sit_ds_all_slot_uus(uint8_t slot, uint8_t nodes);
+
+/***************************************************************************
+ * Fill the timestamps of an own frame
+ *
+ * @param ctx   ->  context of the own node
+ * @param msg   ->  frame to send, header has to be set
+ * @param tx_ts ->  40 bit TX time of the frame
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_ds_all_fill(const ds_all_ctx_t *ctx, msg_ds_all_twr_t *msg, uint64_t tx_ts);
+
+/***************************************************************************
+ * Check a span of a DS-TWR exchange for sit_tof_ds_q8
+ *
+ * @param span  ->  40 bit time difference
+ *
+ * @return true if the span fits into 32 bit
+ *
+****************************************************************************/
+bool sit_ds_all_span_valid(uint64_t span);
+
+/***************************************************************************
+ * Remember the TX time after the own frame was sent
+ *
+ * @param ctx   ->  context of the own node
+ * @param tx_ts ->  40 bit TX time of the frame
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_ds_all_tx_done(ds_all_ctx_t *ctx, uint64_t tx_ts);
+
+/***************************************************************************
+ * Process a received frame. If the last frame of the peer, the last own
+ * frame and this frame form a DS-TWR exchange the distance is calculated.
+ * Exchanges with a span that does not fit into 32 bit are dropped.
+ *
+ * @param ctx       ->  context of the own node
+ * @param msg       ->  received frame
+ * @param rx_ts     ->  40 bit RX time of the frame
+ * @param result    ->  distance to the peer
+ *
+ * @return true if result holds a new distance
+ *
+****************************************************************************/
+bool sit_ds_all_rx(ds_all_ctx_t *ctx, const msg_ds_all_twr_t *msg, uint64_t rx_ts, ds_all_result_t *result);
+
+#endif // __SIT_DS_ALL_H__
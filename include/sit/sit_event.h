@@ -0,0 +1,170 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_event.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Interrupt driven DW3000 event queue.
+ *
+ * The DW3000 IRQ line triggers dwt_isr(), the registered callbacks put
+ * an event into a message queue. The ranging code waits on this queue
+ * instead of polling the system status register over SPI, so the CPU
+ * can sleep or serve BLE between frames.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_EVENT_H__
+#define __SIT_EVENT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <zephyr/kernel.h>
+
+/**
+ * Enum for the different DW3000 events reported by dwt_isr()
+*/
+typedef enum {
+    sit_evt_tx_done,    ///< frame sent (TXFRS)
+    sit_evt_rx_ok,      ///< good frame received (RXFCG)
+    sit_evt_rx_timeout, ///< frame wait or preamble timeout
+    sit_evt_rx_error,   ///< PHY header, CRC, SFD or sync loss error
+} sit_event_type_t;
+
+typedef struct {
+    sit_event_type_t type;
+    uint32_t status;      ///< SYS_STATUS low register when the ISR was entered
+    uint16_t status_hi;   ///< SYS_STATUS high register when the ISR was entered
+    uint16_t datalength;  ///< length of the received frame (rx_ok only)
+    uint8_t rx_flags;     ///< dwt_cb_data_rx_flags_e (rx_ok only)
+} sit_event_t;
+
+typedef struct {
+    uint32_t events;      ///< events put into the queue
+    uint32_t dropped;     ///< events lost because the queue was full
+    uint32_t timeouts;    ///< CONFIG_SIT_IRQ_EVENT_TIMEOUT_MS passed without a matching event
+    uint32_t lost;        ///< matching events only found in the status register (lost IRQ edge)
+} sit_event_stats_t;
+
+/***************************************************************************
+ * Register the dwt_isr() callbacks, enable the DW3000 interrupts and
+ * the IRQ GPIO. Has to be called after dwt_initialise()/dwt_configure().
+ *
+ * @return 0 on success, negative errno if the IRQ pin is not configured
+ *
+****************************************************************************/
+int sit_event_init(void);
+
+/***************************************************************************
+ * Write the interrupt mask of sit_event_init() again, e.g. after
+ * dwt_configure()
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_event_restore(void);
+
+/***************************************************************************
+ * Drop all queued events. Call before starting a new TX or RX so a late
+ * event of the last exchange can not be taken for the current one.
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_event_flush(void);
+
+/***************************************************************************
+ * Block until an event with at least one status bit in lo_mask or hi_mask
+ * arrives. Events that do not match the masks are discarded. Every
+ * CONFIG_SIT_IRQ_EVENT_TIMEOUT_MS without event the status register is
+ * read, a matching event whose IRQ edge was lost is returned from there,
+ * otherwise the wait goes on. Like the polling mode it only returns on a
+ * real event, a receiver without RX timeout waits until a frame arrives.
+ *
+ * @param lo_mask   ->  SYS_STATUS low bits to wait for
+ * @param hi_mask   ->  SYS_STATUS high bits to wait for
+ * @param event     ->  matching event, can be NULL
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_event_wait(uint32_t lo_mask, uint32_t hi_mask, sit_event_t *event);
+
+void sit_event_get_stats(sit_event_stats_t *stats);
+
+/* Longest frame with standard PHY header */
+#define SIT_RX_FRAME_MAX_LEN 127
+
+/**
+ * Frame of the double buffered listener. The callback only takes the
+ * timestamp and the carrier integrator, the payload is read from the
+ * DW3000 RX buffer in sit_rx_listen_get().
+*/
+typedef struct {
+    uint64_t rx_ts;     ///< 40 bit RX time
+    int32_t ci;         ///< carrier integrator of the frame
+    uint16_t length;    ///< frame length incl. FCS
+    uint8_t data[SIT_RX_FRAME_MAX_LEN];
+} sit_rx_frame_t;
+
+typedef struct {
+    uint32_t frames;    ///< frames put into the listener queue
+    uint32_t dropped;   ///< frames lost because the listener queue was full
+    uint32_t errors;    ///< RX errors and frames which do not fit
+    uint32_t overruns;  ///< frames overwritten in the RX buffer before they were read
+    uint32_t events;    ///< see sit_event_stats_t
+    uint32_t events_dropped;
+} sit_rx_stats_t;
+
+/***************************************************************************
+ * Start the passive listener. The receiver runs in double buffer mode
+ * with auto re-enable, so a frame can arrive while the last one is read.
+ * Frames are taken with sit_rx_listen_get() (CONFIG_SIT_RX_DOUBLE_BUFFER).
+ *
+ * @return 0 on success, negative errno if the receiver can not be enabled
+ *
+****************************************************************************/
+int sit_rx_listen_start(void);
+
+/***************************************************************************
+ * Stop the passive listener and go back to single buffer mode
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_rx_listen_stop(void);
+
+/***************************************************************************
+ * Take the next frame of the passive listener. The payload is read here,
+ * a frame whose RX buffer was already reused by a later frame is dropped
+ * (overruns).
+ *
+ * @param frame     ->  received frame
+ * @param timeout   ->  time to wait for a frame
+ *
+ * @return true if a frame was received
+ *
+****************************************************************************/
+bool sit_rx_listen_get(sit_rx_frame_t *frame, k_timeout_t timeout);
+
+void sit_rx_get_stats(sit_rx_stats_t *stats);
+
+#endif // __SIT_EVENT_H__
@@ -0,0 +1,92 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_frame.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Frame format checks and airtime of the SIT frames.
+ *
+ * The frames are defined in sit_config.h (packed, 802.15.4 header,
+ * 1 byte message ID with SIT_FRAME_VERSION, 5 byte timestamps). The
+ * airtime of a frame follows from the PHY settings in dwt_config_t:
+ *
+ * SHR  = (preamble + SFD) symbols
+ * PHR  = 19 bits at 850 kbit/s (or at data rate with DWT_PHRRATE_DTA)
+ * data = 8 bits per byte + 48 Reed-Solomon bits per started 330 bits
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_FRAME_H__
+#define __SIT_FRAME_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <deca_device_api.h>
+
+#include "sit_config.h"
+
+/***************************************************************************
+ * Check the 802.15.4 header and the SIT frame version of a received frame
+ *
+ * @param data      ->  received frame
+ * @param length    ->  frame length incl. FCS
+ *
+ * @return true if the frame is a SIT frame of this version
+ *
+****************************************************************************/
+bool sit_frame_valid(const uint8_t *data, uint16_t length);
+
+/***************************************************************************
+ * Message ID and frame version of the header, the message byte is encoded
+ * with explicit shifts so the wire format does not depend on the bitfield
+ * order of the compiler
+ *
+ * @param header    ->  header of a SIT frame
+ *
+ * @return msg_id_t / SIT_FRAME_VERSION of the frame
+ *
+****************************************************************************/
+msg_id_t sit_frame_id(const header_t *header);
+uint8_t sit_frame_version(const header_t *header);
+
+/***************************************************************************
+ * Time on air of a frame from the first preamble symbol to the last bit
+ *
+ * @param config    ->  PHY configuration, e.g. sit_device_config
+ * @param length    ->  frame length incl. FCS
+ *
+ * @return airtime in ns
+ *
+****************************************************************************/
+uint32_t sit_frame_airtime_ns(const dwt_config_t *config, uint16_t length);
+
+/***************************************************************************
+ * Log length and airtime of the ranging frames and of a DS-TWR exchange
+ * for the given configuration
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_frame_log_airtime(const dwt_config_t *config);
+
+#endif // __SIT_FRAME_H__
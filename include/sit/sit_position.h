@@ -0,0 +1,142 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_position.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Position solver of the tag.
+ *
+ * The initiator collects the latest range to every anchor (responder
+ * 100 + index) and solves its position with Gauss-Newton iterations of
+ * the range equations, so one position instead of one distance per
+ * responder is notified. The anchor coordinates come with the setup
+ * message, without anchors the distances are notified as before.
+ *
+ * 2D: x and y are solved, z of the tag is CONFIG_SIT_POSITION_TAG_Z_MM.
+ * 3D (CONFIG_SIT_POSITION_3D): x, y and z are solved, the anchors must
+ * not lie in one plane.
+ *
+ * Uplink TDoA: the RX times of one blink at the anchors are mapped into
+ * the clock of the reference anchor and the position is solved from the
+ * range differences to the first anchor. This runs on the host, which
+ * gets the records of all anchors.
+ * All math is single precision float for the FPU of the nRF52833, only
+ * the TDoA times are double.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_POSITION_H__
+#define __SIT_POSITION_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sit_config.h"
+
+#define SIT_POSITION_MAX_ANCHORS CONFIG_SIT_TWR_MAX_RESPONDER
+
+typedef struct {
+    float x;            ///< in m
+    float y;            ///< in m
+    float z;            ///< in m
+    float residual;     ///< RMS of the range residuals in m
+    uint8_t anchors;    ///< number of ranges used
+    uint8_t iterations; ///< Gauss-Newton iterations
+} sit_position_t;
+
+typedef struct {
+    float pos[3];       ///< anchor position in m
+    double rx_time;     ///< RX time of the blink in the reference clock, s
+} sit_position_tdoa_t;
+
+/***************************************************************************
+ * Forget all anchors, ranges and the last position
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_position_reset(void);
+
+/***************************************************************************
+ * Set the coordinates of an anchor
+ *
+ * @param index ->  anchor index, device ID - 100
+ * @param x     ->  coordinates in m
+ * @param y
+ * @param z
+ *
+ * @return 0 on success, -EINVAL if the index is too big
+ *
+****************************************************************************/
+int sit_position_set_anchor(uint8_t index, float x, float y, float z);
+
+/***************************************************************************
+ * Check if enough anchors are set for a position (3 for 2D, 4 for 3D)
+ *
+ * @return true if ranges should be solved instead of notified
+ *
+****************************************************************************/
+bool sit_position_enabled(void);
+
+/***************************************************************************
+ * Store the latest range to an anchor
+ *
+ * @param index         ->  anchor index, device ID - 100
+ * @param distance_mm   ->  range in mm
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_position_add_range(uint8_t index, int32_t distance_mm);
+
+/***************************************************************************
+ * Solve the position with the ranges of the last
+ * CONFIG_SIT_POSITION_MAX_AGE_MS. The last position is the start value.
+ *
+ * @param position  ->  result
+ *
+ * @return true if enough ranges were available and the solution is finite
+ *
+****************************************************************************/
+bool sit_position_solve(sit_position_t *position);
+
+/***************************************************************************
+ * Map the RX time of a TDoA record into the reference clock
+ * @param record        ->  record of the anchor
+ * @param sync_distance ->  distance of the anchor to the reference anchor in m
+ * @return RX time of the blink in the reference clock in s, modulo the
+ *         40 bit timestamp period
+****************************************************************************/
+double sit_position_tdoa_time(const json_tdoa_data_t *record, float sync_distance);
+
+/***************************************************************************
+ * Solve the position from the RX times of one blink, without the anchors
+ * and the last position of sit_position_set_anchor()/sit_position_solve()
+ * @param obs       ->  anchor positions and RX times, obs[0] is the base of
+ *                      the range differences
+ * @param count     ->  number of anchors (4 for 2D, 5 for 3D)
+ * @param position  ->  result, residual is the RMS of the range differences
+ * @return true if enough anchors were given and the solution is finite
+****************************************************************************/
+bool sit_position_solve_tdoa(const sit_position_tdoa_t *obs, uint8_t count, sit_position_t *position);
+
+#endif // __SIT_POSITION_H__
@@ -0,0 +1,119 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_profile.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief PHY profiles for the rate versus range trade-off.
+ *
+ * A profile sets preamble length, PAC size, data rate and SFD of
+ * sit_device_config. Short preambles cut the airtime of every frame in
+ * small rooms, long preambles and 850 kbit/s give more range. The RX
+ * timeouts and delays of the ranging code are derived from the active
+ * profile with the functions below.
+ *
+ * A profile is selected with the "profile" field of the JSON setup
+ * message and applied by the ranging thread before the next measurement.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_PROFILE_H__
+#define __SIT_PROFILE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <deca_device_api.h>
+
+typedef struct {
+    const char *name;
+    dwt_tx_plen_e plen;
+    dwt_pac_size_e pac;
+    dwt_uwb_bit_rate_e data_rate;
+    dwt_sfd_type_e sfd;
+} sit_profile_t;
+
+/***************************************************************************
+ * Select a profile by name, it is applied with the next sit_profile_apply()
+ *
+ * @param name  ->  "fast", "short", "default" or "long"
+ *
+ * @return 0 on success, -EINVAL for an unknown name
+ *
+****************************************************************************/
+int sit_profile_select(const char *name);
+
+/***************************************************************************
+ * Configure the DW3000 with the selected profile. Does nothing if the
+ * profile is already active. The settings outside of dwt_config_t are
+ * applied again with sit_radio_restore(). Called by the ranging thread
+ * for every new setup, it owns the DW3000.
+ *
+ * @return 0 on success, -EIO if dwt_configure() failed
+ *
+****************************************************************************/
+int sit_profile_apply(void);
+
+const sit_profile_t *sit_profile_get(void);
+
+/* Preamble length of the active profile in symbols */
+uint32_t sit_profile_preamble_symbols(void);
+
+/* Time from the first preamble symbol to the RMARKER (preamble and SFD) */
+uint32_t sit_profile_shr_uus(void);
+
+/* Airtime of a frame with length bytes incl. FCS */
+uint32_t sit_profile_airtime_uus(uint16_t length);
+
+/***************************************************************************
+ * Extra RX time for the frame length of the active profile, like
+ * get_rx_delay_time_txpreamble() + get_rx_delay_time_data_rate() in
+ * shared_functions.c
+ *
+ * @return extra time in UWB microseconds
+ *
+****************************************************************************/
+uint32_t sit_profile_rx_delay_uus(void);
+
+/***************************************************************************
+ * RX timeout for a window, like set_resp_rx_timeout() in shared_functions.c
+ *
+ * @param window_uus    ->  time between RX enable and the latest expected
+ *                          RMARKER
+ *
+ * @return RX frame wait timeout in UWB microseconds
+ *
+****************************************************************************/
+uint32_t sit_profile_rx_timeout_uus(uint32_t window_uus);
+
+/***************************************************************************
+ * Preamble detection timeout for a window
+ *
+ * @param window_uus    ->  time between RX enable and the latest expected
+ *                          RMARKER
+ *
+ * @return timeout in PACs for dwt_setpreambledetecttimeout()
+ *
+****************************************************************************/
+uint16_t sit_profile_preamble_timeout_pac(uint32_t window_uus);
+
+#endif // __SIT_PROFILE_H__
@@ -0,0 +1,91 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_range_filter.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Per responder filter of the TWR ranges.
+ *
+ * Raw ranges contain NLOS and multipath spikes. Every responder gets its
+ * own filter state, selected with Kconfig:
+ *  - SIT_RANGE_FILTER_NONE: the raw range is passed through
+ *  - SIT_RANGE_FILTER_KALMAN: constant velocity Kalman filter, a range
+ *    outside the innovation gate is rejected
+ *  - SIT_RANGE_FILTER_MEDIAN: median of the last ranges
+ *
+ * The NLOS flag and the gap between received and first path power of the
+ * diagnostic raise the measurement noise (Kalman) or drop the range
+ * (median). With CONFIG_SIT_RANGE_FILTER_DECIMATION only every n-th
+ * filtered range of a responder is notified.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_RANGE_FILTER_H__
+#define __SIT_RANGE_FILTER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sit_config.h"
+
+typedef struct {
+    uint32_t accepted;  ///< ranges taken by the filter
+    uint32_t rejected;  ///< ranges outside the gate or dropped as NLOS
+    uint32_t resets;    ///< filters restarted after too many rejected ranges
+} sit_range_filter_stats_t;
+
+/***************************************************************************
+ * Reset the filters of all responders
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_range_filter_reset(void);
+
+/***************************************************************************
+ * Filter a new range of a responder
+ *
+ * @param responder_id  ->  device ID of the responder
+ * @param distance_mm   ->  raw range
+ * @param quality       ->  diagnostic of the last frame of the exchange,
+ *                          can be NULL
+ * @param filtered_mm   ->  filtered range
+ *
+ * @return false if the range was rejected, filtered_mm is not set then
+ *
+****************************************************************************/
+bool sit_range_filter_update(uint8_t responder_id, int32_t distance_mm,
+                             const diagnostic_info *quality, int32_t *filtered_mm);
+
+/***************************************************************************
+ * Decimation of the notifications, call once per accepted range
+ *
+ * @param responder_id  ->  device ID of the responder
+ *
+ * @return true if this range should be notified
+ *
+****************************************************************************/
+bool sit_range_filter_decimate(uint8_t responder_id);
+
+void sit_range_filter_get_stats(sit_range_filter_stats_t *stats);
+
+#endif // __SIT_RANGE_FILTER_H__
@@ -0,0 +1,136 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_reply.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Adaptive reply delay of the ranging exchanges.
+ *
+ * A reply (response, final, final response) is sent at a delayed TX time
+ * relative to the RX time of the frame it answers. The delay has to cover
+ * the processing from RX done to dwt_starttx(), every extra microsecond
+ * lowers the exchange rate and adds clock drift error to the TWR result.
+ *
+ * The module measures the time left between dwt_starttx() and the
+ * delayed TX time. The delay is set to the largest processing latency of
+ * a window plus a margin and backed off after a late TX.
+ *
+ * The RX windows for the reply of a peer follow the active PHY profile
+ * (see sit_profile.h).
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_REPLY_H__
+#define __SIT_REPLY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Time the receiver is opened before the earliest reply of the peer */
+#define SIT_REPLY_RX_GUARD_UUS 300
+
+typedef struct {
+    uint32_t reply_uus;     ///< current reply delay
+    uint32_t latency_uus;   ///< largest processing latency of the last window
+    uint32_t samples;       ///< measured replies
+    uint32_t late;          ///< replies with late TX
+} sit_reply_stats_t;
+
+/***************************************************************************
+ * Start again with the maximum reply delay CONFIG_SIT_REPLY_MAX_UUS
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_reply_reset(void);
+
+/***************************************************************************
+ * Delayed TX time of a reply, the next sit_send_at() with this time is
+ * measured.
+ *
+ * @param rx_ts ->  40 bit RX time of the frame which is answered
+ *
+ * @return delayed TX time for dwt_setdelayedtrxtime()
+ *
+****************************************************************************/
+uint32_t sit_reply_tx_time(uint64_t rx_ts);
+
+/***************************************************************************
+ * RX after TX delay for the reply of a peer. The peer replies at least
+ * CONFIG_SIT_REPLY_MIN_UUS after our frame.
+ *
+ * @return delay for dwt_setrxaftertxdelay() in UWB microseconds
+ *
+****************************************************************************/
+uint32_t sit_reply_rx_after_tx_uus(void);
+
+/***************************************************************************
+ * RX timeout which covers every reply delay of a peer
+ *
+ * @return timeout for dwt_setrxtimeout() in UWB microseconds
+ *
+****************************************************************************/
+uint16_t sit_reply_rx_timeout_uus(void);
+
+/***************************************************************************
+ * Preamble detection timeout which covers every reply delay of a peer
+ *
+ * @return timeout for dwt_setpreambledetecttimeout() in PACs
+ *
+****************************************************************************/
+uint16_t sit_reply_preamble_timeout_pac(void);
+
+/***************************************************************************
+ * RX window of a device which listens to an exchange of two peers and
+ * opens the receiver right after the previous frame of the exchange
+ *
+ * @return time between RX enable and the latest RMARKER of the next
+ *         reply in UWB microseconds, see sit_profile_rx_timeout_uus()
+ *
+****************************************************************************/
+uint32_t sit_reply_listen_window_uus(void);
+
+/***************************************************************************
+ * Read the system time right before dwt_starttx() of a delayed TX.
+ * Only a reply of sit_reply_tx_time() is measured.
+ *
+ * @param tx_time   ->  delayed TX time of the frame
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_reply_check(uint32_t tx_time);
+
+/***************************************************************************
+ * Take the result of dwt_starttx() and adapt the reply delay
+ *
+ * @param tx_time   ->  delayed TX time of the frame
+ * @param ok        ->  false if the TX was late
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_reply_result(uint32_t tx_time, bool ok);
+
+void sit_reply_get_stats(sit_reply_stats_t *stats);
+
+#endif // __SIT_REPLY_H__
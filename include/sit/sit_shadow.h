@@ -0,0 +1,70 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_shadow.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Shadow of the DW3000 RX timing registers.
+ *
+ * The ranging loops set the RX after TX delay, the RX timeout and the
+ * preamble detection timeout before every exchange, mostly with the
+ * values of the last exchange. The shadow keeps the last written values,
+ * a set only marks a register dirty if the value changes. Dirty registers
+ * are written in sit_shadow_flush() right before the next TX or RX start,
+ * so a value set twice in a row costs one SPI write.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_SHADOW_H__
+#define __SIT_SHADOW_H__
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t writes;    ///< register writes sent to the DW3000
+    uint32_t elided;    ///< sets without a write (value unchanged or overwritten before the flush)
+} sit_shadow_stats_t;
+
+/***************************************************************************
+ * Forget all register values, e.g. after dwt_initialise()/dwt_configure()
+ * or a wake-up. The next set of every register is written.
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_shadow_reset(void);
+
+void sit_shadow_set_rx_after_tx_delay(uint32_t delay_uus);
+void sit_shadow_set_rx_timeout(uint32_t timeout_uus);
+void sit_shadow_set_preamble_timeout(uint16_t timeout_pac);
+
+/***************************************************************************
+ * Write all dirty registers, call before dwt_starttx()/dwt_rxenable()
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_shadow_flush(void);
+
+void sit_shadow_get_stats(sit_shadow_stats_t *stats);
+
+#endif // __SIT_SHADOW_H__
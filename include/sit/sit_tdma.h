@@ -0,0 +1,118 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_tdma.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief TDMA superframe for many initiators.
+ *
+ * The first responder (ID 100) sends a beacon at the start of every
+ * superframe. Every initiator owns one slot after the beacon and sends
+ * its polls with a delayed TX relative to the beacon RX timestamp, so
+ * the polls of different initiators never collide.
+ *
+ * superframe: | beacon | guard | slot 0 | slot 1 | ... | slot n-1 |
+ * slot:       | exchange resp 100 | exchange resp 101 | ...      |
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TDMA_H__
+#define __SIT_TDMA_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sit_config.h"
+
+/* Responder which sends the TDMA beacon */
+#define SIT_TDMA_BEACON_ID 100
+
+/* An initiator ranges at most this many responders in its slot */
+#define SIT_TDMA_MAX_RESPONDERS CONFIG_SIT_TWR_MAX_RESPONDER
+
+/***************************************************************************
+ * Send the beacon for a new superframe (anchor only)
+ *
+ * @param sequence  ->  superframe sequence number
+ * @param slots     ->  initiator slots in the superframe
+ * @param responders->  DS-TWR exchanges in every slot
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_tdma_send_beacon(uint8_t sequence, uint8_t slots, uint8_t responders);
+
+/***************************************************************************
+ * Listen for the next beacon (initiator only)
+ *
+ * @param beacon        ->  received beacon
+ * @param beacon_rx_ts  ->  40 bit RX timestamp of the beacon
+ *
+ * @return true if a beacon was received
+ *
+****************************************************************************/
+bool sit_tdma_wait_beacon(msg_tdma_beacon_t *beacon, uint64_t *beacon_rx_ts);
+
+/***************************************************************************
+ * Delayed TX time for a poll in the own slot
+ *
+ * @param beacon_rx_ts  ->  40 bit RX timestamp of the beacon
+ * @param beacon        ->  received beacon
+ * @param slot          ->  slot of this initiator
+ * @param exchange      ->  index of the responder inside the slot
+ *
+ * @return time for dwt_setdelayedtrxtime()
+ *
+****************************************************************************/
+uint32_t sit_tdma_poll_tx_time(uint64_t beacon_rx_ts, const msg_tdma_beacon_t *beacon, uint8_t slot, uint8_t exchange);
+
+/***************************************************************************
+ * DS-TWR exchanges in a slot
+ *
+ * @param responders    ->  responders in the field
+ *
+ * @return responders limited to 1 .. SIT_TDMA_MAX_RESPONDERS
+ *
+****************************************************************************/
+uint8_t sit_tdma_responders(uint8_t responders);
+
+/***************************************************************************
+ * Length of a slot, SIT_TDMA_MAX_RESPONDERS exchanges always fit into the
+ * 16 bit slot_uus of the beacon (checked at build time)
+ *
+ * @param responders    ->  responders in the field
+ *
+ * @return slot length in UWB microseconds
+ *
+****************************************************************************/
+uint16_t sit_tdma_slot_uus(uint8_t responders);
+uint32_t sit_tdma_superframe_uus(uint8_t slots, uint8_t responders);
+
+/***************************************************************************
+ * Aggregate ranging rate of the field, every slot ranges all responders
+ * once per superframe.
+ *
+ * @return ranges per second for all initiators together
+ *
+****************************************************************************/
+uint32_t sit_tdma_ranges_per_second(uint8_t slots, uint8_t responders);
+
+#endif // __SIT_TDMA_H__
@@ -0,0 +1,116 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_tdoa.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Uplink TDoA with blinking tags.
+ *
+ * A tag only sends a blink. Every anchor timestamps the blink and reports
+ * a record (tag, anchor, RX time, last sync) to the host. The reference
+ * anchor sends sync frames with their TX time, from two syncs an anchor
+ * knows the offset of its clock to the reference clock, so the host can
+ * map all RX times into the reference clock and solve the position.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TDOA_H__
+#define __SIT_TDOA_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sit_config.h"
+
+/* Anchor which sends the sync frames */
+#define SIT_TDOA_REFERENCE_ID 100
+
+typedef struct {
+    bool valid;             ///< a sync was received
+    bool offset_valid;      ///< clock_offset is set from the clock model
+    uint8_t sequence;       ///< sequence of the last sync
+    uint64_t sync_tx_ts;    ///< TX time of the last sync (reference clock)
+    uint64_t sync_rx_ts;    ///< RX time of the last sync (own clock)
+    double clock_offset;    ///< own clock / reference clock - 1
+} tdoa_clock_t;
+
+/***************************************************************************
+ * Send a blink (tag only)
+ *
+ * @param sequence  ->  sequence number of the blink
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_tdoa_send_blink(uint8_t sequence);
+
+/***************************************************************************
+ * Send a sync with its TX time (reference anchor only)
+ *
+ * @param sequence  ->  sequence number of the sync
+ * @param tx_ts     ->  40 bit TX time of the sync
+ *
+ * @return true if the sync is sent
+ *
+****************************************************************************/
+bool sit_tdoa_send_sync(uint8_t sequence, uint64_t *tx_ts);
+
+/***************************************************************************
+ * Update the clock of the reference anchor after an own sync, its clock
+ * is the reference clock.
+ *
+ * @param clock     ->  clock of the anchor
+ * @param sequence  ->  sequence number of the sync
+ * @param tx_ts     ->  40 bit TX time of the sync
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_tdoa_clock_reference(tdoa_clock_t *clock, uint8_t sequence, uint64_t tx_ts);
+
+/***************************************************************************
+ * Update the clock model of the reference with a received sync and take
+ * the filtered clock offset
+ *
+ * @param clock ->  clock of the anchor
+ * @param sync  ->  received sync
+ * @param rx_ts ->  40 bit RX time of the sync
+ * @param ci    ->  carrier integrator of the sync
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_tdoa_clock_update(tdoa_clock_t *clock, const msg_tdoa_t *sync, uint64_t rx_ts, int32_t ci);
+
+/***************************************************************************
+ * Fill the record of a received blink
+ *
+ * @param clock ->  clock of the anchor
+ * @param blink ->  received blink
+ * @param rx_ts ->  40 bit RX time of the blink
+ * @param data  ->  record for the host
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_tdoa_record(const tdoa_clock_t *clock, const msg_tdoa_t *blink, uint64_t rx_ts, json_tdoa_data_t *data);
+
+#endif // __SIT_TDOA_H__
@@ -0,0 +1,93 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_tof.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Fixed point time of flight calculation.
+ *
+ * The FPU of the nRF52833 is single precision only, double math runs as
+ * soft-float. The TWR formulas are calculated with 64 bit integers on
+ * 32 bit DW3000 time differences instead, the result is the distance in
+ * millimetres.
+ *
+ * Times of flight are kept as Q8 device time units (1/256 dtu), clock
+ * skews as Q40 (1 << 40 = 1.0), see sit_clock.h for the skew definition.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TOF_H__
+#define __SIT_TOF_H__
+
+#include <stdint.h>
+
+#define SIT_TOF_SKEW_SHIFT 40
+#define SIT_TOF_SKEW_ONE ((int64_t)1 << SIT_TOF_SKEW_SHIFT)
+
+/***************************************************************************
+ * Clock skew of the peer from the carrier integrator of its frame
+ *
+ * @param ci    ->  dwt_readcarrierintegrator() of the frame
+ *
+ * @return skew in Q40
+ *
+****************************************************************************/
+int32_t sit_tof_ci_to_skew_q40(int32_t ci);
+
+/***************************************************************************
+ * Asymmetric DS-TWR:
+ * tof = (round_1 * round_2 - reply_1 * reply_2) / (round_1 + round_2 + reply_1 + reply_2)
+ *
+ * @param round_1   ->  resp RX - poll TX (initiator clock)
+ * @param reply_1   ->  resp TX - poll RX (responder clock)
+ * @param round_2   ->  final RX - resp TX (responder clock)
+ * @param reply_2   ->  final TX - resp RX (initiator clock)
+ *
+ * @return time of flight in Q8 dtu
+ *
+****************************************************************************/
+int64_t sit_tof_ds_q8(uint32_t round_1, uint32_t reply_1, uint32_t round_2, uint32_t reply_2);
+
+/***************************************************************************
+ * SS-TWR with clock drift correction:
+ * tof = (round - reply * (1 - skew)) / 2
+ *
+ * @param round     ->  resp RX - poll TX (initiator clock)
+ * @param reply     ->  resp TX - poll RX (responder clock)
+ * @param skew_q40  ->  skew of the responder in Q40
+ *
+ * @return time of flight in Q8 dtu
+ *
+****************************************************************************/
+int64_t sit_tof_ss_q8(uint32_t round, uint32_t reply, int32_t skew_q40);
+
+/***************************************************************************
+ * Distance of a time of flight
+ *
+ * @param tof_q8    ->  time of flight in Q8 dtu
+ *
+ * @return distance in mm
+ *
+****************************************************************************/
+int32_t sit_tof_to_mm(int64_t tof_q8);
+
+#endif // __SIT_TOF_H__
@@ -0,0 +1,98 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_trace.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Binary trace of the ranging hot path.
+ *
+ * A LOG_INF between the RX of a frame and the delayed TX of the answer
+ * formats a string and costs a good part of the reply time. SIT_TRACE()
+ * only writes a small record into a lock-free ring, a low priority thread
+ * drains the ring and logs the records outside of the exchange.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TRACE_H__
+#define __SIT_TRACE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Enum for the trace events
+*/
+typedef enum {
+    sit_trace_tx_done,          ///< frame sent, dw_ts = delayed TX time
+    sit_trace_tx_late,          ///< delayed TX missed, dw_ts = delayed TX time
+    sit_trace_rx_enable,        ///< receiver enabled, arg = RX timeout
+    sit_trace_rx_enable_fail,   ///< receiver could not be enabled
+    sit_trace_rx_ok,            ///< good frame received, arg = frame length
+    sit_trace_rx_error,         ///< RX timeout or error
+    sit_trace_rx_length,        ///< frame with unexpected length, arg = frame length
+} sit_trace_event_t;
+
+typedef struct {
+    uint32_t seq;       ///< write index, detects records overwritten while read
+    uint32_t cycle;     ///< k_cycle_get_32() of the event
+    uint32_t dw_ts;     ///< DW3000 time (high 32 bit) if known
+    uint32_t status;    ///< SYS_STATUS low register
+    uint16_t event;     ///< sit_trace_event_t
+    uint16_t arg;
+} sit_trace_record_t;
+
+#ifdef CONFIG_SIT_TRACE
+/***************************************************************************
+ * Write a record into the trace ring, safe from every thread
+ *
+ * @param event     ->  sit_trace_event_t
+ * @param arg       ->  event specific argument
+ * @param dw_ts     ->  DW3000 time if known, otherwise 0
+ * @param status    ->  SYS_STATUS low register
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_trace(sit_trace_event_t event, uint16_t arg, uint32_t dw_ts, uint32_t status);
+
+/***************************************************************************
+ * Take the oldest records out of the ring
+ *
+ * @param records   ->  buffer for the records
+ * @param max       ->  size of the buffer
+ *
+ * @return number of records
+ *
+****************************************************************************/
+uint32_t sit_trace_drain(sit_trace_record_t *records, uint32_t max);
+
+/***************************************************************************
+ * Number of records overwritten before they were drained
+ *
+****************************************************************************/
+uint32_t sit_trace_lost(void);
+
+#define SIT_TRACE(event, arg, dw_ts, status) sit_trace(event, arg, dw_ts, status)
+#else
+#define SIT_TRACE(event, arg, dw_ts, status)
+#endif
+
+#endif // __SIT_TRACE_H__
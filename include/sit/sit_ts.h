@@ -0,0 +1,136 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_ts.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief 40 bit DW3000 timestamps.
+ *
+ * The DW3000 counts in device time units (dtu, around 15.65 ps) with a
+ * 40 bit counter, which wraps every 17.2 s. All differences are taken
+ * modulo 2^40, so an exchange over the wrap gives the right result.
+ * Delayed TX times only use the bits 39..9 of a timestamp, the helpers
+ * below convert between both and add the TX antenna delay.
+ *
+ * On air a timestamp takes 5 bytes (little endian) instead of 8.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TS_H__
+#define __SIT_TS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SIT_TS_MASK 0xFFFFFFFFFFULL
+#define SIT_TS_LEN 5
+
+typedef uint64_t sit_ts_t;
+
+/**
+ * Timestamp packed for the frames, use sit_ts_pack()/sit_ts_unpack()
+*/
+typedef struct {
+    uint8_t b[SIT_TS_LEN];
+} sit_ts40_t;
+
+/***************************************************************************
+ * Add a time to a timestamp
+ *
+ * @param ts    ->  40 bit timestamp
+ * @param dtu   ->  time in dtu, can be negative
+ *
+ * @return 40 bit timestamp
+ *
+****************************************************************************/
+sit_ts_t sit_ts_add(sit_ts_t ts, int64_t dtu);
+
+/***************************************************************************
+ * Add a time in UWB microseconds to a timestamp
+ *
+ * @param ts    ->  40 bit timestamp
+ * @param uus   ->  time in UWB microseconds
+ *
+ * @return 40 bit timestamp
+ *
+****************************************************************************/
+sit_ts_t sit_ts_add_uus(sit_ts_t ts, uint32_t uus);
+
+/***************************************************************************
+ * Time from earlier to later, modulo 2^40
+ *
+ * @return difference in dtu, 0 .. 2^40 - 1
+ *
+****************************************************************************/
+uint64_t sit_ts_diff(sit_ts_t later, sit_ts_t earlier);
+
+/***************************************************************************
+ * Signed time from earlier to later, for timestamps less than half the
+ * counter period (8.6 s) apart
+ *
+ * @return difference in dtu, -2^39 .. 2^39 - 1
+ *
+****************************************************************************/
+int64_t sit_ts_sdiff(sit_ts_t later, sit_ts_t earlier);
+
+/***************************************************************************
+ * @return true if earlier is before later (less than half a period)
+ *
+****************************************************************************/
+bool sit_ts_before(sit_ts_t earlier, sit_ts_t later);
+
+/***************************************************************************
+ * Delayed TX time for dwt_setdelayedtrxtime()
+ *
+ * @param ts    ->  40 bit timestamp
+ *
+ * @return bits 39..8 of the timestamp
+ *
+****************************************************************************/
+uint32_t sit_ts_to_tx_time(sit_ts_t ts);
+
+/***************************************************************************
+ * Delayed TX time uus after a timestamp
+ *
+ * @param ts    ->  40 bit timestamp, e.g. the RX time of a frame
+ * @param uus   ->  delay in UWB microseconds
+ *
+ * @return delayed TX time for dwt_setdelayedtrxtime()
+ *
+****************************************************************************/
+uint32_t sit_ts_tx_time_after(sit_ts_t ts, uint32_t uus);
+
+/***************************************************************************
+ * TX timestamp of a frame sent at a delayed TX time. The DW3000 ignores
+ * bit 0 of the delayed TX time and adds the TX antenna delay.
+ *
+ * @param tx_time   ->  delayed TX time
+ *
+ * @return 40 bit TX timestamp
+ *
+****************************************************************************/
+sit_ts_t sit_ts_from_tx_time(uint32_t tx_time);
+
+void sit_ts_pack(sit_ts40_t *packed, sit_ts_t ts);
+sit_ts_t sit_ts_unpack(const sit_ts40_t *packed);
+
+#endif // __SIT_TS_H__
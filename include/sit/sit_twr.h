@@ -0,0 +1,168 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_twr.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief DS-TWR initiator state machine.
+ *
+ * Every responder gets its own context with the state of the exchange
+ * (poll -> resp -> final -> report, ds_3_twr ends after the final with
+ * the distance on the responder side). A scheduler decides which responder
+ * gets a slot in the current round, so a responder that does not answer
+ * only costs its own slot and is backed off in the next rounds.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TWR_H__
+#define __SIT_TWR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sit_config.h"
+#include "sit_ts.h"
+
+#define SIT_TWR_MAX_RESPONDER CONFIG_SIT_TWR_MAX_RESPONDER
+
+/**
+ * Enum for the states of a single DS-TWR exchange
+*/
+typedef enum {
+    twr_state_idle,     ///< nothing in progress, sit_twr_start() sends the poll
+    twr_state_poll,     ///< poll sent, wait for the response
+    twr_state_resp,     ///< response received, the final is sent in the same step
+    twr_state_final,    ///< final sent, wait for the final response
+    twr_state_sent,     ///< final sent without final response (ds_3_twr), the responder calculates the distance
+    twr_state_report,   ///< distance calculated, ready for notification
+    twr_state_timeout,  ///< exchange failed
+} twr_state_t;
+
+typedef struct {
+    uint8_t responder_id;
+    twr_state_t state;
+    uint8_t sequence;
+    bool final_resp;        ///< false: ds_3_twr, the exchange ends with the final
+    uint32_t poll_tx_time;  ///< delayed TX time of the poll, 0 -> send immediately
+    sit_ts_t poll_tx_ts;
+    sit_ts_t resp_rx_ts;
+    sit_ts_t final_tx_ts;
+    sit_ts_t poll_rx_ts;
+    sit_ts_t resp_tx_ts;
+    sit_ts_t final_rx_ts;
+    uint32_t time_round_1;
+    uint32_t time_round_2;
+    uint32_t time_reply_1;
+    uint32_t time_reply_2;
+    int32_t distance_mm;
+    uint16_t failures;  ///< failed exchanges in a row
+    uint16_t backoff;   ///< rounds left until the responder is polled again
+    uint32_t ranges;    ///< successful exchanges
+} twr_ctx_t;
+
+/**
+ * A scheduler decides if a responder gets a slot in the current round
+ * and updates its context after the exchange.
+*/
+typedef struct {
+    const char *name;
+    bool (*ready)(twr_ctx_t *ctx);
+    void (*update)(twr_ctx_t *ctx);
+} twr_scheduler_t;
+
+extern const twr_scheduler_t twr_scheduler_round_robin;
+extern const twr_scheduler_t twr_scheduler_backoff;
+
+/***************************************************************************
+ * Reset the contexts for the responders 100 .. last_responder_id
+ *
+ * @param ctx               ->  array with at least SIT_TWR_MAX_RESPONDER entries
+ * @param last_responder_id ->  highest responder ID (device_settings.responder)
+ * @param final_resp        ->  true: wait for the final response (ds_4_twr),
+ *                              false: the exchange ends with the final (ds_3_twr)
+ *
+ * @return number of initialised contexts
+ *
+****************************************************************************/
+uint8_t sit_twr_init(twr_ctx_t *ctx, uint8_t last_responder_id, bool final_resp);
+
+/***************************************************************************
+ * Start an exchange with the responder, the poll is sent and the receiver
+ * waits for the response. The exchange goes on with sit_twr_step() for
+ * every RX event, the thread is free until then.
+ *
+ * @param ctx           ->  context of the responder
+ * @param sequence      ->  sequence number of the round
+ * @param poll_tx_time  ->  delayed TX time of the poll, 0 -> send immediately
+ *
+ * @return true if the poll was sent
+ *
+****************************************************************************/
+bool sit_twr_start(twr_ctx_t *ctx, uint8_t sequence, uint32_t poll_tx_time);
+
+/***************************************************************************
+ * Handle an RX event of the exchange and go to the next state. The final
+ * is sent in the same step as the response is taken.
+ *
+ * @param ctx       ->  context of the responder
+ * @param status    ->  SYS_STATUS low register of the event (sit_msg_receive())
+ *
+ * @return true if the exchange is finished (report or timeout)
+ *
+****************************************************************************/
+bool sit_twr_step(twr_ctx_t *ctx, uint32_t status);
+
+/***************************************************************************
+ * Check if the exchange is finished
+ *
+ * @param ctx   ->  context of the responder
+ *
+ * @return true in the states sent, report and timeout
+ *
+****************************************************************************/
+bool sit_twr_done(const twr_ctx_t *ctx);
+
+/***************************************************************************
+ * Run one complete exchange with the responder, waits for the RX events
+ * with sit_msg_receive().
+ *
+ * @param ctx           ->  context of the responder
+ * @param sequence      ->  sequence number of the round
+ * @param poll_tx_time  ->  delayed TX time of the poll, 0 -> send immediately
+ *
+ * @return true if a distance was calculated
+ *
+****************************************************************************/
+bool sit_twr_run(twr_ctx_t *ctx, uint8_t sequence, uint32_t poll_tx_time);
+
+/***************************************************************************
+ * Select the scheduler of the initiator, the default is set with
+ * CONFIG_SIT_TWR_SCHEDULER
+ *
+ * @param scheduler ->  twr_scheduler_round_robin or twr_scheduler_backoff
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_twr_set_scheduler(const twr_scheduler_t *scheduler);
+const twr_scheduler_t *sit_twr_get_scheduler(void);
+
+#endif // __SIT_TWR_H__
@@ -0,0 +1,91 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_tx_template.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief TWR frames pre-staged in the DW3000 TX buffer.
+ *
+ * The DS-TWR response, final and final response frames and the SS-TWR
+ * response have a fixed place at
+ * the start of the TX buffer. They are uploaded once with sit_tpl_init(),
+ * per exchange only the changed fields are written, so less SPI bytes
+ * are moved between RX and the delayed TX. All other frames are written
+ * behind the templates at SIT_TX_FRAME_OFFSET.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TX_TEMPLATE_H__
+#define __SIT_TX_TEMPLATE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* TX buffer offset of the frames without template, must stay <= 127 (direct SPI address) */
+#define SIT_TX_FRAME_OFFSET 96
+
+/* Byte range [from, to) of a frame struct, e.g. SIT_TPL_FIELDS(msg_simple_t, header.sequence, crc) */
+#define SIT_TPL_FIELDS(type, first, end) offsetof(type, first), offsetof(type, end)
+
+typedef enum {
+    sit_tpl_twr_resp,       ///< msg_simple_t ds_twr_2_resp
+    sit_tpl_twr_final,      ///< msg_ds_twr_final_t ds_twr_3_final
+    sit_tpl_twr_final_resp, ///< msg_ds_twr_resp_t ds_twr_4_final
+    sit_tpl_ss_twr_resp,    ///< msg_ss_twr_final_t ss_twr_2_resp
+    sit_tpl_count,
+} sit_tpl_id_t;
+
+/***************************************************************************
+ * Upload all templates, has to be called after dwt_initialise()
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_tpl_init(void);
+
+/***************************************************************************
+ * Write a part of a frame into its template
+ *
+ * @param tpl   ->  template
+ * @param frame ->  frame of the template type, only [from, to) is used
+ * @param from  ->  first byte of the frame to write
+ * @param to    ->  first byte not written
+ *
+ * @return None
+ *
+****************************************************************************/
+void sit_tpl_update(sit_tpl_id_t tpl, const void *frame, uint16_t from, uint16_t to);
+
+/***************************************************************************
+ * Send a template at a delayed TX time, see sit_send_at()
+ *
+ * @param tpl       ->  template
+ * @param tx_time   ->  delayed TX time
+ * @param response  ->  enable the receiver after the TX
+ *
+ * @return true if the frame is sent at tx_time
+ *
+****************************************************************************/
+bool sit_tpl_send_at(sit_tpl_id_t tpl, uint32_t tx_time, bool response);
+
+#endif // __SIT_TX_TEMPLATE_H__
@@ -0,0 +1,123 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file ble_batch.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Batched binary result notifications.
+ *
+ * Results are packed as binary records behind a batch header and sent in
+ * one notification when the next record does not fit into the ATT MTU of
+ * the connection or CONFIG_SIT_BLE_BATCH_DEADLINE_MS after the first
+ * record of the batch. The records are queued with ble_sender_put(), the
+ * functions below are only called by the BLE sender thread.
+ *
+ * Notification: ble_batch_header_t, then count records. Every record
+ * starts with its type byte. The first byte of a batch is the format
+ * version, the JSON like structs of ble_sit_notify() start with a
+ * printable type string instead.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __BLE_BATCH_H__
+#define __BLE_BATCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <zephyr/toolchain.h>
+
+#define BLE_BATCH_VERSION 1
+
+typedef enum {
+    ble_record_distance = 1,
+    ble_record_position = 2,
+} ble_record_type_t;
+
+typedef struct __packed {
+    uint8_t version;    ///< BLE_BATCH_VERSION
+    uint8_t count;      ///< records in this notification
+    uint16_t batch;     ///< batch counter, a gap means lost notifications
+} ble_batch_header_t;
+
+typedef struct __packed {
+    uint8_t type;           ///< ble_record_distance
+    uint8_t responder;
+    uint16_t sequence;      ///< low 16 bit of the measurement sequence
+    int32_t distance_mm;
+    uint32_t time_round_1;  ///< in dtu
+    uint32_t time_round_2;
+    uint32_t time_reply_1;
+    uint32_t time_reply_2;
+    int16_t rssi_cdb;       ///< received power in 0.1 dBm
+    int16_t fpi_cdb;        ///< first path power in 0.1 dBm
+    uint8_t nlos;           ///< NLOS percentage
+} ble_record_distance_t;
+
+typedef struct __packed {
+    uint8_t type;           ///< ble_record_position
+    uint8_t anchors;
+    uint16_t sequence;
+    int32_t x_mm;
+    int32_t y_mm;
+    int32_t z_mm;
+    uint16_t residual_mm;
+    uint8_t iterations;
+} ble_record_position_t;
+
+/***************************************************************************
+ * Append a record to the current batch. A full batch is sent first.
+ *
+ * @param record    ->  packed record, starts with its type
+ * @param len       ->  size of the record
+ *
+ * @return 0 on success, -ENOTCONN without connection,
+ *         -EMSGSIZE if the MTU is too small for the record
+ *
+****************************************************************************/
+int ble_batch_add(const void *record, uint16_t len);
+
+/***************************************************************************
+ * Uptime at which the current batch has to be sent
+ *
+ * @return uptime in ms, 0 if the batch is empty
+ *
+****************************************************************************/
+int64_t ble_batch_deadline(void);
+
+/***************************************************************************
+ * Send the current batch now
+ *
+ * @return None
+ *
+****************************************************************************/
+void ble_batch_flush(void);
+
+/***************************************************************************
+ * Drop the current batch, e.g. after a disconnect
+ *
+ * @return None
+ *
+****************************************************************************/
+void ble_batch_reset(void);
+
+#endif // __BLE_BATCH_H__
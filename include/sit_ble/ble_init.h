@@ -60,6 +60,11 @@ uint8_t sit_ble_init(void);
 bool is_connected(void);
 void ble_sit_notify(json_distance_msg_all_t* json_data, size_t data_len);
 void ble_sit_td_notify(json_simple_td_msg_t* json_data, size_t data_len);
+void ble_sit_tdoa_notify(json_tdoa_msg_t* json_data, size_t data_len);
+void ble_sit_position_notify(json_position_msg_t* json_data, size_t data_len);
+int ble_sit_notify_raw(const void* data, uint16_t len);
+/* Largest notification payload of the connection, 0 without connection */
+uint16_t ble_notify_max_len(void);
 int ble_get_command(void);
 void bas_notify(void);
 
@@ -0,0 +1,88 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file ble_sender.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief BLE sender thread behind a lock-free result queue.
+ *
+ * The ranging thread puts fixed size messages into a single producer,
+ * single consumer ring and goes on with the next UWB exchange. The sender
+ * thread drains the ring and calls bt_gatt_notify(), so a stall of the
+ * BLE stack (no TX buffer, radio busy with a connection event) never
+ * delays the ranging. A full ring drops the new message.
+ *
+ * Only one thread may call ble_sender_put().
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __BLE_SENDER_H__
+#define __BLE_SENDER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Largest message, the biggest legacy notification struct */
+#define BLE_SENDER_MAX_LEN 88
+
+typedef enum {
+    ble_msg_notify,     ///< notification as it is
+    ble_msg_record,     ///< batch record, see ble_batch.h
+} ble_msg_kind_t;
+
+typedef struct {
+    uint32_t queued;            ///< messages put into the ring
+    uint32_t sent;              ///< notifications sent
+    uint32_t dropped;           ///< messages lost: ring full, no connection or no buffer
+    uint32_t retries;           ///< notify retries after -ENOMEM
+    uint32_t high_watermark;    ///< most messages in the ring
+} ble_sender_stats_t;
+
+/***************************************************************************
+ * Queue a message for the sender thread, never blocks
+ *
+ * @param kind  ->  ble_msg_kind_t
+ * @param data  ->  notification or batch record
+ * @param len   ->  size of data, at most BLE_SENDER_MAX_LEN
+ *
+ * @return 0 on success, -ENOBUFS if the ring is full,
+ *         -EMSGSIZE if the message is too big
+ *
+****************************************************************************/
+int ble_sender_put(ble_msg_kind_t kind, const void *data, uint16_t len);
+
+/***************************************************************************
+ * Notify with retries while the BLE stack has no buffer, only called by
+ * the sender thread. After the retries ran out once, the next
+ * notifications get a single attempt until one of them is sent.
+ *
+ * @param data  ->  notification
+ * @param len   ->  size of the notification
+ *
+ * @return result of bt_gatt_notify()
+ *
+****************************************************************************/
+int ble_sender_notify(const void *data, uint16_t len);
+
+void ble_sender_get_stats(ble_sender_stats_t *stats);
+
+#endif // __BLE_SENDER_H__
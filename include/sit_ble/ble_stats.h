@@ -0,0 +1,88 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+/**
+ * @file ble_stats.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Wire format of the stats characteristic.
+ *
+ * The stats characteristic is read as one packed little endian struct.
+ * Every field has a fixed width and is sent in every build, counters of
+ * a disabled module stay 0. Fields are only appended, a client checks
+ * version and length before it reads a field.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __BLE_STATS_H__
+#define __BLE_STATS_H__
+
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+#define BLE_STATS_VERSION 2
+#define BLE_STATS_IRQ_BUCKETS 8
+
+typedef struct __packed {
+    uint8_t version;                ///< BLE_STATS_VERSION
+    uint8_t reserved;
+    uint16_t length;                ///< size of the struct in bytes
+    uint32_t uptime_ms;             ///< reference for the rates of the counters
+    /* double buffered listener and event queue (CONFIG_SIT_IRQ) */
+    uint32_t rx_frames;
+    uint32_t rx_dropped;
+    uint32_t rx_errors;
+    uint32_t rx_overruns;
+    uint32_t events;
+    uint32_t events_dropped;
+    /* reply delay, see sit_reply.h */
+    uint32_t reply_uus;
+    uint32_t reply_latency_uus;
+    uint32_t reply_samples;
+    uint32_t reply_late;
+    /* DW3000 SPI transfers */
+    uint32_t spi_reads;
+    uint32_t spi_writes;
+    /* RX timing register shadow, see sit_shadow.h */
+    uint32_t shadow_writes;
+    uint32_t shadow_elided;
+    /* frames of the ranging code */
+    uint32_t frames_delivered;
+    uint32_t frames_filtered;
+    /* DW3000 IRQ latency (CONFIG_DW3000_IRQ_LATENCY) */
+    uint32_t irqs;
+    uint32_t irq_max_us;
+    uint32_t irq_hist[BLE_STATS_IRQ_BUCKETS];
+    /* range filter, see sit_range_filter.h */
+    uint32_t filter_accepted;
+    uint32_t filter_rejected;
+    uint32_t filter_resets;
+    /* BLE sender (CONFIG_SIT_BLE_SENDER) */
+    uint32_t sender_queued;
+    uint32_t sender_sent;
+    uint32_t sender_dropped;
+    uint32_t sender_retries;
+    uint32_t sender_high_watermark;
+    /* event wait of the ranging code (CONFIG_SIT_IRQ), since version 2 */
+    uint32_t event_timeouts;
+    uint32_t events_lost;
+} ble_stats_t;
+
+#endif // __BLE_STATS_H__
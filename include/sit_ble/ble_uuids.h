@@ -24,6 +24,7 @@
 #define SIT_UUID_INT_COMMAND        0x02,0x00,0x00,0x00
 #define SIT_UUID_JSON_COMMAND       0x03,0x00,0x00,0x00
 #define SIT_UUID_JSON_SETUP         0x04,0x00,0x00,0x00
+#define SIT_UUID_STATS              0x05,0x00,0x00,0x00
 
 /**
  *  SIT Service UUID: 6ba1de6b-3ab6-4d77-9ea1-cb6422720000
@@ -58,4 +59,9 @@
 #define BT_UUID_SIT_JSON_SETUP  \
     BT_UUID_DECLARE_128(BT_UUID_SIT_JSON_SETUP_VAL)
 
+#define BT_UUID_SIT_STATS_VAL \
+	BT_UUID_128_ENCODE(0x6ba1de6b, 0x3ab6, 0x4d77, 0x9ea1, 0xcb6422720005)
+#define BT_UUID_SIT_STATS  \
+    BT_UUID_DECLARE_128(BT_UUID_SIT_STATS_VAL)
+
 #endif  // __BLE_UUIDS_H__
\ No newline at end of file
@@ -16,6 +16,10 @@ extern "C"
 #include <zephyr/data/json.h>
 
 #include "sit_json_config.h"
+
+/* Anchor coordinates of the setup message, [x, y, z] in m */
+#define SIT_JSON_MAX_ANCHORS 8
+
 typedef struct {
     char type[16];
     char command[6];
@@ -33,6 +37,11 @@ typedef struct {
     char device_type[10];
     uint16_t rx_ant_dly;
     uint16_t tx_ant_dly;
+    uint8_t tdma_slot;
+    uint8_t tdma_slots;
+    char profile[12];
+    float anchors[SIT_JSON_MAX_ANCHORS][3];
+    uint8_t anchor_count;
 } json_setup_msg_t;
 
 #ifdef __cplusplus
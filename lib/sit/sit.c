@@ -37,16 +37,37 @@
 #include "sit/sit_device.h"
 #include "sit/sit_distance.h"
 #include "sit/sit_utils.h"
+#include "sit/sit_twr.h"
+#include "sit/sit_tdma.h"
+#include "sit/sit_ds_all.h"
+#include "sit/sit_tdoa.h"
+#include "sit/sit_clock.h"
+#include "sit/sit_frame.h"
+#include "sit/sit_position.h"
+#include "sit/sit_profile.h"
+#include "sit/sit_range_filter.h"
+#include "sit/sit_reply.h"
+#include "sit/sit_shadow.h"
+#include "sit/sit_tof.h"
+#include "sit/sit_ts.h"
+#include "sit/sit_tx_template.h"
+#ifdef CONFIG_SIT_IRQ
+	#include "sit/sit_event.h"
+#endif
 #include <sit_led/sit_led.h>
 
 #include <sit_ble/ble_init.h>
+#include <sit_ble/ble_batch.h>
+#include <sit_ble/ble_sender.h>
 #include <sit_ble/ble_device.h>
 
 
 #include <deca_probe_interface.h>
 #include <deca_device_api.h>
 #include <port.h>
+#include <dw3000_hw.h>
 
+#include <zephyr/random/random.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(SIT_Module, LOG_LEVEL_INF);
 
@@ -97,6 +118,22 @@ void reset_sequence() {
 void send_twr_notify(uint8_t responder) {
 	if (distance >= 0.0) {
 		LOG_INF("Responder: %d", responder);
+#ifdef CONFIG_SIT_BLE_BATCH
+		ble_record_distance_t record = {
+			.type = ble_record_distance,
+			.responder = responder,
+			.sequence = (uint16_t)sequence,
+			.distance_mm = (int32_t)(distance * 1000),
+			.time_round_1 = (uint32_t)time_round_1,
+			.time_round_2 = (uint32_t)time_round_2,
+			.time_reply_1 = (uint32_t)time_reply_1,
+			.time_reply_2 = (uint32_t)time_reply_2,
+			.rssi_cdb = (int16_t)(diagnostic.rssi * 10),
+			.fpi_cdb = (int16_t)(diagnostic.fpi * 10),
+			.nlos = diagnostic.nlos,
+		};
+		ble_sender_put(ble_msg_record, &record, sizeof(record));
+#else
 		json_distance_msg_all_t distance_notify = {
 			.header = {
 				.type = "distance_msg",
@@ -120,6 +157,7 @@ void send_twr_notify(uint8_t responder) {
 			}
 		};
 		ble_sit_notify(&distance_notify, sizeof(distance_notify));
+#endif
 		measurements++;
 		LOG_INF("Test Measurement: %d von %d", measurements, device_settings.max_measurement);
 		if(device_settings.max_measurement != 0 && device_settings.max_measurement <= measurements) {
@@ -161,45 +199,131 @@ void send_two_device_notify() {
 	}
 }
 
+void send_position_notify(const sit_position_t *position) {
+#ifdef CONFIG_SIT_BLE_BATCH
+	ble_record_position_t record = {
+		.type = ble_record_position,
+		.anchors = position->anchors,
+		.sequence = (uint16_t)sequence,
+		.x_mm = (int32_t)(position->x * 1000),
+		.y_mm = (int32_t)(position->y * 1000),
+		.z_mm = (int32_t)(position->z * 1000),
+		.residual_mm = (uint16_t)MIN(position->residual * 1000, UINT16_MAX),
+		.iterations = position->iterations,
+	};
+	ble_sender_put(ble_msg_record, &record, sizeof(record));
+#else
+	json_position_msg_t position_notify = {
+		.header = {
+			.type = "position_msg",
+			.sequence = sequence,
+			.measurements = measurements,
+		},
+		.data = {
+			.x = position->x,
+			.y = position->y,
+			.z = position->z,
+			.residual = position->residual,
+			.anchors = position->anchors,
+			.iterations = position->iterations,
+		},
+	};
+	ble_sit_position_notify(&position_notify, sizeof(position_notify));
+#endif
+	measurements++;
+	if(device_settings.max_measurement != 0 && device_settings.max_measurement <= measurements) {
+		device_settings.state = sleep;
+	}
+}
+
+/***************************************************************************
+ * Filter a range and hand it to the position solver if anchors are set,
+ * otherwise notify the filtered distance
+ *
+ * @param responder_id  ->  device ID of the responder
+ * @param distance_mm   ->  raw range to the responder
+ *
+****************************************************************************/
+static void sit_range_report(uint8_t responder_id, int32_t distance_mm) {
+	int32_t filtered_mm;
+	if (!sit_range_filter_update(responder_id, distance_mm, &diagnostic, &filtered_mm)) {
+		LOG_INF("Responder %d: range %d mm rejected", responder_id, distance_mm);
+		return;
+	}
+	if (sit_position_enabled()) {
+		sit_position_add_range(responder_id - 100, filtered_mm);
+	} else if (sit_range_filter_decimate(responder_id)) {
+		distance = filtered_mm / 1000.0;
+		send_twr_notify(responder_id);
+	}
+}
+
+/***************************************************************************
+ * Solve and notify the position at the end of a round, one notification
+ * instead of one per responder
+ *
+****************************************************************************/
+static void sit_position_report() {
+	sit_position_t position;
+	if (sit_position_enabled() && sit_position_solve(&position)) {
+		LOG_INF("Position: %d %d %d mm", (int)(position.x * 1000), (int)(position.y * 1000), (int)(position.z * 1000));
+		send_position_notify(&position);
+	}
+}
+
 void sit_sstwr_initiator() {
+	sit_range_filter_reset();
 	while(device_settings.state == measurement) {
-		sit_set_rx_after_tx_delay(DS_RESP_TX_TO_FINAL_RX_DLY_UUS);
-		sit_set_rx_timeout(DS_FINAL_RX_TIMEOUT+2000);
-		sit_set_preamble_detection_timeout(DS_PRE_TIMEOUT+200);
-		for(uint8_t responder_id=100; responder_id<=device_settings.responder; responder_id++) {
-			msg_simple_t twr_poll = {{twr_1_poll, (uint8_t)sequence, device_settings.deviceID, responder_id}, 0};
+		int64_t round_start = k_uptime_get();
+		uint8_t slots = 0;
+		sit_set_rx_after_tx_delay(sit_reply_rx_after_tx_uus());
+		sit_set_rx_timeout(sit_reply_rx_timeout_uus());
+		sit_set_preamble_detection_timeout(sit_reply_preamble_timeout_pac());
+		for(uint8_t responder_id=100; responder_id<=device_settings.responder && device_settings.state == measurement; responder_id++) {
+			slots++;
+			msg_simple_t twr_poll = {SIT_HEADER(twr_1_poll, (uint8_t)sequence, device_settings.deviceID, responder_id), 0};
 			sit_start_poll((uint8_t*) &twr_poll, (uint16_t)sizeof(twr_poll));
 
 			msg_ss_twr_final_t rx_final_msg;
 			msg_id_t msg_id = ss_twr_2_resp;
-			if(sit_check_final_msg_id(msg_id, &rx_final_msg)) {
-				uint64_t poll_tx_ts = get_tx_timestamp_u64();
-				uint64_t resp_rx_ts = get_rx_timestamp_u64();
-
-				uint64_t poll_rx_ts = rx_final_msg.poll_rx_ts;
-				uint64_t resp_tx_ts = rx_final_msg.resp_tx_ts;
-
-				double clockOffsetRatio = dwt_readcarrierintegrator() *
-						(FREQ_OFFSET_MULTIPLIER * HERTZ_TO_PPM_MULTIPLIER_CHAN_9 / 1.0e6) ;
-
-				time_round_1 = (double)(resp_rx_ts - poll_tx_ts);
-				time_reply_1 = (double)(resp_tx_ts - poll_rx_ts);
-
-				double tof =  ((time_round_1 - time_reply_1 *
-						(1 - clockOffsetRatio)) / 2.0) * DWT_TIME_UNITS;
-
-				distance = tof * SPEED_OF_LIGHT;
-
-				LOG_INF("TX Power: 0x%08x", (int32_t) 0xfe);
-				LOG_INF("initiator -> responder Distance: %3.2lf \n", distance);
-				send_twr_notify(responder_id);
+			if(sit_check_final_msg_id(msg_id, &rx_final_msg) &&
+			   rx_final_msg.header.dest == device_settings.deviceID &&
+			   rx_final_msg.header.source == responder_id) {
+				uint64_t poll_tx_ts = sit_tx_timestamp();
+				uint64_t resp_rx_ts = sit_rx_timestamp();
+
+				sit_ts_t poll_rx_ts = sit_ts_unpack(&rx_final_msg.poll_rx_ts);
+				sit_ts_t resp_tx_ts = sit_ts_unpack(&rx_final_msg.resp_tx_ts);
+
+				int32_t ci = dwt_readcarrierintegrator();
+
+				uint32_t round = (uint32_t)sit_ts_diff(resp_rx_ts, poll_tx_ts);
+				uint32_t reply = (uint32_t)sit_ts_diff(resp_tx_ts, poll_rx_ts);
+				int32_t distance_mm = sit_tof_to_mm(sit_tof_ss_q8(round, reply, sit_tof_ci_to_skew_q40(ci)));
+				/* clock model of the responder, the double math is off the RX path */
+				sit_clock_update_ci(responder_id, ci);
+
+				time_round_1 = round;
+				time_reply_1 = reply;
+				time_round_2 = 0;
+				time_reply_2 = 0;
+				distance = distance_mm / 1000.0;
+
+				LOG_INF("initiator -> responder Distance: %d mm", distance_mm);
+				sit_range_report(responder_id, distance_mm);
 			} else {
-				LOG_WRN("Something is wrong");
+				LOG_WRN("Responder %d: no response", responder_id);
 				dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
 			}
 		}
+		sit_position_report();
 		sequence++;
-		k_msleep(100);
+		/* same slot pacing as DS-TWR, an exchange only takes 2 frames */
+		int64_t round_end = round_start + MAX(slots, 1) * CONFIG_SIT_TWR_SLOT_PERIOD_MS;
+		int64_t remaining = round_end - k_uptime_get();
+		if (remaining > 0) {
+			k_msleep((int32_t)remaining);
+		}
 	}
 }
 
@@ -208,165 +332,471 @@ void sit_sstwr_responder() {
 		sit_receive_now(0,0);
 		msg_simple_t rx_poll_msg;
 		msg_id_t msg_id = twr_1_poll;
-		if(sit_check_msg_id(msg_id, &rx_poll_msg)){
-			uint64_t poll_rx_ts = get_rx_timestamp_u64();
-
-			uint32_t resp_tx_time = (poll_rx_ts + (1800 * UUS_TO_DWT_TIME)) >> 8;
-
-			uint16_t tx_dly = get_tx_ant_dly();
-			LOG_INF("TX Antenna Delay: %d", tx_dly);
-			uint32_t resp_tx_ts = (((uint64_t)(resp_tx_time & 0xFFFFFFFEUL)) << 8) + tx_dly;
-
-			msg_ss_twr_final_t msg_ss_twr_final_t = {{
-					ss_twr_2_resp,
-					(uint8_t)(rx_poll_msg.header.sequence),
-					device_settings.deviceID,
-					rx_poll_msg.header.source},
-					(uint32_t)poll_rx_ts,
-					resp_tx_ts,
+		if(sit_check_msg_id(msg_id, &rx_poll_msg) && rx_poll_msg.header.dest == device_settings.deviceID){
+			uint64_t poll_rx_ts = sit_rx_timestamp();
+
+			uint32_t resp_tx_time = sit_reply_tx_time(poll_rx_ts);
+
+			msg_ss_twr_final_t ss_resp_msg = {SIT_HEADER(ss_twr_2_resp, (uint8_t)(rx_poll_msg.header.sequence), device_settings.deviceID, rx_poll_msg.header.source),
+					{{0}},
+					{{0}},
 					0
 				};
-			sit_send_at((uint8_t*)&msg_ss_twr_final_t, sizeof(msg_ss_twr_final_t), resp_tx_time);
-
+			sit_ts_pack(&ss_resp_msg.poll_rx_ts, poll_rx_ts);
+			sit_ts_pack(&ss_resp_msg.resp_tx_ts, sit_ts_from_tx_time(resp_tx_time));
+			/* only header and timestamps go over SPI between poll RX and the response */
+			sit_tpl_update(sit_tpl_ss_twr_resp, &ss_resp_msg, SIT_TPL_FIELDS(msg_ss_twr_final_t, header.sequence, crc));
+			if (!sit_tpl_send_at(sit_tpl_ss_twr_resp, resp_tx_time, false)) {
+				LOG_WRN("Response sent too late");
+			}
 		} else {
 			LOG_WRN("Something is wrong");
 			dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
 		}
-		k_msleep(90);
 	}
 }
 
-void sit_dstwr_initiator() {
-	while(device_settings.state == measurement) {
-		for(uint8_t responder_id=100; responder_id<=device_settings.responder; responder_id++) {
-			sit_set_rx_after_tx_delay(DS_POLL_TX_TO_RESP_RX_DLY_UUS);
-			sit_set_rx_timeout(DS_RESP_RX_TIMEOUT_UUS+2000);
-			sit_set_preamble_detection_timeout(DS_PRE_TIMEOUT+200);
+static void sit_twr_report(twr_ctx_t *ctx) {
+	time_round_1 = ctx->time_round_1;
+	time_round_2 = ctx->time_round_2;
+	time_reply_1 = ctx->time_reply_1;
+	time_reply_2 = ctx->time_reply_2;
+	distance = ctx->distance_mm / 1000.0;
+	LOG_INF("Distance: %d mm", ctx->distance_mm);
 
-			msg_simple_t twr_poll = {{twr_1_poll, sequence, device_settings.deviceID , responder_id},0};
-			sit_start_poll((uint8_t*) &twr_poll, (uint16_t)sizeof(twr_poll));
+	sit_range_report(ctx->responder_id, ctx->distance_mm);
+}
 
-			msg_simple_t rx_resp_msg;
-			msg_id_t msg_id = ds_twr_2_resp;
+static void sit_dstwr_initiator_tdma(twr_ctx_t *twr_ctx, uint8_t responder_count) {
+	LOG_INF("TDMA: %d slots, %d ranges/s in the field",
+		device_settings.tdma_slots,
+		sit_tdma_ranges_per_second(device_settings.tdma_slots, responder_count));
+	while(device_settings.state == measurement) {
+		msg_tdma_beacon_t beacon;
+		uint64_t beacon_rx_ts;
+		if (!sit_tdma_wait_beacon(&beacon, &beacon_rx_ts)) {
+			continue;
+		}
+		if (device_settings.tdma_slot >= beacon.slots) {
+			LOG_ERR("TDMA slot %d not in superframe (%d slots)", device_settings.tdma_slot, beacon.slots);
+			continue;
+		}
+		uint8_t exchanges = MIN(responder_count, beacon.responders);
+		for(uint8_t i = 0; i < exchanges && device_settings.state == measurement; i++) {
+			uint32_t poll_tx_time = sit_tdma_poll_tx_time(beacon_rx_ts, &beacon, device_settings.tdma_slot, i);
+			if (sit_twr_run(&twr_ctx[i], beacon.header.sequence, poll_tx_time)) {
+				sit_twr_report(&twr_ctx[i]);
+			}
+		}
+		sit_position_report();
+		sequence++;
+	}
+}
+
+void sit_dstwr_initiator() {
+	twr_ctx_t twr_ctx[SIT_TWR_MAX_RESPONDER];
+	const twr_scheduler_t *scheduler = sit_twr_get_scheduler();
+	uint8_t responder_count = sit_twr_init(twr_ctx, device_settings.responder,
+					       device_settings.measurement_type != ds_3_twr);
+	sit_range_filter_reset();
+
+	if (device_settings.tdma_slots > 0) {
+		sit_dstwr_initiator_tdma(twr_ctx, responder_count);
+		return;
+	}
 
-			if(sit_check_msg_id(msg_id, &rx_resp_msg)) {
-				uint64_t poll_tx_ts = get_tx_timestamp_u64();
-				uint64_t resp_rx_ts = get_rx_timestamp_u64();
+	while(device_settings.state == measurement) {
+		int64_t round_start = k_uptime_get();
+		uint8_t slots = 0;
+		for(uint8_t i = 0; i < responder_count && device_settings.state == measurement; i++) {
+			twr_ctx_t *ctx = &twr_ctx[i];
+			if (!scheduler->ready(ctx)) {
+				continue;
+			}
+			slots++;
+			if (sit_twr_run(ctx, (uint8_t)sequence, 0)) {
+				sit_twr_report(ctx);
+			}
+			scheduler->update(ctx);
+		}
+		sit_position_report();
+		sequence++;
+		/* The round takes one slot per polled responder, not a fixed worst case time */
+		int64_t round_end = round_start + MAX(slots, 1) * CONFIG_SIT_TWR_SLOT_PERIOD_MS;
+		int64_t remaining = round_end - k_uptime_get();
+		if (remaining > 0) {
+			k_msleep((int32_t)remaining);
+		}
+	}
+}
 
-				uint32_t final_tx_time = (resp_rx_ts + (1800 * UUS_TO_DWT_TIME)) >> 8;
-				uint64_t final_tx_ts = (((uint64_t)(final_tx_time & 0xFFFFFFFEUL)) << 8) + get_tx_ant_dly();
+/***************************************************************************
+ * Calculate and notify the distance at the end of a ds_3_twr exchange, the
+ * final carries the timestamps of the initiator
+ *
+ * @param final_msg     ->  received final of the initiator
+ * @param poll_rx_ts    ->  RX time of the poll
+ * @param resp_tx_ts    ->  TX time of the response
+ * @param final_rx_ts   ->  RX time of the final
+ *
+****************************************************************************/
+static void sit_dstwr_final_report(const msg_ds_twr_final_t *final_msg, uint64_t poll_rx_ts,
+				   uint64_t resp_tx_ts, uint64_t final_rx_ts) {
+	uint64_t poll_tx_ts = sit_ts_unpack(&final_msg->poll_tx_ts);
+	uint64_t resp_rx_ts = sit_ts_unpack(&final_msg->resp_rx_ts);
+	uint64_t final_tx_ts = sit_ts_unpack(&final_msg->final_tx_ts);
+
+	uint32_t round_1 = (uint32_t)sit_ts_diff(resp_rx_ts, poll_tx_ts);
+	uint32_t round_2 = (uint32_t)sit_ts_diff(final_rx_ts, resp_tx_ts);
+	uint32_t reply_1 = (uint32_t)sit_ts_diff(resp_tx_ts, poll_rx_ts);
+	uint32_t reply_2 = (uint32_t)sit_ts_diff(final_tx_ts, resp_rx_ts);
+	int32_t distance_mm = sit_tof_to_mm(sit_tof_ds_q8(round_1, reply_1, round_2, reply_2));
+
+	time_round_1 = round_1;
+	time_round_2 = round_2;
+	time_reply_1 = reply_1;
+	time_reply_2 = reply_2;
+	distance = distance_mm / 1000.0;
+	LOG_INF("Distance %d -> %d: %d mm", device_settings.deviceID, final_msg->header.source, distance_mm);
+	send_twr_notify(final_msg->header.source);
+}
 
-				msg_ds_twr_final_t final_msg = {{
-					ds_twr_3_final,
-					rx_resp_msg.header.sequence,
-					rx_resp_msg.header.dest,
-					rx_resp_msg.header.source},
-					(uint32_t)poll_tx_ts,
-					(uint32_t)resp_rx_ts,
-					(uint32_t)final_tx_ts,
-					0
-				};
+/***************************************************************************
+ * Answer one DS-TWR exchange. ds_4_twr answers the final with the final
+ * response, in ds_3_twr the responder calculates the distance from the
+ * final.
+ *
+ * @param rx_timeout -> timeout for the poll in UWB microseconds, 0 -> wait
+ *
+ * @return true if the exchange is complete
+ *
+****************************************************************************/
+static bool sit_dstwr_respond(uint32_t rx_timeout) {
+	bool final_resp = device_settings.measurement_type != ds_3_twr;
+	sit_receive_now(0, rx_timeout);
+	msg_simple_t rx_poll_msg;
+	msg_id_t msg_id = twr_1_poll;
+	if(sit_check_msg_id(msg_id, &rx_poll_msg) && rx_poll_msg.header.dest == device_settings.deviceID){
+		uint64_t poll_rx_ts = sit_rx_timestamp();
+
+		uint32_t resp_tx_time = sit_reply_tx_time(poll_rx_ts);
+
+		msg_simple_t msg_ds_poll_resp = {SIT_HEADER(ds_twr_2_resp, rx_poll_msg.header.sequence, rx_poll_msg.header.dest, rx_poll_msg.header.source),0};
+		sit_set_rx_after_tx_delay(sit_reply_rx_after_tx_uus());
+		sit_set_rx_timeout(sit_reply_rx_timeout_uus());
+		sit_set_preamble_detection_timeout(sit_reply_preamble_timeout_pac());
+		sit_tpl_update(sit_tpl_twr_resp, &msg_ds_poll_resp, SIT_TPL_FIELDS(msg_simple_t, header.sequence, crc));
+		bool ret = sit_tpl_send_at(sit_tpl_twr_resp, resp_tx_time, true);
+		if (ret == false) {
+			LOG_WRN("Something is wrong with Sending Poll Resp Msg");
+			return false;
+		}
+		/* Everything but the final RX time is known now, stage it while the final is on the way */
+		uint64_t resp_tx_ts = sit_ts_from_tx_time(resp_tx_time);
+		msg_ds_twr_resp_t final_resp_msg = {SIT_HEADER(ds_twr_4_final, rx_poll_msg.header.sequence, rx_poll_msg.header.dest, rx_poll_msg.header.source),
+			{{0}},
+			{{0}},
+			{{0}},
+			0
+		};
+		if (final_resp) {
+			sit_ts_pack(&final_resp_msg.poll_rx_ts, poll_rx_ts);
+			sit_ts_pack(&final_resp_msg.resp_tx_ts, resp_tx_ts);
+			sit_tpl_update(sit_tpl_twr_final_resp, &final_resp_msg, SIT_TPL_FIELDS(msg_ds_twr_resp_t, header.sequence, final_rx_ts));
+		}
 
-				bool ret = sit_send_at_with_response((uint8_t*)&final_msg, sizeof(msg_ds_twr_final_t),final_tx_time);
+		msg_ds_twr_final_t rx_ds_final_msg;
+		msg_id = ds_twr_3_final;
+		if(sit_check_ds_final_msg_id(msg_id, &rx_ds_final_msg) && rx_ds_final_msg.header.dest == device_settings.deviceID){
+			uint64_t final_rx_ts = sit_rx_timestamp();
 
-				if (ret == false) {
-					LOG_WRN("Something is wrong with Sending Final Msg");
-					continue;
+			if (!final_resp) {
+				if (rx_ds_final_msg.header.source != rx_poll_msg.header.source) {
+					LOG_WRN("Final of %d does not belong to the poll of %d",
+						rx_ds_final_msg.header.source, rx_poll_msg.header.source);
+					return false;
 				}
+				sit_dstwr_final_report(&rx_ds_final_msg, poll_rx_ts, resp_tx_ts, final_rx_ts);
+				return true;
+			}
 
-				msg_ds_twr_resp_t rx_ds_resp_msg;
-				msg_id = ds_twr_4_final;
-				if(sit_check_ds_resp_msg_id(msg_id, &rx_ds_resp_msg) && rx_ds_resp_msg.header.dest == device_settings.deviceID){
-					uint32_t poll_rx_ts_32 = rx_ds_resp_msg.poll_rx_ts;
-					uint32_t resp_tx_ts_32 = rx_ds_resp_msg.resp_tx_ts;
-					uint32_t final_rx_ts_32 = rx_ds_resp_msg.final_rx_ts;
-
-					int64_t tof_dtu;
-					time_round_1 = (double)((uint32_t)resp_rx_ts - (uint32_t)poll_tx_ts);
-					time_round_2 = (double)(final_rx_ts_32 - resp_tx_ts_32);
-					time_reply_1 = (double)(resp_tx_ts_32 - poll_rx_ts_32);
-					time_reply_2 = (double)((uint32_t)final_tx_ts - (uint32_t)resp_rx_ts);
-					tof_dtu = (int64_t)((time_round_1 * time_round_2 - time_reply_1 * time_reply_2)
-										/ (time_round_1 + time_round_2 + time_reply_1 + time_reply_2)
-									);
-
-					double tof = (double)tof_dtu * DWT_TIME_UNITS;
-					distance = tof * SPEED_OF_LIGHT;
-					LOG_INF("Distance: %lf", distance);
-
-					send_twr_notify(device_settings.deviceID);
-				} else {
-					LOG_WRN("Something is wrong with Final Msg Receive");
-					dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
-				}
-			} else {
-				LOG_WRN("Something is wrong with Receiving Msg");
-				dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+			if (rx_ds_final_msg.header.sequence != final_resp_msg.header.sequence ||
+				rx_ds_final_msg.header.source != final_resp_msg.header.dest) {
+				final_resp_msg.header.sequence = rx_ds_final_msg.header.sequence;
+				final_resp_msg.header.dest = rx_ds_final_msg.header.source;
+				sit_tpl_update(sit_tpl_twr_final_resp, &final_resp_msg, SIT_TPL_FIELDS(msg_ds_twr_resp_t, header.sequence, poll_rx_ts));
+			}
+			sit_ts_pack(&final_resp_msg.final_rx_ts, final_rx_ts);
+			sit_tpl_update(sit_tpl_twr_final_resp, &final_resp_msg, SIT_TPL_FIELDS(msg_ds_twr_resp_t, final_rx_ts, crc));
+
+			ret = sit_tpl_send_at(sit_tpl_twr_final_resp, sit_reply_tx_time(final_rx_ts), false);
+
+			if (ret == false) {
+				LOG_WRN("Something is wrong with Sending Final Resp Msg");
+				return false;
 			}
+			return true;
+		} else {
+			LOG_WRN("Something is wrong with Final Msg Receive");
+			dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+		}
+	} else {
+		LOG_WRN("Something is wrong with Poll Msg Receive");
+		dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+	}
+	return false;
+}
+
+static void sit_dstwr_responder_tdma_beacon() {
+	uint8_t responders = sit_tdma_responders(device_settings.responder >= 100 ? device_settings.responder - 99 : 1);
+	uint32_t superframe_ms = (sit_tdma_superframe_uus(device_settings.tdma_slots, responders) * 5120 / 4992 + 999) / 1000;
+	uint16_t slot_uus = sit_tdma_slot_uus(responders);
+	LOG_INF("TDMA beacon: %d slots, superframe %d ms", device_settings.tdma_slots, superframe_ms);
+	while(device_settings.state == measurement) {
+		int64_t superframe_end = k_uptime_get() + superframe_ms;
+		sit_tdma_send_beacon((uint8_t)sequence, device_settings.tdma_slots, responders);
+		while(k_uptime_get() < superframe_end && device_settings.state == measurement) {
+			sit_dstwr_respond(slot_uus);
 		}
 		sequence++;
-		k_msleep(100);
 	}
 }
 
 void sit_dstwr_responder() {
+	if (device_settings.tdma_slots > 0 && device_settings.deviceID == SIT_TDMA_BEACON_ID) {
+		sit_dstwr_responder_tdma_beacon();
+		return;
+	}
 	while(device_settings.state == measurement) {
-		sit_receive_now(0,0);
-		msg_simple_t rx_poll_msg;
-		msg_id_t msg_id = twr_1_poll;
-		if(sit_check_msg_id(msg_id, &rx_poll_msg) && rx_poll_msg.header.dest == device_settings.deviceID){
-			uint64_t poll_rx_ts = get_rx_timestamp_u64();
-
-			uint32_t resp_tx_time = (poll_rx_ts + (1800 * UUS_TO_DWT_TIME)) >> 8;
-
-			msg_simple_t msg_ds_poll_resp = {{
-					ds_twr_2_resp,
-					rx_poll_msg.header.sequence,
-					rx_poll_msg.header.dest,
-					rx_poll_msg.header.source,
-				},0};
-			sit_set_rx_after_tx_delay(DS_RESP_TX_TO_FINAL_RX_DLY_UUS);
-			sit_set_rx_timeout(DS_FINAL_RX_TIMEOUT+2000);
-			sit_set_preamble_detection_timeout(DS_PRE_TIMEOUT+200);
-			bool ret = sit_send_at_with_response((uint8_t*)&msg_ds_poll_resp, sizeof(msg_simple_t), resp_tx_time);
-			if (ret == false) {
-				continue;
-				LOG_WRN("Something is wrong with Sending Poll Resp Msg");
-			}
-			msg_ds_twr_final_t rx_ds_final_msg;
-			msg_id = ds_twr_3_final;
-			if(sit_check_ds_final_msg_id(msg_id, &rx_ds_final_msg) && rx_ds_final_msg.header.dest == device_settings.deviceID){
-				uint64_t resp_tx_ts = get_tx_timestamp_u64();
-				uint64_t final_rx_ts = get_rx_timestamp_u64();
-
-				msg_ds_twr_resp_t final_resp_msg = {{
-					ds_twr_4_final,
-					rx_ds_final_msg.header.sequence,
-					rx_ds_final_msg.header.dest,
-					rx_ds_final_msg.header.source},
-					(uint32_t)poll_rx_ts,
-					(uint32_t)resp_tx_ts,
-					(uint32_t)final_rx_ts,
-					0
-				};
+		sit_dstwr_respond(0);
+		sequence++;
+		/* no sleep here, with TDMA or short ranging slots the next poll follows within ms */
+		k_yield();
+	}
+}
 
-				ret = sit_send_at((uint8_t*)&final_resp_msg, sizeof(msg_ds_twr_resp_t),0);
+static uint8_t sit_ds_all_node_count() {
+	uint8_t responders = device_settings.responder >= 100 ? device_settings.responder - 99 : 1;
+	return MIN(responders, DS_ALL_MAX_RESPONDER) + 1;
+}
 
-				if (ret == false) {
-					LOG_WRN("Something is wrong with Sending Final Resp Msg");
-					continue;
+static bool sit_ds_all_send(ds_all_ctx_t *ctx, msg_id_t id, uint8_t seq, uint32_t tx_time) {
+	sit_ts_t tx_ts = sit_ts_from_tx_time(tx_time);
+	msg_ds_all_twr_t msg = {SIT_HEADER(id, seq, device_settings.deviceID, SIT_BROADCAST_ID)};
+	sit_ds_all_fill(ctx, &msg, tx_ts);
+	if (!sit_send_at((uint8_t*)&msg, sizeof(msg_ds_all_twr_t), tx_time)) {
+		return false;
+	}
+	sit_ds_all_tx_done(ctx, tx_ts);
+	return true;
+}
+
+static bool sit_ds_all_receive(ds_all_ctx_t *ctx, msg_id_t id, uint64_t poll_ts, uint8_t slot, ds_all_result_t *result) {
+	/* open the receiver shortly before the slot, a missing node only costs its own slot */
+	uint32_t rx_on_uus = sit_ds_all_slot_uus(slot, ctx->nodes) - DS_ALL_RX_MARGIN_UUS - sit_profile_shr_uus();
+	dwt_setdelayedtrxtime(sit_ts_tx_time_after(poll_ts, rx_on_uus));
+	if (!sit_receive_at(DS_ALL_SLOT_UUS - DS_ALL_RX_MARGIN_UUS)) {
+		return false;
+	}
+	msg_ds_all_twr_t msg;
+	if (sit_check_ds_all_msg_id(id, &msg)) {
+		return sit_ds_all_rx(ctx, &msg, sit_rx_timestamp(), result);
+	}
+	dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+	return false;
+}
+
+static void sit_ds_all_report(ds_all_result_t *results, uint8_t count) {
+	for (uint8_t i = 0; i < count; i++) {
+		time_round_1 = results[i].time_round_1;
+		time_round_2 = results[i].time_round_2;
+		time_reply_1 = results[i].time_reply_1;
+		time_reply_2 = results[i].time_reply_2;
+		distance = results[i].distance_mm / 1000.0;
+		LOG_INF("Distance %d -> %d: %d mm", device_settings.deviceID, results[i].peer_id, results[i].distance_mm);
+		send_twr_notify(results[i].peer_id);
+	}
+}
+
+/***************************************************************************
+ * All to all DS-TWR initiator. Sends the poll, listens to the responses of
+ * all responders in their slots and sends the final, which carries the
+ * RX time of every response. The distances are reported after the round,
+ * a BLE notification inside the round would miss the next slot.
+ *
+****************************************************************************/
+void sit_dstwr_all_initiator() {
+	ds_all_ctx_t ctx;
+	ds_all_result_t results[DS_ALL_MAX_NODES + 1];
+	uint8_t nodes = sit_ds_all_node_count();
+	sit_ds_all_init(&ctx, device_settings.deviceID, nodes);
+	LOG_INF("DS-TWR all to all: %d nodes", nodes);
+	while(device_settings.state == measurement) {
+		uint8_t result_count = 0;
+		uint32_t poll_tx_time = sit_ts_tx_time_after((sit_ts_t)dwt_readsystimestamphi32() << 8, DS_ALL_POLL_DLY_UUS);
+		if (sit_ds_all_send(&ctx, twr_1_poll, (uint8_t)sequence, poll_tx_time)) {
+			sit_ts_t poll_tx_ts = sit_ts_from_tx_time(poll_tx_time);
+			for (uint8_t slot = 1; slot < nodes && device_settings.state == measurement; slot++) {
+				if (sit_ds_all_receive(&ctx, ds_twr_2_resp, poll_tx_ts, slot, &results[result_count])) {
+					result_count++;
 				}
-			} else {
-                LOG_WRN("Something is wrong with Final Msg Receive");
-                dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
-            }
+			}
+			uint32_t final_tx_time = sit_ts_tx_time_after(poll_tx_ts, sit_ds_all_slot_uus(nodes, nodes));
+			if (!sit_ds_all_send(&ctx, ds_twr_3_final, (uint8_t)sequence, final_tx_time)) {
+				LOG_WRN("Final sent too late");
+			}
+			sit_ds_all_report(results, result_count);
+		}
+		sequence++;
+		k_msleep(CONFIG_SIT_TWR_SLOT_PERIOD_MS);
+	}
+}
 
-		} else {
-			LOG_WRN("Something is wrong with Poll Msg Receive");
-            dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+/***************************************************************************
+ * All to all DS-TWR responder. Waits for the poll, then sends its own
+ * frame in its slot and listens to all other slots of the round.
+ *
+****************************************************************************/
+void sit_dstwr_all_responder() {
+	ds_all_ctx_t ctx;
+	ds_all_result_t results[DS_ALL_MAX_NODES + 1];
+	uint8_t nodes = sit_ds_all_node_count();
+	uint8_t own_slot = sit_ds_all_node_index(device_settings.deviceID);
+	sit_ds_all_init(&ctx, device_settings.deviceID, nodes);
+	if (own_slot == 0 || own_slot >= nodes) {
+		LOG_ERR("Responder %d has no DS-TWR slot", device_settings.deviceID);
+		device_settings.state = sleep;
+		return;
+	}
+	while(device_settings.state == measurement) {
+		uint8_t result_count = 0;
+		sit_receive_now(0, 0);
+		msg_ds_all_twr_t poll_msg;
+		if (!sit_check_ds_all_msg_id(twr_1_poll, &poll_msg)) {
+			dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+			continue;
 		}
+		uint64_t poll_rx_ts = sit_rx_timestamp();
+		if (sit_ds_all_rx(&ctx, &poll_msg, poll_rx_ts, &results[result_count])) {
+			result_count++;
+		}
+		for (uint8_t slot = 1; slot <= nodes; slot++) {
+			if (slot == own_slot) {
+				uint32_t resp_tx_time = sit_ts_tx_time_after(poll_rx_ts, sit_ds_all_slot_uus(slot, nodes));
+				if (!sit_ds_all_send(&ctx, ds_twr_2_resp, poll_msg.header.sequence, resp_tx_time)) {
+					LOG_WRN("Something is wrong with Sending Resp Msg");
+				}
+			} else if (sit_ds_all_receive(&ctx, slot == nodes ? ds_twr_3_final : ds_twr_2_resp, poll_rx_ts, slot,
+										  &results[result_count])) {
+				result_count++;
+			}
+		}
+		sit_ds_all_report(results, result_count);
 		sequence++;
-		k_msleep(90);
+	}
+}
+
+void send_tdoa_notify(json_tdoa_data_t *data) {
+	json_tdoa_msg_t tdoa_notify = {
+		.header = {
+			.type = "tdoa_msg",
+			.sequence = sequence,
+			.measurements = measurements,
+		},
+		.data = *data,
+	};
+	ble_sit_tdoa_notify(&tdoa_notify, sizeof(tdoa_notify));
+	measurements++;
+	if(device_settings.max_measurement != 0 && device_settings.max_measurement <= measurements) {
+		device_settings.state = sleep;
+	}
+}
+
+/***************************************************************************
+ * TDoA tag, sends one blink per period. The period has a random jitter,
+ * so two tags with the same period do not collide in every blink.
+ *
+****************************************************************************/
+void sit_tdoa_tag() {
+	while(device_settings.state == measurement) {
+		sit_tdoa_send_blink((uint8_t)sequence);
+		sequence++;
+		uint32_t jitter = sys_rand32_get() % (CONFIG_SIT_TDOA_BLINK_PERIOD_MS / 4 + 1);
+		k_msleep(CONFIG_SIT_TDOA_BLINK_PERIOD_MS - CONFIG_SIT_TDOA_BLINK_PERIOD_MS / 8 + jitter);
+	}
+}
+
+static void sit_tdoa_anchor_frame(tdoa_clock_t *clock, bool reference, const msg_tdoa_t *msg, uint64_t rx_ts, int32_t ci) {
+	if (sit_frame_id(&msg->header) == tdoa_sync) {
+		if (!reference && msg->header.source == SIT_TDOA_REFERENCE_ID) {
+			sit_tdoa_clock_update(clock, msg, rx_ts, ci);
+		}
+	} else if (clock->offset_valid) {
+		json_tdoa_data_t record;
+		sit_tdoa_record(clock, msg, rx_ts, &record);
+		send_tdoa_notify(&record);
+	}
+}
+
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+static void sit_tdoa_anchor_listen(tdoa_clock_t *clock) {
+	if (sit_rx_listen_start() < 0) {
+		return;
+	}
+	while(device_settings.state == measurement) {
+		sit_rx_frame_t frame;
+		msg_tdoa_t rx_msg;
+		if (!sit_rx_listen_get(&frame, K_MSEC(100)) || frame.length != sizeof(msg_tdoa_t)) {
+			continue;
+		}
+		memcpy(&rx_msg, frame.data, sizeof(msg_tdoa_t));
+		msg_id_t id = sit_frame_id(&rx_msg.header);
+		if (id == tdoa_blink || id == tdoa_sync) {
+			sit_tdoa_anchor_frame(clock, false, &rx_msg, frame.rx_ts, frame.ci);
+		}
+	}
+	sit_rx_listen_stop();
+}
+#endif
+
+/***************************************************************************
+ * TDoA anchor, timestamps the blinks of all tags and reports them together
+ * with the last sync. The reference anchor also sends the syncs, the other
+ * anchors only listen and use the double buffered listener if enabled.
+ *
+****************************************************************************/
+void sit_tdoa_anchor() {
+	tdoa_clock_t clock = {0};
+	bool reference = device_settings.deviceID == SIT_TDOA_REFERENCE_ID;
+	int64_t next_sync = k_uptime_get();
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+	if (!reference) {
+		sit_tdoa_anchor_listen(&clock);
+		return;
+	}
+#endif
+	while(device_settings.state == measurement) {
+		uint32_t rx_timeout = 0;
+		if (reference) {
+			if (k_uptime_get() >= next_sync) {
+				uint64_t sync_tx_ts;
+				if (sit_tdoa_send_sync((uint8_t)sequence, &sync_tx_ts)) {
+					sit_tdoa_clock_reference(&clock, (uint8_t)sequence, sync_tx_ts);
+				}
+				sequence++;
+				next_sync += CONFIG_SIT_TDOA_SYNC_PERIOD_MS;
+			}
+			/* listen for blinks until the next sync, 1 ms = 975 uus */
+			int64_t remaining = MAX(next_sync - k_uptime_get(), 1);
+			rx_timeout = (uint32_t)MIN(remaining * 975, 0xFFFFF);
+		}
+		sit_receive_now(0, rx_timeout);
+		msg_tdoa_t rx_msg;
+		if (!sit_check_tdoa_msg(&rx_msg)) {
+			dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+			continue;
+		}
+		sit_tdoa_anchor_frame(&clock, reference, &rx_msg, sit_rx_timestamp(), dwt_readcarrierintegrator());
 	}
 }
 
@@ -374,27 +804,23 @@ void sit_two_device_calibration_a() {
 	while(device_settings.state == measurement) {
 		uint64_t sensing_1_tx, sensing_2_rx, sensing_3_tx = 0;
 		LOG_INF("Two Device Calibration A: %d", sequence);
-		sit_set_rx_after_tx_delay(POLL_TX_TO_RESP_RX_DLY_UUS);
-		sit_set_rx_timeout(DS_RESP_RX_TIMEOUT_UUS+2000);
-		sit_set_preamble_detection_timeout(DS_PRE_TIMEOUT+200);
-		msg_simple_t sensing_1_msg = {{sensing_1, (uint8_t)sequence, device_settings.deviceID, 1}, 0};
+		sit_set_rx_after_tx_delay(sit_reply_rx_after_tx_uus());
+		sit_set_rx_timeout(sit_reply_rx_timeout_uus());
+		sit_set_preamble_detection_timeout(sit_reply_preamble_timeout_pac());
+		msg_simple_t sensing_1_msg = {SIT_HEADER(sensing_1, (uint8_t)sequence, device_settings.deviceID, 1), 0};
 		sit_start_poll((uint8_t*) &sensing_1_msg, (uint16_t)sizeof(sensing_1_msg));
 
 		msg_simple_t resp_msg;
 		if (sit_check_msg_id(sensing_2, &resp_msg)) {
 			LOG_INF("Sensing 2 A");
-			sensing_1_tx = get_tx_timestamp_u64();
-			sensing_2_rx = get_rx_timestamp_u64();
+			sensing_1_tx = sit_tx_timestamp();
+			sensing_2_rx = sit_rx_timestamp();
 
-			uint32_t sensing_3_tx_time = (sensing_2_rx + (1800 * UUS_TO_DWT_TIME)) >> 8;
+			uint32_t sensing_3_tx_time = sit_reply_tx_time(sensing_2_rx);
 
-			sensing_3_tx = (((uint64_t)(sensing_3_tx_time & 0xFFFFFFFEUL)) << 8) + get_tx_ant_dly();
+			sensing_3_tx = sit_ts_from_tx_time(sensing_3_tx_time);
 
-			msg_sensing_3_t sensing_3_msg = {{
-				sensing_3,
-				(uint8_t)sequence,
-				device_settings.deviceID,
-				2},
+			msg_sensing_3_t sensing_3_msg = {SIT_HEADER(sensing_3, (uint8_t)sequence, device_settings.deviceID, 2),
 				(uint32_t)sensing_1_tx,
 				(uint32_t)sensing_2_rx,
 				(uint32_t)sensing_3_tx,
@@ -424,26 +850,22 @@ void sit_two_device_calibration_b() {
 		uint64_t sensing_1_rx, sensing_2_tx, sensing_3_rx = 0;
 		if(sit_check_msg_id(sensing_1, &sensing_1_msg)){
 			LOG_INF("Sensing 1 B");
-			sensing_1_rx = get_rx_timestamp_u64();
-			uint32_t sesing_2_tx_time = (sensing_1_rx + (1800 * UUS_TO_DWT_TIME)) >> 8;
+			sensing_1_rx = sit_rx_timestamp();
+			uint32_t sesing_2_tx_time = sit_reply_tx_time(sensing_1_rx);
 
-			sit_set_rx_after_tx_delay(1500);
-			sit_set_rx_timeout(DS_RESP_RX_TIMEOUT_UUS+2000);
-			sit_set_preamble_detection_timeout(DS_PRE_TIMEOUT+200);
-			msg_simple_t sensing_2_msg = {{sensing_2, (uint8_t)sequence, device_settings.deviceID, 0}, 0};
+			sit_set_rx_after_tx_delay(sit_reply_rx_after_tx_uus());
+			sit_set_rx_timeout(sit_reply_rx_timeout_uus());
+			sit_set_preamble_detection_timeout(sit_reply_preamble_timeout_pac());
+			msg_simple_t sensing_2_msg = {SIT_HEADER(sensing_2, (uint8_t)sequence, device_settings.deviceID, 0), 0};
 			sit_send_at_with_response((uint8_t*) &sensing_2_msg, (uint16_t)sizeof(sensing_2_msg),sesing_2_tx_time);
 			msg_sensing_3_t resp_sensing_3;
 			if (sit_check_sensing_3_msg_id(sensing_3, &resp_sensing_3) ){
 				LOG_INF("Sensing 3 B");
-				sensing_2_tx = get_tx_timestamp_u64();
-				sensing_3_rx = get_rx_timestamp_u64();
-
-				uint32_t sesing_3_tx_time = (sensing_3_rx + (1800 * UUS_TO_DWT_TIME)) >> 8;
-				msg_sensing_info_t sensing_info = {{
-					sensing_resp,
-					(uint8_t)sequence,
-					device_settings.deviceID,
-					0},
+				sensing_2_tx = sit_tx_timestamp();
+				sensing_3_rx = sit_rx_timestamp();
+
+				uint32_t sesing_3_tx_time = sit_reply_tx_time(sensing_3_rx);
+				msg_sensing_info_t sensing_info = {SIT_HEADER(sensing_resp, (uint8_t)sequence, device_settings.deviceID, 0),
 					(uint32_t)sensing_1_rx,
 					(uint32_t)sensing_2_tx,
 					(uint32_t)sensing_3_rx,
@@ -461,7 +883,95 @@ void sit_two_device_calibration_b() {
 	k_msleep(500);
 }
 
+static void sit_two_device_calibration_c_report(const msg_sensing_3_t *sensing_3_msg, const msg_sensing_info_t *sensing_info_msg,
+												uint64_t sensing_1_rx, uint64_t sensing_2_rx, uint64_t sensing_3_rx) {
+	time_m21 = (double) (sensing_3_msg->sensing_2_rx - sensing_3_msg->sensing_1_tx);
+	time_m31 = (double) (sensing_3_msg->sensing_3_tx - sensing_3_msg->sensing_1_tx);
+
+	time_a21 = (double) (sensing_info_msg->sensing_2_tx - sensing_info_msg->sensing_1_rx);
+	time_a31 = (double) (sensing_info_msg->sensing_3_rx - sensing_info_msg->sensing_1_rx);
+
+	time_b21 = (double) (sensing_2_rx - sensing_1_rx);
+	time_b31 = (double) (sensing_3_rx - sensing_1_rx);
+
+	time_tb_i = (double) (sensing_info_msg->sensing_2_tx - sensing_info_msg->sensing_1_rx);
+	time_tb_ii = (double) (sensing_info_msg->sensing_3_rx - sensing_info_msg->sensing_2_tx);
+
+	time_tc_i = (double) (sensing_2_rx - sensing_1_rx);
+	time_tc_ii = (double) (sensing_3_rx - sensing_2_rx);
+
+	time_round_1 = (double) (sensing_3_msg->sensing_2_rx - sensing_3_msg->sensing_1_tx);
+	time_round_2 = (double) (sensing_info_msg->sensing_3_rx - sensing_info_msg->sensing_2_tx);
+	time_reply_1 = (double) (sensing_info_msg->sensing_2_tx - sensing_info_msg->sensing_1_rx);
+	time_reply_2 = (double) (sensing_3_msg->sensing_3_tx - sensing_3_msg->sensing_2_rx);
+
+	uint64_t tof_dtu;
+	tof_dtu = (uint64_t)((time_round_1 * time_round_2 - time_reply_1 * time_reply_2)
+				/ (time_round_1 + time_round_2 + time_reply_1 + time_reply_2)
+			);
+
+	double tof = (double)tof_dtu * DWT_TIME_UNITS;
+	distance = tof * SPEED_OF_LIGHT;
+
+	send_two_device_notify();
+}
+
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+/***************************************************************************
+ * Device C only listens, the four frames of A and B follow each other
+ * within a few ms. The double buffered listener queues them, so no frame
+ * is lost while the last one is read.
+ *
+****************************************************************************/
+static void sit_two_device_calibration_c_listen() {
+	uint64_t sensing_1_rx = 0, sensing_2_rx = 0, sensing_3_rx = 0;
+	msg_sensing_3_t sensing_3_msg;
+	msg_sensing_info_t sensing_info_msg;
+	msg_id_t next_id = sensing_1;
+
+	if (sit_rx_listen_start() < 0) {
+		return;
+	}
+	while(device_settings.state == measurement) {
+		sit_rx_frame_t frame;
+		if (!sit_rx_listen_get(&frame, K_MSEC(100))) {
+			next_id = sensing_1;
+			continue;
+		}
+		header_t *header = (header_t*)frame.data;
+		if (sit_frame_id(header) == sensing_1 && frame.length == sizeof(msg_simple_t)) {
+			LOG_INF("Two Device Calibration C: %d", sequence);
+			sensing_1_rx = frame.rx_ts;
+			next_id = sensing_2;
+		} else if (sit_frame_id(header) != next_id) {
+			next_id = sensing_1;
+		} else if (next_id == sensing_2 && frame.length == sizeof(msg_simple_t)) {
+			sensing_2_rx = frame.rx_ts;
+			next_id = sensing_3;
+		} else if (next_id == sensing_3 && frame.length == sizeof(msg_sensing_3_t)) {
+			memcpy(&sensing_3_msg, frame.data, sizeof(msg_sensing_3_t));
+			sensing_3_rx = frame.rx_ts;
+			next_id = sensing_resp;
+		} else if (next_id == sensing_resp && frame.length == sizeof(msg_sensing_info_t)) {
+			memcpy(&sensing_info_msg, frame.data, sizeof(msg_sensing_info_t));
+			sit_two_device_calibration_c_report(&sensing_3_msg, &sensing_info_msg, sensing_1_rx, sensing_2_rx, sensing_3_rx);
+			sequence++;
+			next_id = sensing_1;
+		} else {
+			next_id = sensing_1;
+		}
+	}
+	sit_rx_listen_stop();
+	LOG_INF("Simple Calibration Test");
+}
+#endif
+
 void sit_two_device_calibration_c() {
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+	sit_two_device_calibration_c_listen();
+#else
+	uint16_t pre_timeout = sit_profile_preamble_timeout_pac(sit_reply_listen_window_uus());
+	uint32_t rx_timeout = sit_profile_rx_timeout_uus(sit_reply_listen_window_uus());
 	while(device_settings.state == measurement) {
 		LOG_INF("Two Device Calibration C: %d", sequence);
 		sit_receive_now(0,0);
@@ -469,51 +979,23 @@ void sit_two_device_calibration_c() {
 		uint64_t sensing_1_rx, sensing_2_rx, sensing_3_rx = 0;
 		if(sit_check_msg_id(sensing_1, &simple_poll_msg)){
 			LOG_INF("Sensing 1 C");
-			sensing_1_rx = get_rx_timestamp_u64();
-			sit_receive_now(DS_PRE_TIMEOUT+200, DS_RESP_RX_TIMEOUT_UUS+2000);
+			sensing_1_rx = sit_rx_timestamp();
+			sit_receive_now(pre_timeout, rx_timeout);
 			if(sit_check_msg_id(sensing_2, &simple_poll_msg)){
 				LOG_INF("Sensing 2 C");
-				sensing_2_rx = get_rx_timestamp_u64();
-				sit_receive_now(DS_PRE_TIMEOUT+200, DS_RESP_RX_TIMEOUT_UUS+2000);
+				sensing_2_rx = sit_rx_timestamp();
+				sit_receive_now(pre_timeout, rx_timeout);
 				msg_sensing_3_t sensing_3_msg;
 				if(sit_check_sensing_3_msg_id(sensing_3, &sensing_3_msg)){
 					LOG_INF("Sensing 3 C");
-					sensing_3_rx = get_rx_timestamp_u64();
-					sit_receive_now(DS_PRE_TIMEOUT+200, DS_RESP_RX_TIMEOUT_UUS+2000);
+					sensing_3_rx = sit_rx_timestamp();
+					sit_receive_now(pre_timeout, rx_timeout);
 					msg_sensing_info_t sensing_info_msg;
 					if(sit_check_sensing_info_msg_id(sensing_resp, &sensing_info_msg)){
 						LOG_INF("Sensing Info Final C");
-
-							time_m21 = (double) (sensing_3_msg.sensing_2_rx - sensing_3_msg.sensing_1_tx);
-							time_m31 = (double) (sensing_3_msg.sensing_3_tx - sensing_3_msg.sensing_1_tx);
-
-							time_a21 = (double) (sensing_info_msg.sensing_2_tx - sensing_info_msg.sensing_1_rx);
-							time_a31 = (double) (sensing_info_msg.sensing_3_rx - sensing_info_msg.sensing_1_rx);
-
-							time_b21 = (double) (sensing_2_rx - sensing_1_rx);
-							time_b31 = (double) (sensing_3_rx - sensing_1_rx);
-
-							time_tb_i = (double) (sensing_info_msg.sensing_2_tx - sensing_info_msg.sensing_1_rx);
-							time_tb_ii = (double) (sensing_info_msg.sensing_3_rx - sensing_info_msg.sensing_2_tx);
-
-							time_tc_i = (double) (sensing_2_rx - sensing_1_rx);
-							time_tc_ii = (double) (sensing_3_rx - sensing_2_rx);
-
-							time_round_1 = (double) (sensing_3_msg.sensing_2_rx - sensing_3_msg.sensing_1_tx);
-							time_round_2 = (double) (sensing_info_msg.sensing_3_rx - sensing_info_msg.sensing_2_tx);
-							time_reply_1 = (double) (sensing_info_msg.sensing_2_tx - sensing_info_msg.sensing_1_rx);
-							time_reply_2 = (double) (sensing_3_msg.sensing_3_tx - sensing_3_msg.sensing_2_rx);
-
-							uint64_t tof_dtu;
-							tof_dtu = (uint64_t)((time_round_1 * time_round_2 - time_reply_1 * time_reply_2)
-										/ (time_round_1 + time_round_2 + time_reply_1 + time_reply_2)
-									);
-
-							double tof = (double)tof_dtu * DWT_TIME_UNITS;
-							distance = tof * SPEED_OF_LIGHT;
-
-							send_two_device_notify();
-						}
+						sit_two_device_calibration_c_report(&sensing_3_msg, &sensing_info_msg,
+															sensing_1_rx, sensing_2_rx, sensing_3_rx);
+					}
 				}
 			}
 		}
@@ -521,9 +1003,33 @@ void sit_two_device_calibration_c() {
 		k_msleep(500);
 	}
 	LOG_INF("Simple Calibration Test");
+#endif
 }
 
 
+void sit_radio_restore() {
+	/* the RX timing registers are back to their reset values */
+	sit_shadow_reset();
+	sit_frame_log_airtime(&sit_device_config);
+	/* Configure the TX spectrum parameters (power, PG delay and PG count) */
+	dwt_configuretxrf(&txconfig_options_ch9_sit);
+
+	set_antenna_delay(device_settings.rx_ant_dly, device_settings.tx_ant_dly);
+
+	/* Next can enable TX/RX states output on GPIOs 5 and 6 to help debug, and also TX/RX LEDs
+	 * Note, in real low power applications the LEDs should not be used. */
+	dwt_setlnapamode(DWT_LNA_ENABLE | DWT_PA_ENABLE);
+
+	/* Enable Diacnostic all */
+	dwt_configciadiag(DW_CIA_DIAG_LOG_ALL);
+
+	/* written again with the next sit_frame_filter() */
+	sit_frame_filter_reset();
+#ifdef CONFIG_SIT_IRQ
+	sit_event_restore();
+#endif
+}
+
 uint8_t sit_init() {
 	device_init();
 	/* Configure SPI rate, for initialize it should not faster than 7 MHz */
@@ -560,34 +1066,75 @@ uint8_t sit_init() {
 		LOG_ERR("dwt_configure failed");
 		return -2;
 	}
-	/* Configure the TX spectrum parameters (power, PG delay and PG count) */
-	dwt_configuretxrf(&txconfig_options_ch9_sit);
-
-	set_antenna_delay(device_settings.rx_ant_dly, device_settings.tx_ant_dly);
+	sit_radio_restore();
+	sit_tpl_init();
 
-	/* Next can enable TX/RX states output on GPIOs 5 and 6 to help debug, and also TX/RX LEDs
-	 * Note, in real low power applications the LEDs should not be used. */
-	dwt_setlnapamode(DWT_LNA_ENABLE | DWT_PA_ENABLE);
+	sit_twr_set_scheduler(IS_ENABLED(CONFIG_SIT_TWR_SCHEDULER_ROUND_ROBIN) ?
+			      &twr_scheduler_round_robin : &twr_scheduler_backoff);
 
-	/* Enable Diacnostic all */
-	dwt_configciadiag(DW_CIA_DIAG_LOG_ALL);
+#ifdef CONFIG_SIT_IRQ
+	/* TX/RX events are reported by dwt_isr() instead of polling SYS_STATUS */
+	if (sit_event_init() < 0) {
+		LOG_ERR("sit_event_init failed");
+		return -4;
+	}
+#endif
  	k_msleep(100);
 
 	return 1;
 }
 
+static atomic_t setup_changed;
+
+void sit_setup_changed() {
+	atomic_set(&setup_changed, 1);
+}
+
+/***************************************************************************
+ * Take over a new setup in the ranging thread
+ *
+****************************************************************************/
+static void sit_setup_apply() {
+	/* the peers of the last setup may have other IDs */
+	sit_clock_reset();
+	sit_profile_apply();
+	/* the reply delay of the last PHY profile does not fit the new one */
+	sit_reply_reset();
+	/* the IRQ latency histogram covers one measurement setup */
+	dw3000_hw_reset_irq_stats();
+}
+
+/* ds_3_twr and ds_4_twr share the exchange, see sit_dstwr_respond() */
+static bool sit_dstwr_mode() {
+	return device_settings.measurement_type == ds_3_twr || device_settings.measurement_type == ds_4_twr;
+}
+
 void sit_run_forever(){
 	ble_start_connection();
 	while(42) { //Life, the universe, and everything
 		if(is_connected()){
+			if (atomic_cas(&setup_changed, 1, 0)) {
+				sit_setup_apply();
+			}
+			/* the calibration device c listens to the frames of a and b */
+			sit_frame_filter(IS_ENABLED(CONFIG_SIT_FRAME_FILTER) &&
+					 device_settings.measurement_type != two_device_calibration);
 			if (device_settings.measurement_type == ss_twr && device_type == initiator) {
-					sit_dstwr_initiator();
+					sit_sstwr_initiator();
 			} else if (device_settings.measurement_type == ss_twr && device_type == responder) {
-					sit_dstwr_responder();
-			} else if (device_settings.measurement_type == ds_3_twr && device_type == initiator) {
+					sit_sstwr_responder();
+			} else if (sit_dstwr_mode() && device_type == initiator) {
 					sit_dstwr_initiator();
-			} else if (device_settings.measurement_type == ds_3_twr && device_type == responder) {
+			} else if (sit_dstwr_mode() && device_type == responder) {
 					sit_dstwr_responder();
+			} else if (device_settings.measurement_type == ds_all_twr && device_type == initiator) {
+					sit_dstwr_all_initiator();
+			} else if (device_settings.measurement_type == ds_all_twr && device_type == responder) {
+					sit_dstwr_all_responder();
+			} else if (device_settings.measurement_type == ul_tdoa && device_type == initiator) {
+					sit_tdoa_tag();
+			} else if (device_settings.measurement_type == ul_tdoa && device_type == responder) {
+					sit_tdoa_anchor();
 			} else if  (device_settings.measurement_type == two_device_calibration && device_type == dev_a) {
 					sit_two_device_calibration_a();
 			} else if  (device_settings.measurement_type == two_device_calibration && device_type == dev_b) {
@@ -0,0 +1,135 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_clock.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Clock model of the peers.
+ *
+ * Scalar Kalman filter for the skew of every peer. The skew of a crystal
+ * only drifts slowly with the temperature, so the process noise is small
+ * and a single noisy carrier integrator value has little weight.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_clock.h"
+#include "sit/sit_config.h"
+#include "sit/sit_ts.h"
+
+#include <string.h>
+
+#include <deca_device_api.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_CLOCK, LOG_LEVEL_INF);
+
+/* float only, the FPU of the nRF52833 is single precision */
+/* variance of the skew without any measurement (+-20 ppm crystal) */
+#define CLOCK_INIT_VARIANCE (20e-6f * 20e-6f)
+/* drift of the skew per second */
+#define CLOCK_PROCESS_VARIANCE (0.01e-6f * 0.01e-6f)
+/* noise of the carrier integrator (0.1 ppm) */
+#define CLOCK_CI_VARIANCE (0.1e-6f * 0.1e-6f)
+/* noise of a single timestamp, about 15 ps / 1 dtu */
+#define CLOCK_TS_NOISE_DTU 1.0f
+/* carrier integrator to skew, see dwt_readcarrierintegrator() */
+#define CLOCK_CI_TO_SKEW_CHAN_5 ((float)(FREQ_OFFSET_MULTIPLIER * HERTZ_TO_PPM_MULTIPLIER_CHAN_5 / 1.0e6))
+#define CLOCK_CI_TO_SKEW_CHAN_9 ((float)(FREQ_OFFSET_MULTIPLIER * HERTZ_TO_PPM_MULTIPLIER_CHAN_9 / 1.0e6))
+
+static sit_clock_peer_t clock_peers[CONFIG_SIT_CLOCK_MAX_PEERS];
+
+void sit_clock_reset(void) {
+	memset(clock_peers, 0, sizeof(clock_peers));
+}
+
+/* a peer with only the first sync has no skew yet, but its entry is in use */
+static bool clock_peer_used(const sit_clock_peer_t *peer) {
+	return peer->valid || peer->sync_valid;
+}
+
+static sit_clock_peer_t *clock_peer(uint8_t peer_id, bool create) {
+	sit_clock_peer_t *oldest = &clock_peers[0];
+	for (int i = 0; i < CONFIG_SIT_CLOCK_MAX_PEERS; i++) {
+		if (clock_peer_used(&clock_peers[i]) && clock_peers[i].peer_id == peer_id) {
+			return &clock_peers[i];
+		}
+		if (!clock_peer_used(&clock_peers[i]) || clock_peers[i].update_ms < oldest->update_ms) {
+			oldest = &clock_peers[i];
+			if (!clock_peer_used(oldest)) {
+				break;
+			}
+		}
+	}
+	if (!create) {
+		return NULL;
+	}
+	memset(oldest, 0, sizeof(sit_clock_peer_t));
+	oldest->peer_id = peer_id;
+	oldest->variance = CLOCK_INIT_VARIANCE;
+	oldest->update_ms = k_uptime_get();
+	return oldest;
+}
+
+static void clock_filter(sit_clock_peer_t *peer, float skew, float variance) {
+	int64_t now = k_uptime_get();
+	/* predict, the skew stays, its uncertainty grows with the time */
+	peer->variance += CLOCK_PROCESS_VARIANCE * (float)(now - peer->update_ms) / 1000.0f;
+	/* correct */
+	float gain = peer->variance / (peer->variance + variance);
+	peer->skew += gain * (skew - peer->skew);
+	peer->variance *= (1.0f - gain);
+	peer->update_ms = now;
+	peer->valid = true;
+	peer->updates++;
+}
+
+float sit_clock_update_ci(uint8_t peer_id, int32_t ci) {
+	sit_clock_peer_t *peer = clock_peer(peer_id, true);
+	float ci_to_skew = (sit_device_config.chan == 5) ? CLOCK_CI_TO_SKEW_CHAN_5 : CLOCK_CI_TO_SKEW_CHAN_9;
+	/* positive skew -> peer clock faster than the own clock, same sign as sit_tof_ci_to_skew_q40() */
+	float skew = (float)ci * ci_to_skew;
+	clock_filter(peer, skew, CLOCK_CI_VARIANCE);
+	return peer->skew;
+}
+
+void sit_clock_update_sync(uint8_t peer_id, uint64_t peer_ts, uint64_t local_ts) {
+	sit_clock_peer_t *peer = clock_peer(peer_id, true);
+	peer_ts &= SIT_TS_MASK;
+	local_ts &= SIT_TS_MASK;
+	if (peer->sync_valid && sit_ts_before(peer->sync_local_ts, local_ts)) {
+		uint64_t peer_period = sit_ts_diff(peer_ts, peer->sync_peer_ts);
+		uint64_t local_period = sit_ts_diff(local_ts, peer->sync_local_ts);
+		/* difference of the periods in integers, peer_period / local_period would round to 0.06 ppm in float */
+		float skew = (float)((int64_t)peer_period - (int64_t)local_period) / (float)local_period;
+		/* four timestamps, the noise shrinks with the sync period */
+		float noise = 2.0f * CLOCK_TS_NOISE_DTU / (float)local_period;
+		clock_filter(peer, skew, noise * noise);
+	}
+	peer->sync_peer_ts = peer_ts;
+	peer->sync_local_ts = local_ts;
+	peer->sync_valid = true;
+}
+
+float sit_clock_skew(uint8_t peer_id) {
+	const sit_clock_peer_t *peer = clock_peer(peer_id, false);
+	return peer != NULL ? peer->skew : 0.0f;
+}
@@ -52,6 +52,8 @@ device_settings_t device_settings = {
     .diagnostic = false,
     .min_measurement = 0,
     .max_measurement = 0,
+    .tdma_slot = 0,
+    .tdma_slots = 0,
 };
 
 dwt_config_t sit_device_config = {
@@ -121,6 +123,12 @@ void set_measurement_type(char *measurement_type) {
         device_settings.measurement_type = ss_twr;
     } else if (strcmp(measurement_type, "ds_3_twr") == 0) {
         device_settings.measurement_type = ds_3_twr;
+    } else if (strcmp(measurement_type, "ds_4_twr") == 0) {
+        device_settings.measurement_type = ds_4_twr;
+    } else if (strcmp(measurement_type, "ds_all_twr") == 0) {
+        device_settings.measurement_type = ds_all_twr;
+    } else if (strcmp(measurement_type, "ul_tdoa") == 0) {
+        device_settings.measurement_type = ul_tdoa;
     } else if (strcmp(measurement_type, "two_device") == 0) {
         device_settings.measurement_type = two_device_calibration;
     }
@@ -138,3 +146,11 @@ void set_tx_ant_dly(uint16_t dly) {
     device_settings.tx_ant_dly = dly;
     dwt_settxantennadelay(dly);
 }
+
+void set_tdma_slot(uint8_t slot, uint8_t slots) {
+    device_settings.tdma_slot = slot;
+    device_settings.tdma_slots = slots;
+    if (slots > 0) {
+        LOG_INF("TDMA slot %d of %d", slot, slots);
+    }
+}
@@ -29,6 +29,9 @@
  * @todo everything 
  */
 #include "sit/sit_device.h"
+#ifdef CONFIG_SIT_IRQ
+	#include "sit/sit_event.h"
+#endif
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -52,6 +55,16 @@ void waitforsysstatus(uint32_t *lo_result, uint32_t *hi_result, uint32_t lo_mask
     uint32_t lo_result_tmp = 0;
     uint32_t hi_result_tmp = 0;
 
+#ifdef CONFIG_SIT_IRQ
+    // Sleep on the event queue filled by dwt_isr() instead of spinning on SPI
+    if (lo_mask || hi_mask)
+    {
+        sit_event_t event;
+        sit_event_wait(lo_mask, hi_mask, &event);
+        lo_result_tmp = event.status;
+        hi_result_tmp = event.status_hi;
+    }
+#else
     // If a mask has been passed into the function for the system status register (lower 32-bits)
     if (lo_mask)
     {
@@ -73,6 +86,7 @@ void waitforsysstatus(uint32_t *lo_result, uint32_t *hi_result, uint32_t lo_mask
     {
         while (!((hi_result_tmp = dwt_readsysstatushi()) & (hi_mask))) { };
     }
+#endif
 
     if (lo_result != NULL)
     {
@@ -106,7 +120,7 @@ void init_device_id(void) {
 	uint8_t buf_deviceID[8];
 	hwinfo_get_device_id(buf_deviceID, sizeof(buf_deviceID));
 
-	for(int i = 0; i < sizeof(buf_deviceID); i++){
+	for(size_t i = 0; i < sizeof(buf_deviceID); i++){
 		sprintf(m_deviceID + 2*i, "%02X", buf_deviceID[i]);
 	}
     m_deviceID[16] = '\0';
@@ -68,15 +68,15 @@ void get_diagnostic(diagnostic_info *diagnostic) {
     ip_rsl = 10 * log10((float)ip_cp / ip_n) + ip_alpha + log_constant + D;
     ip_fsl = 10 * log10(((ip_f1 + ip_f2 + ip_f3) / ip_n)) + ip_alpha + D;
 
-    LOG_INF("Recived Index: %f", ip_rsl);
-    LOG_INF("First Path Index: %f", ip_fsl);
+    LOG_DBG("Recived Index: %f", ip_rsl);
+    LOG_DBG("First Path Index: %f", ip_fsl);
 
     // If differenc is bigger than 12 db the singal is Non Line of Sight
     if ((ip_rsl - ip_fsl) > 12 ) {
-        LOG_INF("non line of sight"); 
+        LOG_DBG("non line of sight"); 
         diagnostic->nlos = 100;
     } else {
-        LOG_INF("line of sight");
+        LOG_DBG("line of sight");
         diagnostic->nlos = 0;
     }
 
@@ -33,18 +33,45 @@
 #include "sit/sit_distance.h"
 #include "sit/sit_config.h"
 #include "sit/sit_device.h"
+#include "sit/sit_frame.h"
+#include "sit/sit_reply.h"
+#include "sit/sit_shadow.h"
+#include "sit/sit_ts.h"
+#include "sit/sit_tx_template.h"
+#include "sit/sit_utils.h"
+#include "sit/sit_trace.h"
 #ifdef CONFIG_SIT_DIAGNOSTIC
 	#include "sit/sit_diagnostic.h"
 #endif
+#ifdef CONFIG_SIT_IRQ
+	#include "sit/sit_event.h"
+#else
+	#define sit_event_flush()
+#endif
 
 
 #include <deca_device_api.h>
+#include <deca_regs.h>
+#include <dw3000_spi.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(SIT_DISTANCE, LOG_LEVEL_INF);
 
+/* RX_FINFO, RX_TIME and TX_TIME are in one block of register file 0 (DW3000 user manual) */
+#define SIT_RX_INFO_LEN (TX_TIME_LO_ID + SIT_TS_LEN - RX_FINFO_ID)
+
+/* Frame info of the last good frame, read together in sit_check_msg() */
+typedef struct {
+	uint16_t length;	// frame length incl. FCS
+	uint64_t rx_ts;		// 40 bit RX time of the frame
+	uint64_t tx_ts;		// 40 bit TX time of the last sent frame
+} sit_rx_info_t;
+
 uint32_t status_reg;
 
+static sit_rx_info_t rx_info;
+static sit_frame_stats_t frame_stats;
+
 diagnostic_info diagnostic;
 
 /***************************************************************************
@@ -58,89 +85,186 @@ diagnostic_info diagnostic;
  *
 ****************************************************************************/
 void sit_start_poll(uint8_t* msg_data, uint16_t msg_size){
+	sit_shadow_flush();
+	sit_event_flush();
 	dwt_writesysstatuslo(DWT_INT_TXFRS_BIT_MASK);
-	dwt_writetxdata(msg_size, msg_data, 0); // 0 offset
-	dwt_writetxfctrl(msg_size, 0, 1); // frame_length, bufferOffset, ranging bit (0 no ranging, 1 ranging)
+	dwt_writetxdata(msg_size, msg_data, SIT_TX_FRAME_OFFSET); // behind the TX templates
+	dwt_writetxfctrl(msg_size, SIT_TX_FRAME_OFFSET, 1); // frame_length, bufferOffset, ranging bit (0 no ranging, 1 ranging)
 	dwt_starttx(DWT_START_TX_IMMEDIATE | DWT_RESPONSE_EXPECTED);//switch to rx after `setrxaftertxdelay`
 }
 
-bool sit_send_at(uint8_t* msg_data, uint16_t size, uint32_t tx_time){
-	dwt_writetxdata(size, msg_data, 0);
-	dwt_writetxfctrl(size, 0, 1);
+void sit_send_now(uint8_t* msg_data, uint16_t size){
+	dwt_writetxdata(size, msg_data, SIT_TX_FRAME_OFFSET);
+	dwt_writetxfctrl(size, SIT_TX_FRAME_OFFSET, 1);
+	sit_shadow_flush();
+	sit_event_flush();
+	dwt_starttx(DWT_START_TX_IMMEDIATE);
+	waitforsysstatus(&status_reg, NULL, DWT_INT_TXFRS_BIT_MASK, 0);
+	dwt_writesysstatuslo(DWT_INT_TXFRS_BIT_MASK);
+}
+
+static bool sit_start_tx_at(uint16_t offset, uint16_t size, uint32_t tx_time, uint8_t mode) {
+	dwt_writetxfctrl(size, offset, 1);
 	dwt_setdelayedtrxtime(tx_time);
-	uint8_t ret = dwt_starttx(DWT_START_TX_DELAYED);
+	sit_shadow_flush();
+	sit_event_flush();
+	sit_reply_check(tx_time);
+	uint8_t ret = dwt_starttx(mode);
+	sit_reply_result(tx_time, ret == DWT_SUCCESS);
 	if(ret == DWT_SUCCESS) {
 		waitforsysstatus(&status_reg, NULL, DWT_INT_TXFRS_BIT_MASK, 0);
 		dwt_writesysstatuslo(DWT_INT_RXFCG_BIT_MASK); // write to clear send status bit
-		LOG_INF("Send Success");
+		SIT_TRACE(sit_trace_tx_done, size, tx_time, status_reg);
 		return true;
 	} else {
 		recover_tx_errors();
 		status_reg = dwt_readsysstatuslo();
+		SIT_TRACE(sit_trace_tx_late, size, tx_time, status_reg);
 		LOG_WRN("sit_sendAt() - dwt_starttx() late");
 		return false;
 	}
 }
 
+bool sit_send_at(uint8_t* msg_data, uint16_t size, uint32_t tx_time){
+	dwt_writetxdata(size, msg_data, SIT_TX_FRAME_OFFSET);
+	return sit_start_tx_at(SIT_TX_FRAME_OFFSET, size, tx_time, DWT_START_TX_DELAYED);
+}
+
 bool sit_send_at_with_response(uint8_t* msg_data, uint16_t size, uint32_t tx_time){
-	dwt_setdelayedtrxtime(tx_time);
-	dwt_writetxdata(size, msg_data, 0);
-	dwt_writetxfctrl(size, 0, 1);
-	uint8_t ret = dwt_starttx(DWT_START_TX_DELAYED | DWT_RESPONSE_EXPECTED);
-	if(ret == DWT_SUCCESS) {
-		waitforsysstatus(&status_reg, NULL, DWT_INT_TXFRS_BIT_MASK, 0);
-		dwt_writesysstatuslo(DWT_INT_RXFCG_BIT_MASK); // write to clear send status bit
-		LOG_INF("Send Success");
-		return true;
-	} else {
-		recover_tx_errors();
-		status_reg = dwt_readsysstatuslo();
-		LOG_WRN("sit_sendAt() - dwt_starttx() late");
-		return false;
-	}
+	dwt_writetxdata(size, msg_data, SIT_TX_FRAME_OFFSET);
+	return sit_start_tx_at(SIT_TX_FRAME_OFFSET, size, tx_time, DWT_START_TX_DELAYED | DWT_RESPONSE_EXPECTED);
+}
+
+bool sit_send_buffer_at(uint16_t offset, uint16_t size, uint32_t tx_time, bool response) {
+	return sit_start_tx_at(offset, size, tx_time, DWT_START_TX_DELAYED | (response ? DWT_RESPONSE_EXPECTED : 0));
 }
 
 void sit_receive_now(uint16_t preamble_detction_timeout, uint32_t rx_timeout) {
-	dwt_setpreambledetecttimeout(preamble_detction_timeout);
-	dwt_setrxtimeout(rx_timeout);
+	sit_shadow_set_preamble_timeout(preamble_detction_timeout);
+	sit_shadow_set_rx_timeout(rx_timeout);
+	sit_shadow_flush();
+	sit_event_flush();
 	uint8_t ret = dwt_rxenable(DWT_START_RX_IMMEDIATE);
 	if (ret == DWT_SUCCESS) {
-		LOG_INF("RX enabled");
+		SIT_TRACE(sit_trace_rx_enable, (uint16_t)MIN(rx_timeout, UINT16_MAX), 0, 0);
 	} else {
+		SIT_TRACE(sit_trace_rx_enable_fail, 0, 0, 0);
 		LOG_ERR("RX enable failed");
 	}
 }
 
-void sit_receive_at(uint32_t timeout) {
-	dwt_setpreambledetecttimeout(0);
-	dwt_setrxtimeout(timeout); // 0 : disable timeout
-	dwt_rxenable(DWT_START_RX_DELAYED | DWT_IDLE_ON_DLY_ERR); //DWT_START_RX_DELAYED only used with dwt_setdelayedtrxtime() before
+bool sit_receive_at(uint32_t timeout) {
+	sit_shadow_set_preamble_timeout(0);
+	sit_shadow_set_rx_timeout(timeout); // 0 : disable timeout
+	sit_shadow_flush();
+	sit_event_flush();
+	//DWT_START_RX_DELAYED only used with dwt_setdelayedtrxtime() before
+	if (dwt_rxenable(DWT_START_RX_DELAYED | DWT_IDLE_ON_DLY_ERR) != DWT_SUCCESS) {
+		/* the receiver stays idle, no RX event will follow */
+		LOG_WRN("sit_receive_at() - dwt_rxenable() late");
+		return false;
+	}
+	return true;
 }
 
 uint32_t sit_msg_receive() {
 	uint32_t l_status_reg;
 	waitforsysstatus(&l_status_reg, NULL, (DWT_INT_RXFCG_BIT_MASK | SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR), 0);
+	/* A frame to another device stops the receiver, go on listening for ours */
+	while ((l_status_reg & (DWT_INT_RXFCG_BIT_MASK | SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR)) == DWT_INT_ARFE_BIT_MASK) {
+		frame_stats.filtered++;
+		dwt_writesysstatuslo(DWT_INT_ARFE_BIT_MASK);
+		if (dwt_rxenable(DWT_START_RX_IMMEDIATE) != DWT_SUCCESS) {
+			break;
+		}
+		waitforsysstatus(&l_status_reg, NULL, (DWT_INT_RXFCG_BIT_MASK | SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR), 0);
+	}
 	return l_status_reg;
 }
 
-bool sit_check_msg(uint8_t* data, uint16_t expected_frame_length) {
+static bool frame_filter_configured;
+
+void sit_frame_filter_reset(void) {
+	frame_filter_configured = false;
+}
+
+void sit_frame_filter(bool enable) {
+	static bool enabled;
+	static uint8_t address;
+	if (frame_filter_configured && enabled == enable && (!enable || address == device_settings.deviceID)) {
+		return;
+	}
+	if (enable) {
+		dwt_setpanid(SIT_PAN_ID);
+		dwt_setaddress16(device_settings.deviceID);
+		dwt_configureframefilter(DWT_FF_ENABLE_802_15_4, DWT_FF_DATA_EN);
+	} else {
+		dwt_configureframefilter(DWT_FF_DISABLE, 0);
+	}
+	frame_filter_configured = true;
+	enabled = enable;
+	address = device_settings.deviceID;
+	LOG_INF("Frame filter %s (address 0x%04x)", enable ? "on" : "off", address);
+}
+
+void sit_get_frame_stats(sit_frame_stats_t *stats) {
+	*stats = frame_stats;
+}
+
+/***************************************************************************
+ * Read frame length and both timestamps with one SPI transaction
+ * instead of one transaction each. Only valid in single buffer mode
+ * without STS, like dwt_readrxtimestamp() in this configuration.
+ *
+ * @return None
+ *
+****************************************************************************/
+static void sit_read_rx_info(void) {
+	uint8_t regs[SIT_RX_INFO_LEN];
+	if (dw3000_spi_read_reg(RX_FINFO_ID, sizeof(regs), regs) == 0) {
+		rx_info.length = (regs[0] | (regs[1] << 8)) & RX_FINFO_RXFLEN_BIT_MASK;
+		rx_info.rx_ts = sit_ts_unpack((const sit_ts40_t*)&regs[RX_TIME_0_ID - RX_FINFO_ID]);
+		rx_info.tx_ts = sit_ts_unpack((const sit_ts40_t*)&regs[TX_TIME_LO_ID - RX_FINFO_ID]);
+	} else {
+		rx_info.length = dwt_getframelength();
+		rx_info.rx_ts = get_rx_timestamp_u64();
+		rx_info.tx_ts = get_tx_timestamp_u64();
+	}
+}
+
+uint64_t sit_rx_timestamp(void) {
+	return rx_info.rx_ts;
+}
+
+uint64_t sit_tx_timestamp(void) {
+	return rx_info.tx_ts;
+}
+
+static bool sit_take_msg(uint32_t status, uint8_t* data, uint16_t expected_frame_length) {
 	bool result = false;
-	status_reg = sit_msg_receive();
-	LOG_INF("Test: %08x & %08x", status_reg, DWT_INT_RXFCG_BIT_MASK);
+	status_reg = status;
 	if(status_reg & DWT_INT_RXFCG_BIT_MASK) {
 		/* Clear good RX frame event in the DW IC status register. */
 		dwt_writesysstatuslo(DWT_INT_RXFCG_BIT_MASK);
-		uint16_t frame_length = dwt_getframelength();
+		frame_stats.delivered++;
+		sit_read_rx_info();
+		uint16_t frame_length = rx_info.length;
+		SIT_TRACE(sit_trace_rx_ok, frame_length, 0, status_reg);
 		if (frame_length == expected_frame_length) {
 			dwt_readrxdata(data, frame_length, 0);
 			#ifdef CONFIG_SIT_DIAGNOSTIC
 				get_diagnostic(&diagnostic);
 			#endif
-			result = true;
+			result = sit_frame_valid(data, frame_length);
+			if (!result) {
+				LOG_WRN("Frame of another format or version dropped");
+			}
 		} else {
+			SIT_TRACE(sit_trace_rx_length, frame_length, 0, status_reg);
 			LOG_ERR("RX Frame Length: %u != Expected Frame Length: %u",frame_length, expected_frame_length);
 		}
 	} else {
+		SIT_TRACE(sit_trace_rx_error, 0, 0, status_reg);
 		dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
 		LOG_WRN("sit_checkReceivedMessage() no 'RX Frame Checksum Good'");
 		uint32_t reg2 = dwt_readsysstatuslo();
@@ -153,13 +277,32 @@ bool sit_check_msg(uint8_t* data, uint16_t expected_frame_length) {
 	return result;
 }
 
+bool sit_check_msg(uint8_t* data, uint16_t expected_frame_length) {
+	return sit_take_msg(sit_msg_receive(), data, expected_frame_length);
+}
+
+bool sit_take_msg_id(uint32_t status, msg_id_t id, void* message, uint16_t size) {
+	bool result = false;
+	if(sit_take_msg(status, (uint8_t*)message, size)){
+		header_t *header = (header_t*)message;
+		if(sit_frame_id(header) == id) {
+			result = true;
+		} else {
+			LOG_ERR("sit_take_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(header));
+		}
+	} else {
+		LOG_ERR("sit_take_msg_id(%u,header) fail",(uint8_t)id);
+	}
+	return result;
+}
+
 bool sit_check_msg_id(msg_id_t id, msg_simple_t* message) {
 	bool result = false;
 	if(sit_check_msg((uint8_t*)message, sizeof(msg_simple_t))){
-		if(message->header.id == id) {
+		if(sit_frame_id(&message->header) == id) {
 			result = true;
 		} else {
-			LOG_ERR("Simple MSG mismatch expect id / header id (%u/%u)",(uint8_t)id,(uint8_t)message->header.id);
+			LOG_ERR("Simple MSG mismatch expect id / header id (%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
 		}
 	} else {
 		LOG_ERR("SIT Failed Receive Simple MSG (%u, header) fail",(uint8_t)id);
@@ -170,11 +313,10 @@ bool sit_check_msg_id(msg_id_t id, msg_simple_t* message) {
 bool sit_check_final_msg_id(msg_id_t id, msg_ss_twr_final_t* message) {
 	bool result = false;
 	if(sit_check_msg((uint8_t*)message, sizeof(msg_ss_twr_final_t))){
-		LOG_INF("sit_checkReceivedIdFinalMsg() id: %u & %u", (uint8_t)id, (uint8_t)message->header.id);
-		if(message->header.id == id) {
+		if(sit_frame_id(&message->header) == id) {
 			result = true;
 		} else {
-			LOG_ERR("sit_checkReceivedIdFinalMsg() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)message->header.id);
+			LOG_ERR("sit_checkReceivedIdFinalMsg() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
 		}
 	} else {
 		LOG_ERR("sit_checkReceivedIdFinalMsg(%u,header) fail",(uint8_t)id);
@@ -185,10 +327,10 @@ bool sit_check_final_msg_id(msg_id_t id, msg_ss_twr_final_t* message) {
 bool sit_check_ds_final_msg_id(msg_id_t id, msg_ds_twr_final_t* message) {
 	bool result = false;
 	if(sit_check_msg((uint8_t*)message, sizeof(msg_ds_twr_final_t))){
-		if(message->header.id == id) {
+		if(sit_frame_id(&message->header) == id) {
 			result = true;
 		} else {
-			LOG_ERR("sit_checkReceivedIdFinalMsg() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)message->header.id);
+			LOG_ERR("sit_checkReceivedIdFinalMsg() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
 		}
 	} else {
 		LOG_ERR("sit_checkReceivedIdFinalMsg(%u,header) fail",(uint8_t)id);
@@ -199,10 +341,10 @@ bool sit_check_ds_final_msg_id(msg_id_t id, msg_ds_twr_final_t* message) {
 bool sit_check_ds_resp_msg_id(msg_id_t id, msg_ds_twr_resp_t* message) {
 	bool result = false;
 	if(sit_check_msg((uint8_t*)message, sizeof(msg_ds_twr_resp_t))){
-		if(message->header.id == id) {
+		if(sit_frame_id(&message->header) == id) {
 			result = true;
 		} else {
-			LOG_ERR("sit_check_ds_resp_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)message->header.id);
+			LOG_ERR("sit_check_ds_resp_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
 		}
 	} else {
 		LOG_ERR("sit_check_ds_resp_msg_id(%u,header) fail",(uint8_t)id);
@@ -210,13 +352,27 @@ bool sit_check_ds_resp_msg_id(msg_id_t id, msg_ds_twr_resp_t* message) {
 	return result;
 }
 
+bool sit_check_ds_all_msg_id(msg_id_t id, msg_ds_all_twr_t* message) {
+	bool result = false;
+	if(sit_check_msg((uint8_t*)message, sizeof(msg_ds_all_twr_t))){
+		if(sit_frame_id(&message->header) == id) {
+			result = true;
+		} else {
+			LOG_ERR("sit_check_ds_all_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
+		}
+	} else {
+		LOG_ERR("sit_check_ds_all_msg_id(%u,header) fail",(uint8_t)id);
+	}
+	return result;
+}
+
 bool sit_check_sensing_3_msg_id(msg_id_t id, msg_sensing_3_t * message){
 	bool result = false;
 	if(sit_check_msg((uint8_t*)message, sizeof(msg_sensing_3_t))){
-		if(message->header.id == id) {
+		if(sit_frame_id(&message->header) == id) {
 			result = true;
 		} else {
-			LOG_ERR("sit_check_sensing_3_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)message->header.id);
+			LOG_ERR("sit_check_sensing_3_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
 		}
 	} else {
 		LOG_ERR("sit_check_sensing_3_final_msg_id(%u,header) fail",(uint8_t)id);
@@ -227,10 +383,10 @@ bool sit_check_sensing_3_msg_id(msg_id_t id, msg_sensing_3_t * message){
 bool sit_check_sensing_info_msg_id(msg_id_t id, msg_sensing_info_t * message){
 	bool result = false;
 	if(sit_check_msg((uint8_t*)message, sizeof(msg_sensing_info_t))){
-		if(message->header.id == id) {
+		if(sit_frame_id(&message->header) == id) {
 			result = true;
 		} else {
-			LOG_ERR("sit_check_sensing_info_final_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)message->header.id);
+			LOG_ERR("sit_check_sensing_info_final_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
 		}
 	} else {
 		LOG_ERR("sit_check_sensig_info_msg_id(%u,header) fail",(uint8_t)id);
@@ -238,21 +394,51 @@ bool sit_check_sensing_info_msg_id(msg_id_t id, msg_sensing_info_t * message){
 	return result;
 }
 
+bool sit_check_tdma_beacon_msg_id(msg_id_t id, msg_tdma_beacon_t * message){
+	bool result = false;
+	if(sit_check_msg((uint8_t*)message, sizeof(msg_tdma_beacon_t))){
+		if(sit_frame_id(&message->header) == id) {
+			result = true;
+		} else {
+			LOG_ERR("sit_check_tdma_beacon_msg_id() mismatch id(%u/%u)",(uint8_t)id,(uint8_t)sit_frame_id(&message->header));
+		}
+	} else {
+		LOG_ERR("sit_check_tdma_beacon_msg_id(%u,header) fail",(uint8_t)id);
+	}
+	return result;
+}
+
+bool sit_check_tdoa_msg(msg_tdoa_t * message){
+	bool result = false;
+	if(sit_check_msg((uint8_t*)message, sizeof(msg_tdoa_t))){
+		msg_id_t msg_id = sit_frame_id(&message->header);
+		if(msg_id == tdoa_blink || msg_id == tdoa_sync) {
+			result = true;
+		} else {
+			LOG_ERR("sit_check_tdoa_msg() unexpected id %u",(uint8_t)msg_id);
+		}
+	} else {
+		LOG_ERR("sit_check_tdoa_msg() fail");
+	}
+	return result;
+}
+
+/* The setters only update the shadow, the next TX or RX start writes the changed values */
 void sit_set_rx_tx_delay_and_rx_timeout(uint32_t delay_us, uint16_t timeout) {
-	dwt_setrxaftertxdelay(delay_us);
-	dwt_setrxtimeout(timeout);
+	sit_shadow_set_rx_after_tx_delay(delay_us);
+	sit_shadow_set_rx_timeout(timeout);
 }
 
 void sit_set_rx_after_tx_delay(uint32_t delay_us) {
-	dwt_setrxaftertxdelay(delay_us);
+	sit_shadow_set_rx_after_tx_delay(delay_us);
 }
 
 void sit_set_rx_timeout(uint16_t timeout) {
-	dwt_setrxtimeout(timeout);
+	sit_shadow_set_rx_timeout(timeout);
 }
 
 void sit_set_preamble_detection_timeout(uint16_t timeout) {
-	dwt_setpreambledetecttimeout(timeout);
+	sit_shadow_set_preamble_timeout(timeout);
 }
 
 void recover_tx_errors() {
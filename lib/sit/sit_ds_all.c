@@ -0,0 +1,129 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_ds_all.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief All to all DS-TWR.
+ *
+ * Bookkeeping of the frames of all peers and the DS-TWR calculation for
+ * every pair. The radio handling is in sit.c.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_ds_all.h"
+#include "sit/sit.h"
+#include "sit/sit_profile.h"
+#include "sit/sit_tof.h"
+#include "sit/sit_ts.h"
+
+#include <deca_device_api.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_DS_ALL, LOG_LEVEL_INF);
+
+/* a frame has to fit into a standard 127 byte PHY frame together with the 2 byte FCS */
+BUILD_ASSERT(sizeof(msg_ds_all_twr_t) + 2 <= 127, "CONFIG_SIT_TWR_MAX_RESPONDER too big for ds_all_twr");
+
+uint8_t sit_ds_all_node_index(uint8_t device_id) {
+	return device_id >= 100 ? device_id - 99 : 0;
+}
+
+void sit_ds_all_init(ds_all_ctx_t *ctx, uint8_t device_id, uint8_t nodes) {
+	memset(ctx, 0, sizeof(ds_all_ctx_t));
+	ctx->node = sit_ds_all_node_index(device_id);
+	ctx->nodes = MIN(nodes, DS_ALL_MAX_NODES);
+}
+
+uint32_t sit_ds_all_slot_uus(uint8_t slot, uint8_t nodes) {
+	if (slot == 0) {
+		return 0;
+	}
+	if (slot >= nodes) {
+		return DS_ALL_RESP_DLY_UUS + (nodes - 1) * DS_ALL_SLOT_UUS + DS_ALL_FINAL_DLY_UUS;
+	}
+	return DS_ALL_RESP_DLY_UUS + (slot - 1) * DS_ALL_SLOT_UUS;
+}
+
+void sit_ds_all_fill(const ds_all_ctx_t *ctx, msg_ds_all_twr_t *msg, uint64_t tx_ts) {
+	sit_ts_pack(&msg->tx_ts, tx_ts);
+	msg->rx_mask = 0;
+	for (uint8_t i = 0; i < DS_ALL_MAX_NODES; i++) {
+		if (i < ctx->nodes && ctx->peer[i].valid) {
+			sit_ts_pack(&msg->rx_ts[i], ctx->peer[i].rx_ts);
+			msg->rx_mask |= BIT(i);
+		} else {
+			sit_ts_pack(&msg->rx_ts[i], 0);
+		}
+	}
+	msg->crc = 0;
+}
+
+bool sit_ds_all_span_valid(uint64_t span) {
+	return span <= UINT32_MAX;
+}
+
+void sit_ds_all_tx_done(ds_all_ctx_t *ctx, uint64_t tx_ts) {
+	ctx->tx_ts = tx_ts & SIT_TS_MASK;
+	ctx->tx_valid = true;
+}
+
+bool sit_ds_all_rx(ds_all_ctx_t *ctx, const msg_ds_all_twr_t *msg, uint64_t rx_ts, ds_all_result_t *result) {
+	uint8_t node = sit_ds_all_node_index(msg->header.source);
+	if (node >= ctx->nodes || node == ctx->node) {
+		return false;
+	}
+	ds_all_peer_t *peer = &ctx->peer[node];
+	sit_ts_t peer_tx_ts = sit_ts_unpack(&msg->tx_ts);
+	sit_ts_t peer_rx_ts = sit_ts_unpack(&msg->rx_ts[ctx->node]);
+	rx_ts &= SIT_TS_MASK;
+	bool ret = false;
+
+	/* peer frame 1 -> own frame -> peer frame 2, checked in both clocks */
+	if (peer->valid && ctx->tx_valid && (msg->rx_mask & BIT(ctx->node)) &&
+		sit_ts_before(peer->rx_ts, ctx->tx_ts) && sit_ts_before(ctx->tx_ts, rx_ts) &&
+		sit_ts_before(peer->tx_ts, peer_rx_ts) && sit_ts_before(peer_rx_ts, peer_tx_ts)) {
+		uint64_t round_1 = sit_ts_diff(peer_rx_ts, peer->tx_ts);
+		uint64_t reply_1 = sit_ts_diff(ctx->tx_ts, peer->rx_ts);
+		uint64_t round_2 = sit_ts_diff(rx_ts, ctx->tx_ts);
+		uint64_t reply_2 = sit_ts_diff(peer_tx_ts, peer_rx_ts);
+
+		if (sit_ds_all_span_valid(round_1) && sit_ds_all_span_valid(reply_1) &&
+			sit_ds_all_span_valid(round_2) && sit_ds_all_span_valid(reply_2)) {
+			result->peer_id = msg->header.source;
+			result->time_round_1 = (uint32_t)round_1;
+			result->time_reply_1 = (uint32_t)reply_1;
+			result->time_round_2 = (uint32_t)round_2;
+			result->time_reply_2 = (uint32_t)reply_2;
+			result->distance_mm = sit_tof_to_mm(sit_tof_ds_q8(result->time_round_1, result->time_reply_1,
+															  result->time_round_2, result->time_reply_2));
+			ret = true;
+		} else {
+			LOG_DBG("Span to %u exceeds 32 bit, exchange dropped", msg->header.source);
+		}
+	}
+
+	peer->id = msg->header.source;
+	peer->tx_ts = peer_tx_ts;
+	peer->rx_ts = rx_ts;
+	peer->valid = true;
+	return ret;
+}
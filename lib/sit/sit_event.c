@@ -0,0 +1,305 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_event.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Interrupt driven DW3000 event queue.
+ *
+ * dwt_isr() runs in the workqueue of the DW3000 IRQ (see dw3000_hw.c) and
+ * calls the callbacks below. They only copy the callback data into a
+ * message queue, the ranging thread picks them up in sit_event_wait().
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_event.h"
+#include "sit/sit_frame.h"
+#include "sit/sit_shadow.h"
+
+#include <deca_device_api.h>
+#include <deca_regs.h>
+#include <dw3000_hw.h>
+#include <dw3000_spi.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_EVENT, LOG_LEVEL_INF);
+
+#define SIT_EVENT_INT_MASK (DWT_INT_TXFRS_BIT_MASK | DWT_INT_RXFCG_BIT_MASK | \
+                            SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR)
+
+K_MSGQ_DEFINE(sit_event_queue, sizeof(sit_event_t), CONFIG_SIT_IRQ_EVENT_QUEUE_SIZE, 4);
+
+/* updated from the DW3000 callbacks, read from the BLE thread */
+static struct {
+	atomic_t events;
+	atomic_t dropped;
+	atomic_t timeouts;
+	atomic_t lost;
+} event_stats;
+
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+#define SIT_REG_RX_BUFFER(buffer) ((buffer) ? RX_BUFFER_1_ID : RX_BUFFER_0_ID)
+#define SIT_RDB_STATUS_RXFR(buffer) ((buffer) ? RDB_STATUS_RXFR1_BIT_MASK : RDB_STATUS_RXFR0_BIT_MASK)
+
+/* Frame of the listener as seen in the callback, the payload is still in the RX buffer */
+typedef struct {
+    uint64_t rx_ts;
+    int32_t ci;
+    uint32_t seq;       ///< number of the frame since sit_rx_listen_start()
+    uint16_t length;
+    uint8_t buffer;     ///< RX buffer of the frame
+} sit_rx_frame_info_t;
+
+K_MSGQ_DEFINE(sit_rx_frame_queue, sizeof(sit_rx_frame_info_t), CONFIG_SIT_RX_FRAME_QUEUE_SIZE, 4);
+
+static volatile bool rx_listening;
+/* host side RX buffer, dwt_isr() hands it back after every good frame */
+static uint8_t rx_buffer;
+static atomic_t rx_seq;
+#endif
+static struct {
+	atomic_t frames;
+	atomic_t dropped;
+	atomic_t errors;
+	atomic_t overruns;
+} rx_stats;
+
+static void sit_event_put(sit_event_type_t type, const dwt_cb_data_t *cb_data) {
+	sit_event_t event = {
+		.type = type,
+		.status = cb_data->status,
+		.status_hi = cb_data->status_hi,
+		.datalength = cb_data->datalength,
+		.rx_flags = cb_data->rx_flags,
+	};
+	if (k_msgq_put(&sit_event_queue, &event, K_NO_WAIT) == 0) {
+		atomic_inc(&event_stats.events);
+	} else {
+		atomic_inc(&event_stats.dropped);
+	}
+}
+
+static void sit_cb_tx_done(const dwt_cb_data_t *cb_data) {
+	sit_event_put(sit_evt_tx_done, cb_data);
+}
+
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+static void sit_rx_listen_frame(const dwt_cb_data_t *cb_data) {
+	sit_rx_frame_info_t info = {
+		.length = cb_data->datalength,
+		.buffer = rx_buffer,
+		.seq = (uint32_t)atomic_inc(&rx_seq) + 1,
+	};
+	/* dwt_isr() frees the buffer after the callback, the next frame goes into the other one */
+	rx_buffer ^= 1;
+	if (info.length > SIT_RX_FRAME_MAX_LEN) {
+		atomic_inc(&rx_stats.errors);
+		return;
+	}
+	/* only the timestamp and the carrier integrator, the payload is read by the consumer */
+	uint8_t ts_tab[5];
+	dwt_readrxtimestamp(ts_tab);
+	info.ci = dwt_readcarrierintegrator();
+	info.rx_ts = 0;
+	for (int i = 4; i >= 0; i--) {
+		info.rx_ts = (info.rx_ts << 8) | ts_tab[i];
+	}
+	if (k_msgq_put(&sit_rx_frame_queue, &info, K_NO_WAIT) == 0) {
+		atomic_inc(&rx_stats.frames);
+	} else {
+		atomic_inc(&rx_stats.dropped);
+	}
+}
+#endif
+
+static void sit_cb_rx_ok(const dwt_cb_data_t *cb_data) {
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+	if (rx_listening) {
+		sit_rx_listen_frame(cb_data);
+		return;
+	}
+#endif
+	sit_event_put(sit_evt_rx_ok, cb_data);
+}
+
+static void sit_cb_rx_timeout(const dwt_cb_data_t *cb_data) {
+	sit_event_put(sit_evt_rx_timeout, cb_data);
+}
+
+static void sit_cb_rx_error(const dwt_cb_data_t *cb_data) {
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+	if (rx_listening) {
+		/* auto re-enable, the receiver is already back in RX */
+		atomic_inc(&rx_stats.errors);
+		return;
+	}
+#endif
+	sit_event_put(sit_evt_rx_error, cb_data);
+}
+
+int sit_event_init(void) {
+	dwt_setcallbacks(sit_cb_tx_done, sit_cb_rx_ok, sit_cb_rx_timeout, sit_cb_rx_error, NULL, NULL, NULL);
+
+	/* Clear the init events, otherwise the IRQ line stays high and no edge will be seen */
+	dwt_writesysstatuslo(DWT_INT_RCINIT_BIT_MASK | DWT_INT_SPIRDY_BIT_MASK);
+	dwt_setinterrupt(SIT_EVENT_INT_MASK, 0, DWT_ENABLE_INT_ONLY);
+
+	k_msgq_purge(&sit_event_queue);
+	int ret = dw3000_hw_init_interrupt();
+	if (ret < 0) {
+		LOG_ERR("DW3000 IRQ init failed: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("DW3000 interrupt mode enabled");
+	return 0;
+}
+
+void sit_event_restore(void) {
+	dwt_setinterrupt(SIT_EVENT_INT_MASK, 0, DWT_ENABLE_INT_ONLY);
+}
+
+void sit_event_flush(void) {
+	k_msgq_purge(&sit_event_queue);
+}
+
+static bool sit_event_match(const sit_event_t *evt, uint32_t lo_mask, uint32_t hi_mask) {
+	return (evt->status & lo_mask) || (evt->status_hi & hi_mask);
+}
+
+void sit_event_wait(uint32_t lo_mask, uint32_t hi_mask, sit_event_t *event) {
+	sit_event_t evt;
+	for (;;) {
+		if (k_msgq_get(&sit_event_queue, &evt, K_MSEC(CONFIG_SIT_IRQ_EVENT_TIMEOUT_MS)) == 0) {
+			if (sit_event_match(&evt, lo_mask, hi_mask)) {
+				break;
+			}
+			continue;
+		}
+		/* No event in time, the status register shows an event whose IRQ edge was lost */
+		atomic_inc(&event_stats.timeouts);
+		evt = (sit_event_t){
+			.type = sit_evt_tx_done,
+			.status = dwt_readsysstatuslo(),
+			.status_hi = (uint16_t)dwt_readsysstatushi(),
+		};
+		if (sit_event_match(&evt, lo_mask, hi_mask)) {
+			atomic_inc(&event_stats.lost);
+			if (evt.status & DWT_INT_RXFCG_BIT_MASK) {
+				evt.type = sit_evt_rx_ok;
+				evt.datalength = dwt_getframelength();
+			} else if (evt.status & SYS_STATUS_ALL_RX_TO) {
+				evt.type = sit_evt_rx_timeout;
+			} else if (evt.status & SYS_STATUS_ALL_RX_ERR) {
+				evt.type = sit_evt_rx_error;
+			}
+			break;
+		}
+	}
+	if (event != NULL) {
+		*event = evt;
+	}
+}
+
+void sit_event_get_stats(sit_event_stats_t *stats) {
+	stats->events = (uint32_t)atomic_get(&event_stats.events);
+	stats->dropped = (uint32_t)atomic_get(&event_stats.dropped);
+	stats->timeouts = (uint32_t)atomic_get(&event_stats.timeouts);
+	stats->lost = (uint32_t)atomic_get(&event_stats.lost);
+}
+
+#ifdef CONFIG_SIT_RX_DOUBLE_BUFFER
+int sit_rx_listen_start(void) {
+	dwt_forcetrxoff();
+	k_msgq_purge(&sit_rx_frame_queue);
+	dwt_setdblrxbuffmode(DBL_BUF_STATE_EN, DBL_BUF_MODE_AUTO);
+	rx_buffer = 0;
+	atomic_set(&rx_seq, 0);
+	sit_shadow_set_preamble_timeout(0);
+	sit_shadow_set_rx_timeout(0);
+	sit_shadow_flush();
+	rx_listening = true;
+	if (dwt_rxenable(DWT_START_RX_IMMEDIATE) != DWT_SUCCESS) {
+		sit_rx_listen_stop();
+		LOG_ERR("Listener RX enable failed");
+		return -EIO;
+	}
+	return 0;
+}
+
+void sit_rx_listen_stop(void) {
+	rx_listening = false;
+	dwt_forcetrxoff();
+	dwt_setdblrxbuffmode(DBL_BUF_STATE_DIS, DBL_BUF_MODE_MAN);
+	k_msgq_purge(&sit_rx_frame_queue);
+	sit_event_flush();
+}
+
+/***************************************************************************
+ * Read the payload of a listener frame. The buffer of frame n is reused
+ * by frame n + 2, which can only start after frame n + 1 is complete. If
+ * frame n + 1 is not complete after the read, the payload is intact.
+ *
+****************************************************************************/
+static bool sit_rx_listen_read(const sit_rx_frame_info_t *info, sit_rx_frame_t *frame) {
+	uint8_t rdb_status;
+	uint8_t next_rxfr = SIT_RDB_STATUS_RXFR(info->buffer ^ 1);
+
+	if (dw3000_spi_read_reg(SIT_REG_RX_BUFFER(info->buffer), info->length, frame->data) != 0 ||
+		dw3000_spi_read_reg(RDB_STATUS_ID, sizeof(rdb_status), &rdb_status) != 0) {
+		atomic_inc(&rx_stats.errors);
+		return false;
+	}
+	if ((uint32_t)atomic_get(&rx_seq) != info->seq || (rdb_status & next_rxfr)) {
+		atomic_inc(&rx_stats.overruns);
+		return false;
+	}
+	if (!sit_frame_valid(frame->data, info->length)) {
+		atomic_inc(&rx_stats.errors);
+		return false;
+	}
+	frame->rx_ts = info->rx_ts;
+	frame->ci = info->ci;
+	frame->length = info->length;
+	return true;
+}
+
+bool sit_rx_listen_get(sit_rx_frame_t *frame, k_timeout_t timeout) {
+	sit_rx_frame_info_t info;
+	while (k_msgq_get(&sit_rx_frame_queue, &info, timeout) == 0) {
+		if (sit_rx_listen_read(&info, frame)) {
+			return true;
+		}
+	}
+	return false;
+}
+#endif
+
+void sit_rx_get_stats(sit_rx_stats_t *stats) {
+	stats->frames = (uint32_t)atomic_get(&rx_stats.frames);
+	stats->dropped = (uint32_t)atomic_get(&rx_stats.dropped);
+	stats->errors = (uint32_t)atomic_get(&rx_stats.errors);
+	stats->overruns = (uint32_t)atomic_get(&rx_stats.overruns);
+	stats->events = (uint32_t)atomic_get(&event_stats.events);
+	stats->events_dropped = (uint32_t)atomic_get(&event_stats.dropped);
+}
@@ -0,0 +1,123 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_frame.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Frame format checks and airtime of the SIT frames.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_frame.h"
+#include "sit/sit_config.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_FRAME, LOG_LEVEL_INF);
+
+/* Symbol times in ps (IEEE 802.15.4 HRP UWB PHY) */
+#define PREAMBLE_SYMBOL_PRF64_PS 1017630ULL
+#define PREAMBLE_SYMBOL_PRF16_PS 993590ULL
+#define DATA_BIT_6M8_PS 128210ULL
+#define DATA_BIT_850K_PS 1025640ULL
+
+#define PHR_BITS 19
+#define RS_BLOCK_BITS 330
+#define RS_PARITY_BITS 48
+
+static uint32_t preamble_symbols(dwt_tx_plen_e plen) {
+	switch (plen) {
+	case DWT_PLEN_32: return 32;
+	case DWT_PLEN_64: return 64;
+	case DWT_PLEN_72: return 72;
+	case DWT_PLEN_128: return 128;
+	case DWT_PLEN_256: return 256;
+	case DWT_PLEN_512: return 512;
+	case DWT_PLEN_1024: return 1024;
+	case DWT_PLEN_1536: return 1536;
+	case DWT_PLEN_2048: return 2048;
+	case DWT_PLEN_4096: return 4096;
+	default: return 0;
+	}
+}
+
+msg_id_t sit_frame_id(const header_t *header) {
+	return (msg_id_t)(header->msg & SIT_MSG_ID_MASK);
+}
+
+uint8_t sit_frame_version(const header_t *header) {
+	return header->msg >> SIT_MSG_VERSION_SHIFT;
+}
+
+bool sit_frame_valid(const uint8_t *data, uint16_t length) {
+	const header_t *header = (const header_t *)data;
+	if (length < sizeof(header_t) + 2) {
+		return false;
+	}
+	if (header->frame_ctrl[0] != (SIT_FRAME_CTRL & 0xFF) || header->frame_ctrl[1] != (SIT_FRAME_CTRL >> 8)) {
+		return false;
+	}
+	return sit_frame_version(header) == SIT_FRAME_VERSION;
+}
+
+uint32_t sit_frame_airtime_ns(const dwt_config_t *config, uint16_t length) {
+	/* preamble codes 9..24 use the 64 MHz PRF */
+	uint64_t symbol_ps = config->txCode >= 9 ? PREAMBLE_SYMBOL_PRF64_PS : PREAMBLE_SYMBOL_PRF16_PS;
+	uint64_t bit_ps = config->dataRate == DWT_BR_850K ? DATA_BIT_850K_PS : DATA_BIT_6M8_PS;
+	uint32_t sfd = config->sfdType == DWT_SFD_DW_16 ? DWT_SFD_LEN16 : DWT_SFD_LEN8;
+
+	uint64_t airtime_ps = (preamble_symbols(config->txPreambLength) + sfd) * symbol_ps;
+	if (config->stsMode != DWT_STS_MODE_OFF) {
+		airtime_ps += (32ULL << config->stsLength) * symbol_ps;
+	}
+	airtime_ps += PHR_BITS * (config->phrRate == DWT_PHRRATE_DTA ? bit_ps : DATA_BIT_850K_PS);
+
+	uint32_t bits = length * 8;
+	bits += RS_PARITY_BITS * ((bits + RS_BLOCK_BITS - 1) / RS_BLOCK_BITS);
+	airtime_ps += bits * bit_ps;
+
+	return (uint32_t)((airtime_ps + 500) / 1000);
+}
+
+void sit_frame_log_airtime(const dwt_config_t *config) {
+	static const struct {
+		const char *name;
+		uint16_t length;
+	} frames[] = {
+		{"simple", sizeof(msg_simple_t)},
+		{"ss_twr_final", sizeof(msg_ss_twr_final_t)},
+		{"ds_twr_final", sizeof(msg_ds_twr_final_t)},
+		{"ds_twr_resp", sizeof(msg_ds_twr_resp_t)},
+		{"ds_all_twr", sizeof(msg_ds_all_twr_t)},
+		{"tdma_beacon", sizeof(msg_tdma_beacon_t)},
+		{"tdoa", sizeof(msg_tdoa_t)},
+	};
+	for (size_t i = 0; i < ARRAY_SIZE(frames); i++) {
+		LOG_INF("%s: %u bytes, %u ns", frames[i].name, frames[i].length,
+			sit_frame_airtime_ns(config, frames[i].length));
+	}
+	/* poll, response, final, final response */
+	uint32_t exchange_ns = 2 * sit_frame_airtime_ns(config, sizeof(msg_simple_t)) +
+			       sit_frame_airtime_ns(config, sizeof(msg_ds_twr_final_t)) +
+			       sit_frame_airtime_ns(config, sizeof(msg_ds_twr_resp_t));
+	LOG_INF("DS-TWR exchange: %u ns on air", exchange_ns);
+}
@@ -0,0 +1,318 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_position.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Position solver of the tag.
+ *
+ * Minimises sum (|p - a_i| - r_i)^2 with Gauss-Newton:
+ * J_i = (p - a_i) / |p - a_i|, (J^T J) dp = -J^T res
+ * TDoA minimises sum (|p - a_i| - |p - a_0| - d_i)^2 the same way with
+ * J_i = (p - a_i) / |p - a_i| - (p - a_0) / |p - a_0|
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_position.h"
+#include "sit/sit.h"
+#include "sit/sit_ts.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_POSITION, LOG_LEVEL_INF);
+
+#ifdef CONFIG_SIT_POSITION_3D
+#define POSITION_DIM 3
+#else
+#define POSITION_DIM 2
+#endif
+
+/* Iterations end if the step is below 1 mm */
+#define POSITION_STEP_MIN 1e-3f
+/* Lower bound of |p - a_i|, the Jacobian is undefined on the anchor */
+#define POSITION_DIST_MIN 1e-3f
+
+typedef struct {
+    float pos[3];
+    bool valid;
+    float range;        // TDoA: range difference to the first anchor
+    int64_t range_ms;
+    bool range_valid;
+} anchor_t;
+
+/* The anchors are set from the BLE thread and ranged/solved in the ranging thread */
+K_MUTEX_DEFINE(anchors_lock);
+static anchor_t anchors[SIT_POSITION_MAX_ANCHORS];
+static float last_pos[3];
+static bool last_valid;
+/* Changed with the anchors, a solve of an older geometry doesn't store its position */
+static uint32_t anchors_gen;
+
+void sit_position_reset(void) {
+	k_mutex_lock(&anchors_lock, K_FOREVER);
+	memset(anchors, 0, sizeof(anchors));
+	last_valid = false;
+	anchors_gen++;
+	k_mutex_unlock(&anchors_lock);
+}
+
+int sit_position_set_anchor(uint8_t index, float x, float y, float z) {
+	if (index >= SIT_POSITION_MAX_ANCHORS) {
+		return -EINVAL;
+	}
+	k_mutex_lock(&anchors_lock, K_FOREVER);
+	anchors[index].pos[0] = x;
+	anchors[index].pos[1] = y;
+	anchors[index].pos[2] = z;
+	anchors[index].valid = true;
+	anchors[index].range_valid = false;
+	last_valid = false;
+	anchors_gen++;
+	k_mutex_unlock(&anchors_lock);
+	LOG_INF("Anchor %d: %d %d %d mm", index, (int)(x * 1000), (int)(y * 1000), (int)(z * 1000));
+	return 0;
+}
+
+bool sit_position_enabled(void) {
+	uint8_t count = 0;
+	k_mutex_lock(&anchors_lock, K_FOREVER);
+	for (int i = 0; i < SIT_POSITION_MAX_ANCHORS; i++) {
+		count += anchors[i].valid;
+	}
+	k_mutex_unlock(&anchors_lock);
+	return count > POSITION_DIM;
+}
+
+void sit_position_add_range(uint8_t index, int32_t distance_mm) {
+	if (index >= SIT_POSITION_MAX_ANCHORS) {
+		return;
+	}
+	k_mutex_lock(&anchors_lock, K_FOREVER);
+	if (anchors[index].valid) {
+		anchors[index].range = distance_mm / 1000.0f;
+		anchors[index].range_ms = k_uptime_get();
+		anchors[index].range_valid = true;
+	}
+	k_mutex_unlock(&anchors_lock);
+}
+
+/* Unit vector from the anchor to p, returns |p - a| */
+static float position_unit(const anchor_t *anchor, const float *p, float *u) {
+	float d[3];
+	for (int k = 0; k < 3; k++) {
+		d[k] = p[k] - anchor->pos[k];
+	}
+	float dist = MAX(sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]), POSITION_DIST_MIN);
+	for (int k = 0; k < 3; k++) {
+		u[k] = d[k] / dist;
+	}
+	return dist;
+}
+
+/* Normal equations of the current position, returns the sum of the squared residuals.
+ * With tdoa the ranges are range differences to used[0]. */
+static float position_normal(const anchor_t *used, uint8_t count, bool tdoa, const float *p,
+			     float jtj[POSITION_DIM][POSITION_DIM], float jtr[POSITION_DIM]) {
+	float sq = 0.0f;
+	float u0[3] = {0.0f, 0.0f, 0.0f};
+	float dist0 = 0.0f;
+	memset(jtj, 0, sizeof(float) * POSITION_DIM * POSITION_DIM);
+	memset(jtr, 0, sizeof(float) * POSITION_DIM);
+	if (tdoa) {
+		dist0 = position_unit(&used[0], p, u0);
+	}
+	for (uint8_t i = tdoa ? 1 : 0; i < count; i++) {
+		float j[3];
+		float res = position_unit(&used[i], p, j) - dist0 - used[i].range;
+		sq += res * res;
+		for (int k = 0; k < 3; k++) {
+			j[k] -= u0[k];
+		}
+		for (int r = 0; r < POSITION_DIM; r++) {
+			jtr[r] += j[r] * res;
+			for (int c = 0; c < POSITION_DIM; c++) {
+				jtj[r][c] += j[r] * j[c];
+			}
+		}
+	}
+	return sq;
+}
+
+/* Solve a x = b with Cramer's rule, false if a is singular */
+static bool position_linear_solve(float a[POSITION_DIM][POSITION_DIM], const float *b, float *x) {
+#if POSITION_DIM == 3
+	float det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+		    a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+		    a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+	if (fabsf(det) < 1e-9f) {
+		return false;
+	}
+	x[0] = (b[0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+		a[0][1] * (b[1] * a[2][2] - a[1][2] * b[2]) +
+		a[0][2] * (b[1] * a[2][1] - a[1][1] * b[2])) / det;
+	x[1] = (a[0][0] * (b[1] * a[2][2] - a[1][2] * b[2]) -
+		b[0] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+		a[0][2] * (a[1][0] * b[2] - b[1] * a[2][0])) / det;
+	x[2] = (a[0][0] * (a[1][1] * b[2] - b[1] * a[2][1]) -
+		a[0][1] * (a[1][0] * b[2] - b[1] * a[2][0]) +
+		b[0] * (a[1][0] * a[2][1] - a[1][1] * a[2][0])) / det;
+#else
+	float det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+	if (fabsf(det) < 1e-9f) {
+		return false;
+	}
+	x[0] = (b[0] * a[1][1] - a[0][1] * b[1]) / det;
+	x[1] = (a[0][0] * b[1] - b[0] * a[1][0]) / det;
+#endif
+	return true;
+}
+
+/* Gauss-Newton from the start value p, fills the position on success */
+static bool position_iterate(const anchor_t *used, uint8_t count, bool tdoa, float *p, sit_position_t *position) {
+	float jtj[POSITION_DIM][POSITION_DIM];
+	float jtr[POSITION_DIM];
+	float step[POSITION_DIM];
+	uint8_t iterations = 0;
+	while (iterations < CONFIG_SIT_POSITION_MAX_ITERATIONS) {
+		position_normal(used, count, tdoa, p, jtj, jtr);
+		for (int k = 0; k < POSITION_DIM; k++) {
+			jtr[k] = -jtr[k];
+		}
+		if (!position_linear_solve(jtj, jtr, step)) {
+			LOG_WRN("Anchor geometry is singular");
+			return false;
+		}
+		iterations++;
+		float step_sq = 0.0f;
+		for (int k = 0; k < POSITION_DIM; k++) {
+			p[k] += step[k];
+			step_sq += step[k] * step[k];
+		}
+		if (step_sq < POSITION_STEP_MIN * POSITION_STEP_MIN) {
+			break;
+		}
+	}
+	float sq = position_normal(used, count, tdoa, p, jtj, jtr);
+
+	if (!isfinite(p[0]) || !isfinite(p[1]) || !isfinite(p[2])) {
+		return false;
+	}
+	position->x = p[0];
+	position->y = p[1];
+	position->z = p[2];
+	position->residual = sqrtf(sq / (tdoa ? count - 1 : count));
+	position->anchors = count;
+	position->iterations = iterations;
+	return true;
+}
+
+/* Start value of the next solve, NULL restarts at the anchor centroid */
+static void position_store(const float *p, uint32_t gen) {
+	k_mutex_lock(&anchors_lock, K_FOREVER);
+	if (gen != anchors_gen) {
+		k_mutex_unlock(&anchors_lock);
+		return;
+	}
+	last_valid = p != NULL;
+	if (last_valid) {
+		memcpy(last_pos, p, sizeof(last_pos));
+	}
+	k_mutex_unlock(&anchors_lock);
+}
+
+bool sit_position_solve(sit_position_t *position) {
+	/* copy of the anchors, the solver runs without holding the lock */
+	anchor_t used[SIT_POSITION_MAX_ANCHORS];
+	uint8_t count = 0;
+	int64_t now = k_uptime_get();
+	float p[3] = {0.0f, 0.0f, CONFIG_SIT_POSITION_TAG_Z_MM / 1000.0f};
+	bool start_valid;
+	uint32_t gen;
+
+	k_mutex_lock(&anchors_lock, K_FOREVER);
+	for (int i = 0; i < SIT_POSITION_MAX_ANCHORS; i++) {
+		if (anchors[i].valid && anchors[i].range_valid &&
+		    now - anchors[i].range_ms <= CONFIG_SIT_POSITION_MAX_AGE_MS) {
+			used[count++] = anchors[i];
+		}
+	}
+	gen = anchors_gen;
+	start_valid = last_valid;
+	if (start_valid) {
+		memcpy(p, last_pos, sizeof(p));
+	}
+	k_mutex_unlock(&anchors_lock);
+	if (count <= POSITION_DIM) {
+		return false;
+	}
+
+	if (!start_valid) {
+		/* centroid of the anchors, only the solved axes */
+		for (int k = 0; k < POSITION_DIM; k++) {
+			p[k] = 0.0f;
+			for (uint8_t i = 0; i < count; i++) {
+				p[k] += used[i].pos[k] / count;
+			}
+		}
+	}
+
+	if (!position_iterate(used, count, false, p, position)) {
+		position_store(NULL, gen);
+		return false;
+	}
+	position_store(p, gen);
+	return true;
+}
+
+double sit_position_tdoa_time(const json_tdoa_data_t *record, float sync_distance) {
+	double period = (double)(SIT_TS_MASK + 1);
+	/* anchor clock ticks since the sync, in reference clock ticks */
+	double elapsed = (double)sit_ts_diff(record->rx_ts, record->sync_rx_ts) / (1.0 + record->clock_offset);
+	double sync_tof = sync_distance / (double)SPEED_OF_LIGHT / DWT_TIME_UNITS;
+	return fmod((double)record->sync_tx_ts + sync_tof + elapsed, period) * DWT_TIME_UNITS;
+}
+
+bool sit_position_solve_tdoa(const sit_position_tdoa_t *obs, uint8_t count, sit_position_t *position) {
+	anchor_t used[SIT_POSITION_MAX_ANCHORS];
+	double period = (double)(SIT_TS_MASK + 1) * DWT_TIME_UNITS;
+	float p[3] = {0.0f, 0.0f, CONFIG_SIT_POSITION_TAG_Z_MM / 1000.0f};
+
+	if (count <= POSITION_DIM + 1 || count > SIT_POSITION_MAX_ANCHORS) {
+		return false;
+	}
+	for (uint8_t i = 0; i < count; i++) {
+		memcpy(used[i].pos, obs[i].pos, sizeof(used[i].pos));
+		/* the RX times may be on both sides of a timestamp wrap */
+		used[i].range = (float)(remainder(obs[i].rx_time - obs[0].rx_time, period) * SPEED_OF_LIGHT);
+	}
+	for (int k = 0; k < POSITION_DIM; k++) {
+		p[k] = 0.0f;
+		for (uint8_t i = 0; i < count; i++) {
+			p[k] += used[i].pos[k] / count;
+		}
+	}
+	return position_iterate(used, count, true, p, position);
+}
@@ -0,0 +1,158 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_profile.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief PHY profiles for the rate versus range trade-off.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_profile.h"
+#include "sit/sit.h"
+#include "sit/sit_config.h"
+#include "sit/sit_frame.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_PROFILE, LOG_LEVEL_INF);
+
+/* Margin of set_resp_rx_timeout() */
+#define PROFILE_RX_TIMEOUT_MARGIN_UUS 500
+
+static const sit_profile_t profiles[] = {
+	{"fast", DWT_PLEN_64, DWT_PAC8, DWT_BR_6M8, DWT_SFD_DW_8},
+	{"short", DWT_PLEN_128, DWT_PAC8, DWT_BR_6M8, DWT_SFD_DW_8},
+	{"default", DWT_PLEN_512, DWT_PAC32, DWT_BR_6M8, DWT_SFD_DW_8},
+	{"long", DWT_PLEN_1024, DWT_PAC32, DWT_BR_850K, DWT_SFD_DW_16},
+};
+
+/* sit_device_config starts with the default profile */
+static const sit_profile_t *active = &profiles[2];
+static const sit_profile_t *selected = &profiles[2];
+
+static uint32_t plen_symbols(dwt_tx_plen_e plen) {
+	switch (plen) {
+	case DWT_PLEN_32: return 32;
+	case DWT_PLEN_64: return 64;
+	case DWT_PLEN_72: return 72;
+	case DWT_PLEN_128: return 128;
+	case DWT_PLEN_256: return 256;
+	case DWT_PLEN_512: return 512;
+	case DWT_PLEN_1024: return 1024;
+	case DWT_PLEN_1536: return 1536;
+	case DWT_PLEN_2048: return 2048;
+	case DWT_PLEN_4096: return 4096;
+	default: return 0;
+	}
+}
+
+static uint32_t pac_symbols(dwt_pac_size_e pac) {
+	switch (pac) {
+	case DWT_PAC4: return 4;
+	case DWT_PAC8: return 8;
+	case DWT_PAC16: return 16;
+	case DWT_PAC32:
+	default: return 32;
+	}
+}
+
+/* 1 uus = 512 / 499.2 us */
+static uint32_t ns_to_uus(uint32_t ns) {
+	return (uint32_t)(((uint64_t)ns * 39 + 39999) / 40000);
+}
+
+int sit_profile_select(const char *name) {
+	for (size_t i = 0; i < ARRAY_SIZE(profiles); i++) {
+		if (strcmp(profiles[i].name, name) == 0) {
+			selected = &profiles[i];
+			return 0;
+		}
+	}
+	LOG_ERR("Unknown profile: %s", name);
+	return -EINVAL;
+}
+
+int sit_profile_apply(void) {
+	const sit_profile_t *profile = selected;
+	if (profile == active) {
+		return 0;
+	}
+	uint32_t sfd_len = profile->sfd == DWT_SFD_DW_16 ? DWT_SFD_LEN16 : DWT_SFD_LEN8;
+	sit_device_config.txPreambLength = profile->plen;
+	sit_device_config.rxPAC = profile->pac;
+	sit_device_config.dataRate = profile->data_rate;
+	sit_device_config.sfdType = profile->sfd;
+	/* preamble length + 1 + SFD length - PAC size */
+	sit_device_config.sfdTO = (uint16_t)(plen_symbols(profile->plen) + 1 + sfd_len - pac_symbols(profile->pac));
+	dwt_forcetrxoff();
+	if (dwt_configure(&sit_device_config) != DWT_SUCCESS) {
+		LOG_ERR("dwt_configure failed for profile %s", profile->name);
+		return -EIO;
+	}
+	active = profile;
+	LOG_INF("Profile %s", profile->name);
+	sit_radio_restore();
+	return 0;
+}
+
+const sit_profile_t *sit_profile_get(void) {
+	return active;
+}
+
+uint32_t sit_profile_preamble_symbols(void) {
+	return plen_symbols(active->plen);
+}
+
+uint32_t sit_profile_shr_uus(void) {
+	/* airtime without PHR and data */
+	uint32_t sfd_len = active->sfd == DWT_SFD_DW_16 ? DWT_SFD_LEN16 : DWT_SFD_LEN8;
+	return ns_to_uus((plen_symbols(active->plen) + sfd_len) * 1018);
+}
+
+uint32_t sit_profile_airtime_uus(uint16_t length) {
+	return ns_to_uus(sit_frame_airtime_ns(&sit_device_config, length));
+}
+
+uint32_t sit_profile_rx_delay_uus(void) {
+	uint32_t plen = plen_symbols(active->plen);
+	/* the standard delays of the Qorvo examples are made for 128 symbols */
+	uint32_t delay = plen > 128 ? plen - 128 : 0;
+	if (active->data_rate == DWT_BR_850K) {
+		delay += 200;
+	}
+	return delay;
+}
+
+uint32_t sit_profile_rx_timeout_uus(uint32_t window_uus) {
+	return window_uus + sit_profile_rx_delay_uus() + PROFILE_RX_TIMEOUT_MARGIN_UUS;
+}
+
+uint16_t sit_profile_preamble_timeout_pac(uint32_t window_uus) {
+	uint32_t pac = pac_symbols(active->pac);
+	/* the preamble has to start within the window, plus the preamble itself */
+	uint32_t symbols = window_uus + plen_symbols(active->plen);
+	return (uint16_t)MIN((symbols + pac - 1) / pac, UINT16_MAX);
+}
@@ -0,0 +1,231 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_range_filter.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Per responder filter of the TWR ranges.
+ *
+ * Kalman state [d, v] in m and m/s, F = [1 dt; 0 1], H = [1 0],
+ * Q = a^2 * [dt^4/4 dt^3/2; dt^3/2 dt^2]
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_range_filter.h"
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_RANGE_FILTER, LOG_LEVEL_INF);
+
+#define FILTER_COUNT CONFIG_SIT_TWR_MAX_RESPONDER
+
+/* rssi - fpi above this gap in dB means a weak first path */
+#define FILTER_FP_GAP_DB 6.0f
+
+typedef struct {
+    bool valid;
+    int64_t update_ms;
+    uint16_t rejected;      ///< rejected ranges in a row
+    uint16_t decimation;
+#ifdef CONFIG_SIT_RANGE_FILTER_KALMAN
+    float d;
+    float v;
+    float p[2][2];
+#endif
+#ifdef CONFIG_SIT_RANGE_FILTER_MEDIAN
+    int32_t window[CONFIG_SIT_RANGE_FILTER_MEDIAN_K];
+    uint8_t count;
+    uint8_t next;
+    uint8_t nlos_run;       ///< NLOS ranges in a row
+#endif
+} range_filter_t;
+
+static range_filter_t filters[FILTER_COUNT];
+static sit_range_filter_stats_t filter_stats;
+
+void sit_range_filter_reset(void) {
+	memset(filters, 0, sizeof(filters));
+	memset(&filter_stats, 0, sizeof(filter_stats));
+}
+
+static range_filter_t *range_filter_get(uint8_t responder_id) {
+	if (responder_id < 100 || responder_id - 100 >= FILTER_COUNT) {
+		return NULL;
+	}
+	return &filters[responder_id - 100];
+}
+
+#if defined(CONFIG_SIT_RANGE_FILTER_KALMAN) || defined(CONFIG_SIT_RANGE_FILTER_MEDIAN)
+static bool range_filter_nlos(const diagnostic_info *quality) {
+	return quality != NULL && quality->nlos >= 100;
+}
+#endif
+
+#ifdef CONFIG_SIT_RANGE_FILTER_KALMAN
+/* Measurement noise in m, raised for NLOS and a weak first path */
+static float range_filter_sigma(const diagnostic_info *quality) {
+	float sigma = CONFIG_SIT_RANGE_FILTER_SIGMA_MM / 1000.0f;
+	if (quality == NULL) {
+		return sigma;
+	}
+	float scale = range_filter_nlos(quality) ? 4.0f : 1.0f;
+	float gap = quality->rssi - quality->fpi;
+	if (gap > FILTER_FP_GAP_DB) {
+		scale += (gap - FILTER_FP_GAP_DB) / FILTER_FP_GAP_DB;
+	}
+	return sigma * scale;
+}
+
+static void range_filter_start(range_filter_t *f, float z, float sigma) {
+	f->d = z;
+	f->v = 0.0f;
+	f->p[0][0] = sigma * sigma;
+	f->p[0][1] = 0.0f;
+	f->p[1][0] = 0.0f;
+	/* velocity is unknown, 1 m/s standard deviation */
+	f->p[1][1] = 1.0f;
+	f->valid = true;
+}
+
+static bool range_filter_step(range_filter_t *f, int32_t distance_mm, const diagnostic_info *quality, int64_t now) {
+	float z = distance_mm / 1000.0f;
+	float sigma = range_filter_sigma(quality);
+	if (!f->valid) {
+		range_filter_start(f, z, sigma);
+		return true;
+	}
+
+	/* predict */
+	float dt = (now - f->update_ms) / 1000.0f;
+	float q = (CONFIG_SIT_RANGE_FILTER_ACCEL_MM_S2 / 1000.0f) * (CONFIG_SIT_RANGE_FILTER_ACCEL_MM_S2 / 1000.0f);
+	float dt2 = dt * dt;
+	float d = f->d + f->v * dt;
+	float p00 = f->p[0][0] + dt * (f->p[1][0] + f->p[0][1]) + dt2 * f->p[1][1] + q * dt2 * dt2 / 4.0f;
+	float p01 = f->p[0][1] + dt * f->p[1][1] + q * dt2 * dt / 2.0f;
+	float p10 = f->p[1][0] + dt * f->p[1][1] + q * dt2 * dt / 2.0f;
+	float p11 = f->p[1][1] + q * dt2;
+
+	/* innovation gate */
+	float y = z - d;
+	float s = p00 + sigma * sigma;
+	float gate = CONFIG_SIT_RANGE_FILTER_GATE;
+	if (y * y > gate * gate * s) {
+		if (++f->rejected < CONFIG_SIT_RANGE_FILTER_MAX_REJECTED) {
+			return false;
+		}
+		/* the filter lost the track, e.g. after a jump of the tag */
+		filter_stats.resets++;
+		range_filter_start(f, z, sigma);
+		return true;
+	}
+
+	/* update */
+	float k0 = p00 / s;
+	float k1 = p10 / s;
+	f->d = d + k0 * y;
+	f->v = f->v + k1 * y;
+	f->p[0][0] = p00 - k0 * p00;
+	f->p[0][1] = p01 - k0 * p01;
+	f->p[1][0] = p10 - k1 * p00;
+	f->p[1][1] = p11 - k1 * p01;
+	return true;
+}
+
+static int32_t range_filter_value(const range_filter_t *f) {
+	return (int32_t)(f->d * 1000.0f);
+}
+#elif defined(CONFIG_SIT_RANGE_FILTER_MEDIAN)
+static bool range_filter_step(range_filter_t *f, int32_t distance_mm, const diagnostic_info *quality, int64_t now) {
+	ARG_UNUSED(now);
+	/* NLOS ranges are only taken if the path stays NLOS for a whole window */
+	if (!range_filter_nlos(quality)) {
+		f->nlos_run = 0;
+	} else if (f->nlos_run < CONFIG_SIT_RANGE_FILTER_MEDIAN_K) {
+		f->nlos_run++;
+		return false;
+	}
+	f->window[f->next] = distance_mm;
+	f->next = (f->next + 1) % CONFIG_SIT_RANGE_FILTER_MEDIAN_K;
+	f->count = MIN(f->count + 1, CONFIG_SIT_RANGE_FILTER_MEDIAN_K);
+	f->valid = true;
+	return true;
+}
+
+static int32_t range_filter_value(const range_filter_t *f) {
+	int32_t sorted[CONFIG_SIT_RANGE_FILTER_MEDIAN_K];
+	memcpy(sorted, f->window, f->count * sizeof(int32_t));
+	for (uint8_t i = 1; i < f->count; i++) {
+		int32_t value = sorted[i];
+		int j = i - 1;
+		while (j >= 0 && sorted[j] > value) {
+			sorted[j + 1] = sorted[j];
+			j--;
+		}
+		sorted[j + 1] = value;
+	}
+	return sorted[f->count / 2];
+}
+#endif
+
+bool sit_range_filter_update(uint8_t responder_id, int32_t distance_mm,
+			     const diagnostic_info *quality, int32_t *filtered_mm) {
+#if defined(CONFIG_SIT_RANGE_FILTER_KALMAN) || defined(CONFIG_SIT_RANGE_FILTER_MEDIAN)
+	range_filter_t *f = range_filter_get(responder_id);
+	if (f == NULL) {
+		*filtered_mm = distance_mm;
+		return true;
+	}
+	int64_t now = k_uptime_get();
+	if (!range_filter_step(f, distance_mm, quality, now)) {
+		filter_stats.rejected++;
+		return false;
+	}
+	f->update_ms = now;
+	f->rejected = 0;
+	filter_stats.accepted++;
+	*filtered_mm = range_filter_value(f);
+#else
+	ARG_UNUSED(responder_id);
+	ARG_UNUSED(quality);
+	filter_stats.accepted++;
+	*filtered_mm = distance_mm;
+#endif
+	return true;
+}
+
+bool sit_range_filter_decimate(uint8_t responder_id) {
+	range_filter_t *f = range_filter_get(responder_id);
+	if (f == NULL || CONFIG_SIT_RANGE_FILTER_DECIMATION <= 1) {
+		return true;
+	}
+	if (++f->decimation < CONFIG_SIT_RANGE_FILTER_DECIMATION) {
+		return false;
+	}
+	f->decimation = 0;
+	return true;
+}
+
+void sit_range_filter_get_stats(sit_range_filter_stats_t *stats) {
+	*stats = filter_stats;
+}
@@ -0,0 +1,134 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_reply.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Adaptive reply delay of the ranging exchanges.
+ *
+ * latency = reply delay - (delayed TX time - system time at dwt_starttx())
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_reply.h"
+#include "sit/sit_config.h"
+#include "sit/sit_profile.h"
+#include "sit/sit_ts.h"
+
+#include <string.h>
+
+#include <deca_device_api.h>
+
+#include <zephyr/kernel.h>
+
+BUILD_ASSERT(CONFIG_SIT_REPLY_MIN_UUS <= CONFIG_SIT_REPLY_MAX_UUS,
+	"SIT_REPLY_MIN_UUS has to be smaller than SIT_REPLY_MAX_UUS");
+
+static uint32_t reply_uus = CONFIG_SIT_REPLY_MAX_UUS;
+static uint32_t pending_tx_time;
+static bool pending;
+#ifdef CONFIG_SIT_REPLY_ADAPTIVE
+static int32_t margin_uus;
+#endif
+static uint32_t window_max;
+static uint32_t window_samples;
+static sit_reply_stats_t reply_stats;
+
+static void sit_reply_set(uint32_t uus) {
+	reply_uus = CLAMP(uus, CONFIG_SIT_REPLY_MIN_UUS, CONFIG_SIT_REPLY_MAX_UUS);
+	window_max = 0;
+	window_samples = 0;
+}
+
+void sit_reply_reset(void) {
+	sit_reply_set(CONFIG_SIT_REPLY_MAX_UUS);
+	pending = false;
+	memset(&reply_stats, 0, sizeof(reply_stats));
+}
+
+uint32_t sit_reply_tx_time(uint64_t rx_ts) {
+	uint32_t tx_time = sit_ts_tx_time_after(rx_ts, reply_uus);
+	pending_tx_time = tx_time;
+	pending = true;
+	return tx_time;
+}
+
+uint32_t sit_reply_rx_after_tx_uus(void) {
+	/* the preamble of the reply starts before its RMARKER */
+	uint32_t early = SIT_REPLY_RX_GUARD_UUS + sit_profile_shr_uus();
+	return CONFIG_SIT_REPLY_MIN_UUS > early ? CONFIG_SIT_REPLY_MIN_UUS - early : 0;
+}
+
+uint16_t sit_reply_rx_timeout_uus(void) {
+	uint32_t window = CONFIG_SIT_REPLY_MAX_UUS - sit_reply_rx_after_tx_uus() + SIT_REPLY_RX_GUARD_UUS;
+	return (uint16_t)MIN(sit_profile_rx_timeout_uus(window), UINT16_MAX);
+}
+
+uint16_t sit_reply_preamble_timeout_pac(void) {
+	return sit_profile_preamble_timeout_pac(CONFIG_SIT_REPLY_MAX_UUS - sit_reply_rx_after_tx_uus());
+}
+
+uint32_t sit_reply_listen_window_uus(void) {
+	return CONFIG_SIT_REPLY_MAX_UUS + SIT_REPLY_RX_GUARD_UUS;
+}
+
+void sit_reply_check(uint32_t tx_time) {
+#ifdef CONFIG_SIT_REPLY_ADAPTIVE
+	if (pending && tx_time == pending_tx_time) {
+		/* high 32 bit of the system time have the same unit as the delayed TX time */
+		int32_t margin = (int32_t)(tx_time - dwt_readsystimestamphi32());
+		margin_uus = (int32_t)(((int64_t)margin << 8) / UUS_TO_DWT_TIME);
+	}
+#else
+	ARG_UNUSED(tx_time);
+#endif
+}
+
+void sit_reply_result(uint32_t tx_time, bool ok) {
+	if (!pending || tx_time != pending_tx_time) {
+		return;
+	}
+	pending = false;
+	if (!ok) {
+		reply_stats.late++;
+#ifdef CONFIG_SIT_REPLY_ADAPTIVE
+		sit_reply_set(reply_uus + CONFIG_SIT_REPLY_BACKOFF_UUS);
+#endif
+		return;
+	}
+#ifdef CONFIG_SIT_REPLY_ADAPTIVE
+	uint32_t latency = (uint32_t)MAX((int32_t)reply_uus - margin_uus, 0);
+	reply_stats.samples++;
+	window_max = MAX(window_max, latency);
+	if (++window_samples >= CONFIG_SIT_REPLY_WINDOW) {
+		reply_stats.latency_uus = window_max;
+		uint32_t target = window_max + CONFIG_SIT_REPLY_MARGIN_UUS;
+		/* go down in half steps, a single fast window must not cause late replies */
+		sit_reply_set(target < reply_uus ? (reply_uus + target) / 2 : target);
+	}
+#endif
+}
+
+void sit_reply_get_stats(sit_reply_stats_t *stats) {
+	*stats = reply_stats;
+	stats->reply_uus = reply_uus;
+}
@@ -0,0 +1,113 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_shadow.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Shadow of the DW3000 RX timing registers.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_shadow.h"
+
+#include <stdbool.h>
+
+#include <deca_device_api.h>
+
+typedef enum {
+    shadow_rx_after_tx_delay,
+    shadow_rx_timeout,
+    shadow_preamble_timeout,
+    shadow_count,
+} shadow_reg_id_t;
+
+typedef struct {
+    uint32_t value;     ///< value in the DW3000
+    uint32_t pending;   ///< value of the next flush
+    bool valid;         ///< value is known
+    bool dirty;         ///< pending has to be written
+} shadow_reg_t;
+
+static shadow_reg_t shadow[shadow_count];
+static sit_shadow_stats_t shadow_stats;
+
+static void shadow_set(shadow_reg_id_t id, uint32_t value) {
+	shadow_reg_t *reg = &shadow[id];
+	if (reg->dirty || (reg->valid && reg->value == value)) {
+		/* the write of the last set is not needed anymore, or this one is not */
+		shadow_stats.elided++;
+	}
+	reg->pending = value;
+	reg->dirty = !(reg->valid && reg->value == value);
+}
+
+static void shadow_write(shadow_reg_id_t id, uint32_t value) {
+	switch (id) {
+	case shadow_rx_after_tx_delay:
+		dwt_setrxaftertxdelay(value);
+		break;
+	case shadow_rx_timeout:
+		dwt_setrxtimeout(value);
+		break;
+	case shadow_preamble_timeout:
+		dwt_setpreambledetecttimeout((uint16_t)value);
+		break;
+	default:
+		break;
+	}
+}
+
+void sit_shadow_reset(void) {
+	for (int i = 0; i < shadow_count; i++) {
+		shadow[i].valid = false;
+		shadow[i].dirty = false;
+	}
+}
+
+void sit_shadow_set_rx_after_tx_delay(uint32_t delay_uus) {
+	shadow_set(shadow_rx_after_tx_delay, delay_uus);
+}
+
+void sit_shadow_set_rx_timeout(uint32_t timeout_uus) {
+	shadow_set(shadow_rx_timeout, timeout_uus);
+}
+
+void sit_shadow_set_preamble_timeout(uint16_t timeout_pac) {
+	shadow_set(shadow_preamble_timeout, timeout_pac);
+}
+
+void sit_shadow_flush(void) {
+	for (int i = 0; i < shadow_count; i++) {
+		shadow_reg_t *reg = &shadow[i];
+		if (reg->dirty) {
+			shadow_write((shadow_reg_id_t)i, reg->pending);
+			reg->value = reg->pending;
+			reg->valid = true;
+			reg->dirty = false;
+			shadow_stats.writes++;
+		}
+	}
+}
+
+void sit_shadow_get_stats(sit_shadow_stats_t *stats) {
+	*stats = shadow_stats;
+}
@@ -0,0 +1,89 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_tdma.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief TDMA superframe for many initiators.
+ *
+ * Beacon handling and slot timing of the TDMA superframe.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_tdma.h"
+#include "sit/sit_config.h"
+#include "sit/sit_distance.h"
+#include "sit/sit_ts.h"
+#include "sit/sit_utils.h"
+
+#include <deca_device_api.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_TDMA, LOG_LEVEL_INF);
+
+/* the slot length goes over the air as 16 bit value, msg_tdma_beacon_t.slot_uus */
+BUILD_ASSERT((uint32_t)SIT_TDMA_MAX_RESPONDERS * CONFIG_SIT_TDMA_EXCHANGE_UUS <= UINT16_MAX,
+	     "CONFIG_SIT_TDMA_EXCHANGE_UUS * CONFIG_SIT_TWR_MAX_RESPONDER does not fit into the beacon");
+
+void sit_tdma_send_beacon(uint8_t sequence, uint8_t slots, uint8_t responders) {
+	msg_tdma_beacon_t beacon = {SIT_HEADER(tdma_beacon, sequence, device_settings.deviceID, SIT_BROADCAST_ID),
+			slots,
+			responders,
+			sit_tdma_slot_uus(responders),
+			0
+		};
+	sit_send_now((uint8_t*)&beacon, sizeof(beacon));
+}
+
+bool sit_tdma_wait_beacon(msg_tdma_beacon_t *beacon, uint64_t *beacon_rx_ts) {
+	sit_receive_now(0, 0);
+	if (sit_check_tdma_beacon_msg_id(tdma_beacon, beacon) && beacon->header.source == SIT_TDMA_BEACON_ID) {
+		*beacon_rx_ts = sit_rx_timestamp();
+		return true;
+	}
+	dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+	return false;
+}
+
+uint8_t sit_tdma_responders(uint8_t responders) {
+	return CLAMP(responders, 1, SIT_TDMA_MAX_RESPONDERS);
+}
+
+uint16_t sit_tdma_slot_uus(uint8_t responders) {
+	return (uint16_t)(sit_tdma_responders(responders) * CONFIG_SIT_TDMA_EXCHANGE_UUS);
+}
+
+uint32_t sit_tdma_superframe_uus(uint8_t slots, uint8_t responders) {
+	return CONFIG_SIT_TDMA_GUARD_UUS + (uint32_t)slots * sit_tdma_slot_uus(responders);
+}
+
+uint32_t sit_tdma_poll_tx_time(uint64_t beacon_rx_ts, const msg_tdma_beacon_t *beacon, uint8_t slot, uint8_t exchange) {
+	uint32_t offset_uus = CONFIG_SIT_TDMA_GUARD_UUS + (uint32_t)slot * beacon->slot_uus +
+						  (uint32_t)exchange * CONFIG_SIT_TDMA_EXCHANGE_UUS;
+	/* the 32 bit delayed TX time wraps together with the 40 bit system time */
+	return sit_ts_tx_time_after(beacon_rx_ts, offset_uus);
+}
+
+uint32_t sit_tdma_ranges_per_second(uint8_t slots, uint8_t responders) {
+	uint64_t superframe_uus = sit_tdma_superframe_uus(slots, responders);
+	/* 1 uus = 512 / 499.2 us */
+	return (uint32_t)(((uint64_t)slots * responders * 1000000ULL * 4992ULL) / (superframe_uus * 5120ULL));
+}
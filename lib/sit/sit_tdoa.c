@@ -0,0 +1,98 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_tdoa.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Uplink TDoA with blinking tags.
+ *
+ * Blink and sync frames and the clock offset of the anchors to the
+ * reference anchor.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_tdoa.h"
+#include "sit/sit_config.h"
+#include "sit/sit_device.h"
+#include "sit/sit_distance.h"
+#include "sit/sit_clock.h"
+#include "sit/sit_ts.h"
+
+#include <deca_device_api.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_TDOA, LOG_LEVEL_INF);
+
+/* The sync is sent delayed, so its TX time is known before it is sent */
+#define TDOA_SYNC_TX_DLY_UUS 1000
+
+void sit_tdoa_send_blink(uint8_t sequence) {
+	msg_tdoa_t blink = {SIT_HEADER(tdoa_blink, sequence, device_settings.deviceID, SIT_BROADCAST_ID),
+			{{0}},
+			0
+		};
+	sit_send_now((uint8_t*)&blink, sizeof(blink));
+}
+
+bool sit_tdoa_send_sync(uint8_t sequence, uint64_t *tx_ts) {
+	uint32_t sync_tx_time = sit_ts_tx_time_after((sit_ts_t)dwt_readsystimestamphi32() << 8, TDOA_SYNC_TX_DLY_UUS);
+	*tx_ts = sit_ts_from_tx_time(sync_tx_time);
+	msg_tdoa_t sync = {SIT_HEADER(tdoa_sync, sequence, device_settings.deviceID, SIT_BROADCAST_ID),
+			{{0}},
+			0
+		};
+	sit_ts_pack(&sync.tx_ts, *tx_ts);
+	return sit_send_at((uint8_t*)&sync, sizeof(sync), sync_tx_time);
+}
+
+void sit_tdoa_clock_reference(tdoa_clock_t *clock, uint8_t sequence, uint64_t tx_ts) {
+	clock->valid = true;
+	clock->offset_valid = true;
+	clock->sequence = sequence;
+	clock->sync_tx_ts = tx_ts;
+	clock->sync_rx_ts = tx_ts;
+	clock->clock_offset = 0.0;
+}
+
+void sit_tdoa_clock_update(tdoa_clock_t *clock, const msg_tdoa_t *sync, uint64_t rx_ts, int32_t ci) {
+	uint8_t reference = sync->header.source;
+	sit_clock_update_ci(reference, ci);
+	sit_ts_t sync_tx_ts = sit_ts_unpack(&sync->tx_ts);
+	sit_clock_update_sync(reference, sync_tx_ts, rx_ts);
+	/* the clock model tracks the reference clock / own clock */
+	clock->clock_offset = 1.0 / (1.0 + (double)sit_clock_skew(reference)) - 1.0;
+	clock->offset_valid = true;
+	clock->valid = true;
+	clock->sequence = sync->header.sequence;
+	clock->sync_tx_ts = sync_tx_ts;
+	clock->sync_rx_ts = rx_ts & SIT_TS_MASK;
+}
+
+void sit_tdoa_record(const tdoa_clock_t *clock, const msg_tdoa_t *blink, uint64_t rx_ts, json_tdoa_data_t *data) {
+	data->rx_ts = rx_ts & SIT_TS_MASK;
+	data->sync_tx_ts = clock->sync_tx_ts;
+	data->sync_rx_ts = clock->sync_rx_ts;
+	data->clock_offset = (float)clock->clock_offset;
+	data->tag = blink->header.source;
+	data->anchor = device_settings.deviceID;
+	data->blink_sequence = blink->header.sequence;
+	data->sync_sequence = clock->sequence;
+}
@@ -0,0 +1,81 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_tof.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Fixed point time of flight calculation.
+ *
+ * All products of two 32 bit time differences fit into 64 bit, the
+ * time of flight of a real exchange is far below 2^16 dtu (300 m), so the
+ * Q8 shift of the numerator can not overflow either.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_tof.h"
+#include "sit/sit_config.h"
+
+#include <deca_device_api.h>
+
+/* SPEED_OF_LIGHT * 1000 * DWT_TIME_UNITS = 4.690357 mm per dtu in Q24 */
+#define SIT_TOF_MM_PER_DTU_Q24 78691130LL
+
+/* Numerators above this limit are divided before the Q8 shift */
+#define SIT_TOF_Q8_LIMIT (INT64_MAX >> 8)
+
+static int64_t div_round(int64_t num, int64_t den) {
+	return (num >= 0) ? (num + den / 2) / den : (num - den / 2) / den;
+}
+
+int32_t sit_tof_ci_to_skew_q40(int32_t ci) {
+	/*
+	 * skew = ci * FREQ_OFFSET_MULTIPLIER * HERTZ_TO_PPM_MULTIPLIER / 1e6
+	 * channel 9: -ci / 2^31, channel 5: -ci * 2 / (13 * 2^28)
+	 */
+	if (sit_device_config.chan == 5) {
+		return (int32_t)div_round(-((int64_t)ci << 13), 13);
+	}
+	return -ci * (1 << 9);
+}
+
+int64_t sit_tof_ds_q8(uint32_t round_1, uint32_t reply_1, uint32_t round_2, uint32_t reply_2) {
+	int64_t num = (int64_t)((uint64_t)round_1 * round_2 - (uint64_t)reply_1 * reply_2);
+	int64_t den = (int64_t)round_1 + round_2 + reply_1 + reply_2;
+	if (den == 0) {
+		return 0;
+	}
+	if (num > SIT_TOF_Q8_LIMIT || num < -SIT_TOF_Q8_LIMIT) {
+		return div_round(num, den) * 256;
+	}
+	return div_round(num * 256, den);
+}
+
+int64_t sit_tof_ss_q8(uint32_t round, uint32_t reply, int32_t skew_q40) {
+	/* reply * skew in Q40 -> Q8 */
+	int64_t drift_q8 = div_round((int64_t)reply * skew_q40, (int64_t)1 << (SIT_TOF_SKEW_SHIFT - 8));
+	int64_t rtt_q8 = ((int64_t)round - reply) * 256 + drift_q8;
+	return div_round(rtt_q8, 2);
+}
+
+int32_t sit_tof_to_mm(int64_t tof_q8) {
+	return (int32_t)div_round(tof_q8 * SIT_TOF_MM_PER_DTU_Q24, (int64_t)1 << 32);
+}
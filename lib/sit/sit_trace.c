@@ -0,0 +1,117 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_trace.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Binary trace of the ranging hot path.
+ *
+ * The writers reserve a slot with an atomic increment, so the ranging
+ * thread and the DW3000 callbacks can trace without a lock. A full ring
+ * overwrites the oldest records, the drain thread counts them as lost.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_trace.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_TRACE, LOG_LEVEL_INF);
+
+#define TRACE_SIZE CONFIG_SIT_TRACE_SIZE
+#define TRACE_MASK (TRACE_SIZE - 1)
+
+BUILD_ASSERT((TRACE_SIZE & TRACE_MASK) == 0, "CONFIG_SIT_TRACE_SIZE has to be a power of two");
+
+static sit_trace_record_t trace_ring[TRACE_SIZE];
+static atomic_t trace_head;
+static uint32_t trace_tail;
+static uint32_t trace_lost;
+
+static const char *const trace_names[] = {
+	[sit_trace_tx_done] = "tx_done",
+	[sit_trace_tx_late] = "tx_late",
+	[sit_trace_rx_enable] = "rx_enable",
+	[sit_trace_rx_enable_fail] = "rx_enable_fail",
+	[sit_trace_rx_ok] = "rx_ok",
+	[sit_trace_rx_error] = "rx_error",
+	[sit_trace_rx_length] = "rx_length",
+};
+
+void sit_trace(sit_trace_event_t event, uint16_t arg, uint32_t dw_ts, uint32_t status) {
+	uint32_t seq = (uint32_t)atomic_inc(&trace_head);
+	sit_trace_record_t *record = &trace_ring[seq & TRACE_MASK];
+	/* invalidate the slot first, the reader drops a half written record */
+	record->seq = UINT32_MAX;
+	compiler_barrier();
+	record->cycle = k_cycle_get_32();
+	record->dw_ts = dw_ts;
+	record->status = status;
+	record->event = (uint16_t)event;
+	record->arg = arg;
+	compiler_barrier();
+	record->seq = seq;
+}
+
+uint32_t sit_trace_drain(sit_trace_record_t *records, uint32_t max) {
+	uint32_t head = (uint32_t)atomic_get(&trace_head);
+	uint32_t count = 0;
+	if (head - trace_tail > TRACE_SIZE) {
+		trace_lost += head - trace_tail - TRACE_SIZE;
+		trace_tail = head - TRACE_SIZE;
+	}
+	while (trace_tail != head && count < max) {
+		volatile sit_trace_record_t *slot = &trace_ring[trace_tail & TRACE_MASK];
+		uint32_t seq = slot->seq;
+		compiler_barrier();
+		records[count] = *(sit_trace_record_t *)slot;
+		compiler_barrier();
+		/* a writer which wrapped around while copying changed seq */
+		if (seq == trace_tail && slot->seq == trace_tail) {
+			count++;
+		} else {
+			trace_lost++;
+		}
+		trace_tail++;
+	}
+	return count;
+}
+
+uint32_t sit_trace_lost(void) {
+	return trace_lost;
+}
+
+static void sit_trace_thread(void *p1, void *p2, void *p3) {
+	sit_trace_record_t records[16];
+	while (42) {
+		k_msleep(CONFIG_SIT_TRACE_DRAIN_PERIOD_MS);
+		uint32_t count = sit_trace_drain(records, ARRAY_SIZE(records));
+		for (uint32_t i = 0; i < count; i++) {
+			const char *name = records[i].event < ARRAY_SIZE(trace_names) ? trace_names[records[i].event] : "?";
+			LOG_INF("%10u %-14s arg %5u dw 0x%08x status 0x%08x", records[i].cycle, name,
+				records[i].arg, records[i].dw_ts, records[i].status);
+		}
+	}
+}
+
+K_THREAD_DEFINE(sit_trace_tid, 1024, sit_trace_thread, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
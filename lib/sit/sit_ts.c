@@ -0,0 +1,79 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_ts.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief 40 bit DW3000 timestamps.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_ts.h"
+#include "sit/sit_config.h"
+#include "sit/sit_device.h"
+
+sit_ts_t sit_ts_add(sit_ts_t ts, int64_t dtu) {
+	return (ts + (uint64_t)dtu) & SIT_TS_MASK;
+}
+
+sit_ts_t sit_ts_add_uus(sit_ts_t ts, uint32_t uus) {
+	return (ts + (uint64_t)uus * UUS_TO_DWT_TIME) & SIT_TS_MASK;
+}
+
+uint64_t sit_ts_diff(sit_ts_t later, sit_ts_t earlier) {
+	return (later - earlier) & SIT_TS_MASK;
+}
+
+int64_t sit_ts_sdiff(sit_ts_t later, sit_ts_t earlier) {
+	/* sign extend bit 39 */
+	return (int64_t)(sit_ts_diff(later, earlier) << 24) >> 24;
+}
+
+bool sit_ts_before(sit_ts_t earlier, sit_ts_t later) {
+	return sit_ts_sdiff(later, earlier) > 0;
+}
+
+uint32_t sit_ts_to_tx_time(sit_ts_t ts) {
+	return (uint32_t)((ts & SIT_TS_MASK) >> 8);
+}
+
+uint32_t sit_ts_tx_time_after(sit_ts_t ts, uint32_t uus) {
+	return sit_ts_to_tx_time(sit_ts_add_uus(ts, uus));
+}
+
+sit_ts_t sit_ts_from_tx_time(uint32_t tx_time) {
+	return ((((uint64_t)(tx_time & 0xFFFFFFFEUL)) << 8) + get_tx_ant_dly()) & SIT_TS_MASK;
+}
+
+void sit_ts_pack(sit_ts40_t *packed, sit_ts_t ts) {
+	for (int i = 0; i < SIT_TS_LEN; i++) {
+		packed->b[i] = (uint8_t)(ts >> (8 * i));
+	}
+}
+
+sit_ts_t sit_ts_unpack(const sit_ts40_t *packed) {
+	sit_ts_t ts = 0;
+	for (int i = SIT_TS_LEN - 1; i >= 0; i--) {
+		ts = (ts << 8) | packed->b[i];
+	}
+	return ts;
+}
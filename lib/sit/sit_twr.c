@@ -0,0 +1,234 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file sit_twr.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief DS-TWR initiator state machine.
+ *
+ * Implementation of the per responder DS-TWR exchange and the schedulers
+ * which decide which responder is ranged in a round.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_twr.h"
+#include "sit/sit.h"
+#include "sit/sit_config.h"
+#include "sit/sit_distance.h"
+#include "sit/sit_reply.h"
+#include "sit/sit_tof.h"
+#include "sit/sit_ts.h"
+#include "sit/sit_tx_template.h"
+#include "sit/sit_utils.h"
+
+#include <deca_device_api.h>
+#include <sit/sit_device.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(SIT_TWR, LOG_LEVEL_INF);
+
+/* Maximum number of rounds a not answering responder is skipped */
+#define TWR_MAX_BACKOFF 8
+
+static const twr_scheduler_t *twr_scheduler = &twr_scheduler_backoff;
+
+static bool round_robin_ready(twr_ctx_t *ctx) {
+	ARG_UNUSED(ctx);
+	return true;
+}
+
+static void round_robin_update(twr_ctx_t *ctx) {
+	ARG_UNUSED(ctx);
+}
+
+const twr_scheduler_t twr_scheduler_round_robin = {
+	.name = "round_robin",
+	.ready = round_robin_ready,
+	.update = round_robin_update,
+};
+
+static bool backoff_ready(twr_ctx_t *ctx) {
+	if (ctx->backoff > 0) {
+		ctx->backoff--;
+		return false;
+	}
+	return true;
+}
+
+static void backoff_update(twr_ctx_t *ctx) {
+	if (ctx->state == twr_state_report || ctx->state == twr_state_sent) {
+		ctx->failures = 0;
+		ctx->backoff = 0;
+	} else {
+		/* skip 1, 2, 4, ... rounds, so a missing responder does not cost a slot every round */
+		ctx->backoff = MIN(1U << MIN(ctx->failures, 3U), TWR_MAX_BACKOFF);
+		ctx->failures++;
+	}
+}
+
+const twr_scheduler_t twr_scheduler_backoff = {
+	.name = "backoff",
+	.ready = backoff_ready,
+	.update = backoff_update,
+};
+
+void sit_twr_set_scheduler(const twr_scheduler_t *scheduler) {
+	twr_scheduler = scheduler;
+	LOG_INF("TWR scheduler: %s", scheduler->name);
+}
+
+const twr_scheduler_t *sit_twr_get_scheduler(void) {
+	return twr_scheduler;
+}
+
+uint8_t sit_twr_init(twr_ctx_t *ctx, uint8_t last_responder_id, bool final_resp) {
+	uint8_t count = 0;
+	for (uint8_t responder_id = 100; responder_id <= last_responder_id && count < SIT_TWR_MAX_RESPONDER; responder_id++) {
+		memset(&ctx[count], 0, sizeof(twr_ctx_t));
+		ctx[count].responder_id = responder_id;
+		ctx[count].state = twr_state_idle;
+		ctx[count].final_resp = final_resp;
+		count++;
+	}
+	return count;
+}
+
+static void twr_send_poll(twr_ctx_t *ctx) {
+	sit_set_rx_after_tx_delay(sit_reply_rx_after_tx_uus());
+	sit_set_rx_timeout(sit_reply_rx_timeout_uus());
+	sit_set_preamble_detection_timeout(sit_reply_preamble_timeout_pac());
+
+	msg_simple_t twr_poll = {SIT_HEADER(twr_1_poll, ctx->sequence, device_settings.deviceID, ctx->responder_id), 0};
+	if (ctx->poll_tx_time == 0) {
+		sit_start_poll((uint8_t*) &twr_poll, (uint16_t)sizeof(twr_poll));
+	} else if (!sit_send_at_with_response((uint8_t*) &twr_poll, (uint16_t)sizeof(twr_poll), ctx->poll_tx_time)) {
+		LOG_WRN("Responder %d: missed poll slot", ctx->responder_id);
+		ctx->state = twr_state_timeout;
+		return;
+	}
+	ctx->state = twr_state_poll;
+}
+
+static void twr_rx_resp(twr_ctx_t *ctx, uint32_t status) {
+	msg_simple_t rx_resp_msg;
+	if (sit_take_msg_id(status, ds_twr_2_resp, &rx_resp_msg, sizeof(rx_resp_msg)) &&
+		rx_resp_msg.header.dest == device_settings.deviceID &&
+		rx_resp_msg.header.source == ctx->responder_id) {
+		ctx->poll_tx_ts = sit_tx_timestamp();
+		ctx->resp_rx_ts = sit_rx_timestamp();
+		ctx->state = twr_state_resp;
+	} else {
+		LOG_WRN("Responder %d: no response", ctx->responder_id);
+		dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+		ctx->state = twr_state_timeout;
+	}
+}
+
+static void twr_send_final(twr_ctx_t *ctx) {
+	uint32_t final_tx_time = sit_reply_tx_time(ctx->resp_rx_ts);
+	ctx->final_tx_ts = sit_ts_from_tx_time(final_tx_time);
+
+	msg_ds_twr_final_t final_msg = {SIT_HEADER(ds_twr_3_final, ctx->sequence, device_settings.deviceID, ctx->responder_id),
+		{{0}},
+		{{0}},
+		{{0}},
+		0
+	};
+	sit_ts_pack(&final_msg.poll_tx_ts, ctx->poll_tx_ts);
+	sit_ts_pack(&final_msg.resp_rx_ts, ctx->resp_rx_ts);
+	sit_ts_pack(&final_msg.final_tx_ts, ctx->final_tx_ts);
+
+	/* sequence, addresses, message ID and timestamps are one block, only the frame control stays in the template */
+	sit_tpl_update(sit_tpl_twr_final, &final_msg, SIT_TPL_FIELDS(msg_ds_twr_final_t, header.sequence, crc));
+	if (sit_tpl_send_at(sit_tpl_twr_final, final_tx_time, ctx->final_resp)) {
+		ctx->state = ctx->final_resp ? twr_state_final : twr_state_sent;
+	} else {
+		LOG_WRN("Responder %d: final sent too late", ctx->responder_id);
+		ctx->state = twr_state_timeout;
+	}
+}
+
+static void twr_rx_final_resp(twr_ctx_t *ctx, uint32_t status) {
+	msg_ds_twr_resp_t rx_ds_resp_msg;
+	if (sit_take_msg_id(status, ds_twr_4_final, &rx_ds_resp_msg, sizeof(rx_ds_resp_msg)) &&
+		rx_ds_resp_msg.header.dest == device_settings.deviceID &&
+		rx_ds_resp_msg.header.source == ctx->responder_id) {
+		ctx->poll_rx_ts = sit_ts_unpack(&rx_ds_resp_msg.poll_rx_ts);
+		ctx->resp_tx_ts = sit_ts_unpack(&rx_ds_resp_msg.resp_tx_ts);
+		ctx->final_rx_ts = sit_ts_unpack(&rx_ds_resp_msg.final_rx_ts);
+
+		ctx->time_round_1 = (uint32_t)sit_ts_diff(ctx->resp_rx_ts, ctx->poll_tx_ts);
+		ctx->time_round_2 = (uint32_t)sit_ts_diff(ctx->final_rx_ts, ctx->resp_tx_ts);
+		ctx->time_reply_1 = (uint32_t)sit_ts_diff(ctx->resp_tx_ts, ctx->poll_rx_ts);
+		ctx->time_reply_2 = (uint32_t)sit_ts_diff(ctx->final_tx_ts, ctx->resp_rx_ts);
+		ctx->distance_mm = sit_tof_to_mm(sit_tof_ds_q8(ctx->time_round_1, ctx->time_reply_1,
+								ctx->time_round_2, ctx->time_reply_2));
+		ctx->ranges++;
+		ctx->state = twr_state_report;
+	} else {
+		LOG_WRN("Responder %d: no final response", ctx->responder_id);
+		dwt_writesysstatuslo(SYS_STATUS_ALL_RX_TO | SYS_STATUS_ALL_RX_ERR);
+		ctx->state = twr_state_timeout;
+	}
+}
+
+bool sit_twr_done(const twr_ctx_t *ctx) {
+	return ctx->state == twr_state_sent || ctx->state == twr_state_report || ctx->state == twr_state_timeout;
+}
+
+bool sit_twr_start(twr_ctx_t *ctx, uint8_t sequence, uint32_t poll_tx_time) {
+	ctx->sequence = sequence;
+	ctx->poll_tx_time = poll_tx_time;
+	ctx->state = twr_state_idle;
+	twr_send_poll(ctx);
+	return ctx->state == twr_state_poll;
+}
+
+bool sit_twr_step(twr_ctx_t *ctx, uint32_t status) {
+	switch (ctx->state) {
+	case twr_state_poll:
+		twr_rx_resp(ctx, status);
+		break;
+	case twr_state_final:
+		twr_rx_final_resp(ctx, status);
+		break;
+	case twr_state_idle:
+	case twr_state_resp:
+	case twr_state_sent:
+	case twr_state_report:
+	case twr_state_timeout:
+	default:
+		break;
+	}
+	/* the final is sent right away, its TX time is bound to the response */
+	if (ctx->state == twr_state_resp) {
+		twr_send_final(ctx);
+	}
+	return sit_twr_done(ctx);
+}
+
+bool sit_twr_run(twr_ctx_t *ctx, uint8_t sequence, uint32_t poll_tx_time) {
+	if (sit_twr_start(ctx, sequence, poll_tx_time)) {
+		while (!sit_twr_step(ctx, sit_msg_receive())) {
+		}
+	}
+	return ctx->state == twr_state_report;
+}
@@ -0,0 +1,80 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_tx_template.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief TWR frames pre-staged in the DW3000 TX buffer.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit/sit_tx_template.h"
+#include "sit/sit_config.h"
+#include "sit/sit_distance.h"
+
+#include <string.h>
+
+#include <deca_device_api.h>
+#include <deca_regs.h>
+#include <dw3000_spi.h>
+
+#include <zephyr/kernel.h>
+
+#define TPL_RESP_OFFSET 0
+#define TPL_FINAL_OFFSET ROUND_UP(TPL_RESP_OFFSET + sizeof(msg_simple_t), 4)
+#define TPL_FINAL_RESP_OFFSET ROUND_UP(TPL_FINAL_OFFSET + sizeof(msg_ds_twr_final_t), 4)
+#define TPL_SS_RESP_OFFSET ROUND_UP(TPL_FINAL_RESP_OFFSET + sizeof(msg_ds_twr_resp_t), 4)
+#define TPL_END (TPL_SS_RESP_OFFSET + sizeof(msg_ss_twr_final_t))
+
+BUILD_ASSERT(TPL_END <= SIT_TX_FRAME_OFFSET, "TX templates overlap SIT_TX_FRAME_OFFSET");
+
+typedef struct {
+    msg_id_t id;
+    uint16_t offset;
+    uint16_t size;
+} tpl_t;
+
+static const tpl_t tpl[sit_tpl_count] = {
+	[sit_tpl_twr_resp] = {ds_twr_2_resp, TPL_RESP_OFFSET, sizeof(msg_simple_t)},
+	[sit_tpl_twr_final] = {ds_twr_3_final, TPL_FINAL_OFFSET, sizeof(msg_ds_twr_final_t)},
+	[sit_tpl_twr_final_resp] = {ds_twr_4_final, TPL_FINAL_RESP_OFFSET, sizeof(msg_ds_twr_resp_t)},
+	[sit_tpl_ss_twr_resp] = {ss_twr_2_resp, TPL_SS_RESP_OFFSET, sizeof(msg_ss_twr_final_t)},
+};
+
+void sit_tpl_init(void) {
+	uint8_t frame[TPL_END];
+	for (int i = 0; i < sit_tpl_count; i++) {
+		header_t header = SIT_HEADER(tpl[i].id, 0, device_settings.deviceID, 0);
+		memset(frame, 0, tpl[i].size);
+		memcpy(frame, &header, sizeof(header));
+		dwt_writetxdata(tpl[i].size, frame, tpl[i].offset);
+	}
+}
+
+void sit_tpl_update(sit_tpl_id_t id, const void *frame, uint16_t from, uint16_t to) {
+	__ASSERT_NO_MSG(from < to && to <= tpl[id].size);
+	dw3000_spi_write_reg(TX_BUFFER_ID + tpl[id].offset + from, to - from, (const uint8_t *)frame + from);
+}
+
+bool sit_tpl_send_at(sit_tpl_id_t id, uint32_t tx_time, bool response) {
+	return sit_send_buffer_at(tpl[id].offset, tpl[id].size, tx_time, response);
+}
@@ -0,0 +1,106 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file ble_batch.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Batched binary result notifications.
+ *
+ * All functions run in the BLE sender thread (ble_sender.c), which also
+ * sends the batch at its deadline, so the batch needs no lock.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_ble/ble_batch.h"
+#include "sit_ble/ble_init.h"
+#include "sit_ble/ble_sender.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(BLE_BATCH, LOG_LEVEL_INF);
+
+/* ATT notification payload of the largest MTU (ATT header is 3 bytes) */
+#define BATCH_MAX_LEN (CONFIG_BT_L2CAP_TX_MTU - 3)
+
+static uint8_t batch_buf[BATCH_MAX_LEN];
+static uint16_t batch_len;
+static uint16_t batch_counter;
+static int64_t batch_deadline_ms;
+
+static void ble_batch_send(void) {
+	ble_batch_header_t *header = (ble_batch_header_t *)batch_buf;
+	if (batch_len <= sizeof(ble_batch_header_t)) {
+		return;
+	}
+	header->batch = batch_counter++;
+	int err = ble_sender_notify(batch_buf, batch_len);
+	if (err) {
+		LOG_WRN("Batch notify failed: %d", err);
+	}
+	batch_len = 0;
+	batch_deadline_ms = 0;
+}
+
+int ble_batch_add(const void *record, uint16_t len) {
+	if (!is_connected()) {
+		return -ENOTCONN;
+	}
+	uint16_t max_len = MIN(ble_notify_max_len(), BATCH_MAX_LEN);
+	if (sizeof(ble_batch_header_t) + len > max_len) {
+		LOG_ERR("Record does not fit into the MTU");
+		return -EMSGSIZE;
+	}
+	if (batch_len > 0 && batch_len + len > max_len) {
+		ble_batch_send();
+	}
+	if (batch_len == 0) {
+		ble_batch_header_t *header = (ble_batch_header_t *)batch_buf;
+		header->version = BLE_BATCH_VERSION;
+		header->count = 0;
+		batch_len = sizeof(ble_batch_header_t);
+		batch_deadline_ms = k_uptime_get() + CONFIG_SIT_BLE_BATCH_DEADLINE_MS;
+	}
+	memcpy(&batch_buf[batch_len], record, len);
+	batch_len += len;
+	((ble_batch_header_t *)batch_buf)->count++;
+	if (batch_len + len > max_len) {
+		/* the next record of this size does not fit, do not wait for the deadline */
+		ble_batch_send();
+	}
+	return 0;
+}
+
+int64_t ble_batch_deadline(void) {
+	return batch_deadline_ms;
+}
+
+void ble_batch_flush(void) {
+	ble_batch_send();
+}
+
+void ble_batch_reset(void) {
+	batch_len = 0;
+	batch_deadline_ms = 0;
+}
@@ -38,6 +38,15 @@
 #include <sit/sit.h>
 #include <sit_json/sit_json.h>
 #include <sit/sit_device.h>
+#include <sit/sit_distance.h>
+#include <sit/sit_event.h>
+#include <sit/sit_position.h>
+#include <sit/sit_profile.h>
+#include <sit/sit_range_filter.h>
+#include <sit/sit_reply.h>
+#include <sit/sit_shadow.h>
+#include <dw3000_hw.h>
+#include <dw3000_spi.h>
 
 #include <zephyr/kernel.h>
 #include <zephyr/types.h>
@@ -58,6 +67,8 @@
 LOG_MODULE_REGISTER(BLE_INIT, LOG_LEVEL_INF);
 
 #include "sit_ble/ble_init.h"
+#include "sit_ble/ble_sender.h"
+#include "sit_ble/ble_stats.h"
 #include "sit_ble/cts.h"
 
 #define POS_MAX_LEN 20
@@ -82,6 +93,9 @@ static struct bt_uuid_128 sit_json_command_uuid = BT_UUID_INIT_128(
 static struct bt_uuid_128 sit_json_setup_uuid = BT_UUID_INIT_128(
 	BT_UUID_SIT_JSON_SETUP_VAL);
 
+static struct bt_uuid_128 sit_stats_uuid = BT_UUID_INIT_128(
+	BT_UUID_SIT_STATS_VAL);
+
 static ssize_t write_int_comand(
 		struct bt_conn *conn,
 		const struct bt_gatt_attr *attr,
@@ -167,15 +181,25 @@ static ssize_t write_json_setup(
 		set_rx_ant_dly(setup_str.rx_ant_dly);
 		set_tx_ant_dly(setup_str.tx_ant_dly);
 		set_device_type(setup_str.device_type);
+		set_tdma_slot(setup_str.tdma_slot, setup_str.tdma_slots);
+		sit_position_reset();
+		for (uint8_t i = 0; i < setup_str.anchor_count; i++) {
+			sit_position_set_anchor(i, setup_str.anchors[i][0], setup_str.anchors[i][1], setup_str.anchors[i][2]);
+		}
+		if (strlen(setup_str.profile) > 0) {
+			sit_profile_select(setup_str.profile);
+		}
 		if (strncmp(setup_str.initiator_device, bt_get_name(), 16) == 0 ){
 			LOG_INF("Test Initiator");
-			set_device_id(1);
+			// every initiator of a TDMA superframe needs its own ID
+			set_device_id(1 + setup_str.tdma_slot);
 			set_responder(100 + setup_str.responder - 1);
 		} else if (strlen(setup_str.responder_device[0]) > 0) {
 			for(uint8_t i=0; i<setup_str.responder; i++) {
 				if (strncmp(setup_str.responder_device[i], bt_get_name(), 16) == 0 ) {
 					LOG_INF("Test Responder");
 					set_device_id(100 + i);
+					set_responder(100 + setup_str.responder - 1);
 					break;
 				}  else {
 					LOG_ERR("Setup: %s", setup_str.type);
@@ -192,11 +216,81 @@ static ssize_t write_json_setup(
 				LOG_ERR("Device Type: %s", setup_str.device_type);
 			}
 		}
-		
+		sit_setup_changed();
 	}
 	return len;
 }
 
+BUILD_ASSERT(DW3000_IRQ_HIST_BUCKETS == BLE_STATS_IRQ_BUCKETS, "IRQ histogram does not match ble_stats_t");
+
+static ssize_t read_stats(
+		struct bt_conn *conn,
+		const struct bt_gatt_attr *attr,
+		void *buf,
+		uint16_t len,
+		uint16_t offset
+	) {
+	sit_rx_stats_t rx = {0};
+	sit_event_stats_t events = {0};
+	sit_reply_stats_t reply;
+	struct dw3000_spi_stats spi;
+	sit_shadow_stats_t shadow;
+	sit_frame_stats_t frames;
+	struct dw3000_irq_stats irq;
+	sit_range_filter_stats_t range_filter;
+	ble_sender_stats_t sender = {0};
+	ble_stats_t stats = {
+		.version = BLE_STATS_VERSION,
+		.length = sizeof(ble_stats_t),
+		.uptime_ms = k_uptime_get_32(),
+	};
+
+#ifdef CONFIG_SIT_IRQ
+	sit_rx_get_stats(&rx);
+	sit_event_get_stats(&events);
+#endif
+	sit_reply_get_stats(&reply);
+	dw3000_spi_get_stats(&spi);
+	sit_shadow_get_stats(&shadow);
+	sit_get_frame_stats(&frames);
+	dw3000_hw_get_irq_stats(&irq);
+	sit_range_filter_get_stats(&range_filter);
+#ifdef CONFIG_SIT_BLE_SENDER
+	ble_sender_get_stats(&sender);
+#endif
+
+	stats.rx_frames = rx.frames;
+	stats.rx_dropped = rx.dropped;
+	stats.rx_errors = rx.errors;
+	stats.rx_overruns = rx.overruns;
+	stats.events = rx.events;
+	stats.events_dropped = rx.events_dropped;
+	stats.reply_uus = reply.reply_uus;
+	stats.reply_latency_uus = reply.latency_uus;
+	stats.reply_samples = reply.samples;
+	stats.reply_late = reply.late;
+	stats.spi_reads = spi.reads;
+	stats.spi_writes = spi.writes;
+	stats.shadow_writes = shadow.writes;
+	stats.shadow_elided = shadow.elided;
+	stats.frames_delivered = frames.delivered;
+	stats.frames_filtered = frames.filtered;
+	stats.irqs = irq.irqs;
+	stats.irq_max_us = irq.max_us;
+	memcpy(stats.irq_hist, irq.hist, sizeof(stats.irq_hist));
+	stats.filter_accepted = range_filter.accepted;
+	stats.filter_rejected = range_filter.rejected;
+	stats.filter_resets = range_filter.resets;
+	stats.sender_queued = sender.queued;
+	stats.sender_sent = sender.sent;
+	stats.sender_dropped = sender.dropped;
+	stats.sender_retries = sender.retries;
+	stats.sender_high_watermark = sender.high_watermark;
+	stats.event_timeouts = events.timeouts;
+	stats.events_lost = events.lost;
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, &stats, sizeof(stats));
+}
+
 static void sit_pos_ccc_cfg_changed(
 		const struct bt_gatt_attr *attr,
 		uint16_t value
@@ -227,6 +321,10 @@ BT_GATT_SERVICE_DEFINE(sit_service,
 			       BT_GATT_CHRC_WRITE,
 			       BT_GATT_PERM_WRITE,
 			       NULL, write_json_setup, NULL),
+	BT_GATT_CHARACTERISTIC(&sit_stats_uuid.uuid,
+			       BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ,
+			       read_stats, NULL, NULL),
 );
 
 static const struct bt_data ad[] = {
@@ -339,12 +437,47 @@ void bas_notify(void) {
 
 
 
+#ifdef CONFIG_SIT_BLE_SENDER
+BUILD_ASSERT(sizeof(json_distance_msg_all_t) <= BLE_SENDER_MAX_LEN &&
+	     sizeof(json_simple_td_msg_t) <= BLE_SENDER_MAX_LEN &&
+	     sizeof(json_tdoa_msg_t) <= BLE_SENDER_MAX_LEN &&
+	     sizeof(json_position_msg_t) <= BLE_SENDER_MAX_LEN,
+	     "BLE_SENDER_MAX_LEN too small for the notifications");
+#endif
+
+/* Notifications of the ranging thread go through the sender thread */
+static void ble_sit_notify_queued(const void *data, size_t data_len) {
+#ifdef CONFIG_SIT_BLE_SENDER
+	ble_sender_put(ble_msg_notify, data, (uint16_t)data_len);
+#else
+	bt_gatt_notify(NULL, &sit_service.attrs[1], data, data_len);
+#endif
+}
+
 void ble_sit_notify(json_distance_msg_all_t *json_data, size_t data_len) {
-	bt_gatt_notify(NULL, &sit_service.attrs[1], json_data, data_len);
+	ble_sit_notify_queued(json_data, data_len);
 }
 
 void ble_sit_td_notify(json_simple_td_msg_t *json_data, size_t data_len) {
-	bt_gatt_notify(NULL, &sit_service.attrs[1], json_data, data_len);
+	ble_sit_notify_queued(json_data, data_len);
+}
+
+void ble_sit_tdoa_notify(json_tdoa_msg_t *json_data, size_t data_len) {
+	ble_sit_notify_queued(json_data, data_len);
+}
+
+void ble_sit_position_notify(json_position_msg_t *json_data, size_t data_len) {
+	ble_sit_notify_queued(json_data, data_len);
+}
+
+int ble_sit_notify_raw(const void *data, uint16_t len) {
+	return bt_gatt_notify(NULL, &sit_service.attrs[1], data, len);
+}
+
+uint16_t ble_notify_max_len(void) {
+	struct bt_conn *conn = default_conn;
+	/* ATT header of a notification is 3 bytes */
+	return conn ? bt_gatt_get_mtu(conn) - 3 : 0;
 }
 
 uint8_t sit_ble_init(void){
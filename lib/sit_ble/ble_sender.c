@@ -0,0 +1,177 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file ble_sender.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief BLE sender thread behind a lock-free result queue.
+ *
+ * The producer only writes ring_head, the sender only ring_tail. A slot
+ * is filled before the head is moved and read before the tail is moved,
+ * the atomic stores order the slot access against the index update.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_ble/ble_sender.h"
+#include "sit_ble/ble_batch.h"
+#include "sit_ble/ble_init.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(BLE_SENDER, LOG_LEVEL_INF);
+
+#define RING_SIZE CONFIG_SIT_BLE_SENDER_QUEUE_SIZE
+#define RING_MASK (RING_SIZE - 1)
+
+BUILD_ASSERT((RING_SIZE & RING_MASK) == 0, "CONFIG_SIT_BLE_SENDER_QUEUE_SIZE has to be a power of two");
+
+typedef struct {
+    uint8_t kind;
+    uint8_t len;
+    uint8_t data[BLE_SENDER_MAX_LEN];
+} ble_msg_t;
+
+static ble_msg_t ring[RING_SIZE];
+static atomic_t ring_head;
+static atomic_t ring_tail;
+
+static K_SEM_DEFINE(sender_sem, 0, 1);
+
+/* producer side counters, read by the BLE thread for the stats */
+static atomic_t queued;
+static atomic_t ring_full;
+static atomic_t high_watermark;
+/* sender side counters */
+static atomic_t sent;
+static atomic_t send_failed;
+static atomic_t retries;
+/* the last notify ran out of retries, no retries until a notify succeeds */
+static bool stalled;
+
+int ble_sender_put(ble_msg_kind_t kind, const void *data, uint16_t len) {
+	if (len > BLE_SENDER_MAX_LEN) {
+		return -EMSGSIZE;
+	}
+	uint32_t head = (uint32_t)atomic_get(&ring_head);
+	uint32_t used = head - (uint32_t)atomic_get(&ring_tail);
+	if (used >= RING_SIZE) {
+		atomic_inc(&ring_full);
+		return -ENOBUFS;
+	}
+	ble_msg_t *msg = &ring[head & RING_MASK];
+	msg->kind = kind;
+	msg->len = (uint8_t)len;
+	memcpy(msg->data, data, len);
+	atomic_set(&ring_head, (atomic_val_t)(head + 1));
+	atomic_inc(&queued);
+	if (used + 1 > (uint32_t)atomic_get(&high_watermark)) {
+		/* only the producer writes the watermark */
+		atomic_set(&high_watermark, (atomic_val_t)(used + 1));
+	}
+	k_sem_give(&sender_sem);
+	return 0;
+}
+
+int ble_sender_notify(const void *data, uint16_t len) {
+	int err = ble_sit_notify_raw(data, len);
+	/* a stalled link gets a single attempt, the ring would fill up behind the retries */
+	for (int i = 0; err == -ENOMEM && !stalled && i < CONFIG_SIT_BLE_SENDER_RETRIES; i++) {
+		/* all TX buffers in use, wait for the next connection event */
+		atomic_inc(&retries);
+		k_msleep(CONFIG_SIT_BLE_SENDER_RETRY_MS);
+		err = ble_sit_notify_raw(data, len);
+	}
+	if (err) {
+		atomic_inc(&send_failed);
+		if (err == -ENOMEM && !stalled) {
+			LOG_WRN("No BLE buffer after %d retries, dropping until a notify succeeds",
+				CONFIG_SIT_BLE_SENDER_RETRIES);
+			stalled = true;
+		}
+	} else {
+		atomic_inc(&sent);
+		stalled = false;
+	}
+	return err;
+}
+
+static void ble_sender_process(const ble_msg_t *msg) {
+	if (!is_connected()) {
+		/* results of a closed connection are of no use for the next one */
+		atomic_inc(&send_failed);
+		stalled = false;
+#ifdef CONFIG_SIT_BLE_BATCH
+		ble_batch_reset();
+#endif
+		return;
+	}
+#ifdef CONFIG_SIT_BLE_BATCH
+	if (msg->kind == ble_msg_record) {
+		if (ble_batch_add(msg->data, msg->len) < 0) {
+			atomic_inc(&send_failed);
+		}
+		return;
+	}
+#endif
+	ble_sender_notify(msg->data, msg->len);
+}
+
+static void ble_sender_thread(void *p1, void *p2, void *p3) {
+	while (42) {
+		k_timeout_t wait = K_FOREVER;
+#ifdef CONFIG_SIT_BLE_BATCH
+		int64_t deadline = ble_batch_deadline();
+		if (deadline > 0) {
+			wait = K_MSEC(MAX(deadline - k_uptime_get(), 0));
+		}
+#endif
+		k_sem_take(&sender_sem, wait);
+
+		uint32_t tail = (uint32_t)atomic_get(&ring_tail);
+		while (tail != (uint32_t)atomic_get(&ring_head)) {
+			ble_sender_process(&ring[tail & RING_MASK]);
+			tail++;
+			atomic_set(&ring_tail, (atomic_val_t)tail);
+		}
+#ifdef CONFIG_SIT_BLE_BATCH
+		deadline = ble_batch_deadline();
+		if (deadline > 0 && deadline <= k_uptime_get()) {
+			ble_batch_flush();
+		}
+#endif
+	}
+}
+
+K_THREAD_DEFINE(ble_sender_tid, CONFIG_SIT_BLE_SENDER_STACK_SIZE, ble_sender_thread, NULL, NULL, NULL,
+		CONFIG_SIT_BLE_SENDER_PRIORITY, 0, 0);
+
+void ble_sender_get_stats(ble_sender_stats_t *stats) {
+	stats->queued = (uint32_t)atomic_get(&queued);
+	stats->sent = (uint32_t)atomic_get(&sent);
+	stats->dropped = (uint32_t)atomic_get(&ring_full) + (uint32_t)atomic_get(&send_failed);
+	stats->retries = (uint32_t)atomic_get(&retries);
+	stats->high_watermark = (uint32_t)atomic_get(&high_watermark);
+}
@@ -93,6 +93,11 @@ int json_decode_setup_msg(char *json, json_setup_msg_t *setup_struct) {
     const cJSON *measurement_type = NULL;
     const cJSON *rx_ant_dly = NULL;
     const cJSON *tx_ant_dly = NULL;
+    const cJSON *tdma_slot = NULL;
+    const cJSON *tdma_slots = NULL;
+    const cJSON *profile = NULL;
+    const cJSON *anchor_list = NULL;
+    const cJSON *anchor = NULL;
     cJSON *json_msg = cJSON_Parse(json);
     if (json_msg == NULL) {
         const char *error_ptr = cJSON_GetErrorPtr();
@@ -166,6 +171,45 @@ int json_decode_setup_msg(char *json, json_setup_msg_t *setup_struct) {
     LOG_INF("Checking RX DLY Type \"%d\"\n", tx_ant_dly->valueint);
     setup_struct->tx_ant_dly = tx_ant_dly->valueint;
 
+    // TDMA slot assignment is optional, without it every initiator polls whenever it likes
+    tdma_slot = cJSON_GetObjectItemCaseSensitive(json_msg, "tdma_slot");
+    tdma_slots = cJSON_GetObjectItemCaseSensitive(json_msg, "tdma_slots");
+    if (cJSON_IsNumber(tdma_slot) && cJSON_IsNumber(tdma_slots)) {
+        setup_struct->tdma_slot = tdma_slot->valueint;
+        setup_struct->tdma_slots = tdma_slots->valueint;
+    } else {
+        setup_struct->tdma_slot = 0;
+        setup_struct->tdma_slots = 0;
+    }
+
+    // PHY profile is optional, without it the active profile is kept
+    profile = cJSON_GetObjectItemCaseSensitive(json_msg, "profile");
+    if (cJSON_IsString(profile) && (profile->valuestring != NULL)) {
+        strncpy(setup_struct->profile, profile->valuestring, sizeof(setup_struct->profile) - 1);
+        setup_struct->profile[sizeof(setup_struct->profile) - 1] = '\0';
+    } else {
+        setup_struct->profile[0] = '\0';
+    }
+
+    // Anchor coordinates are optional, with them the tag solves its position
+    setup_struct->anchor_count = 0;
+    anchor_list = cJSON_GetObjectItemCaseSensitive(json_msg, "anchors");
+    cJSON_ArrayForEach(anchor, anchor_list) {
+        if (setup_struct->anchor_count >= SIT_JSON_MAX_ANCHORS) {
+            LOG_ERR("Too many anchors");
+            break;
+        }
+        if (!cJSON_IsArray(anchor) || cJSON_GetArraySize(anchor) != 3) {
+            LOG_ERR("Anchor needs [x, y, z]");
+            setup_struct->anchor_count = 0;
+            break;
+        }
+        for (int i = 0; i < 3; i++) {
+            setup_struct->anchors[setup_struct->anchor_count][i] = (float)cJSON_GetArrayItem(anchor, i)->valuedouble;
+        }
+        setup_struct->anchor_count++;
+    }
+
     LOG_INF("Type: %s", type->valuestring);
     cJSON_Delete(json_msg);
 
@@ -0,0 +1,75 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file sit_test.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Checks of the host tests, a failed check is printed and the
+ *        test goes on. main() returns sit_test_result().
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __SIT_TEST_H__
+#define __SIT_TEST_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+static int sit_test_failed;
+
+#define SIT_CHECK(cond)                                                         \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            sit_test_failed++;                                                  \
+        }                                                                       \
+    } while (0)
+
+#define SIT_CHECK_EQ(actual, expected)                                          \
+    do {                                                                        \
+        int64_t a_ = (int64_t)(actual);                                         \
+        int64_t e_ = (int64_t)(expected);                                       \
+        if (a_ != e_) {                                                         \
+            printf("%s:%d: %s = %" PRId64 ", expected %" PRId64 "\n",           \
+                   __FILE__, __LINE__, #actual, a_, e_);                        \
+            sit_test_failed++;                                                  \
+        }                                                                       \
+    } while (0)
+
+#define SIT_CHECK_NEAR(actual, expected, tolerance)                             \
+    do {                                                                        \
+        double a_ = (double)(actual);                                           \
+        double e_ = (double)(expected);                                         \
+        if (!(a_ - e_ <= (tolerance) && e_ - a_ <= (tolerance))) {              \
+            printf("%s:%d: %s = %f, expected %f +- %f\n",                       \
+                   __FILE__, __LINE__, #actual, a_, e_, (double)(tolerance));   \
+            sit_test_failed++;                                                  \
+        }                                                                       \
+    } while (0)
+
+static inline int sit_test_result(const char *name) {
+    printf("%s: %s\n", name, sit_test_failed ? "FAILED" : "passed");
+    return sit_test_failed ? 1 : 0;
+}
+
+#endif // __SIT_TEST_H__
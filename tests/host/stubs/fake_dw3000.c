@@ -0,0 +1,492 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file fake_dw3000.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Fake DW3000 for the host tests.
+ *
+ * SPI cost model, one transaction per chip access of the Qorvo driver:
+ *  - every register read or write, dwt_writetxdata(), dwt_readrxdata(),
+ *    dw3000_spi_read_reg() and dw3000_spi_write_reg(): 1
+ *  - dwt_starttx() and dwt_rxenable(): 1 fast command, delayed ones 1
+ *    more for the late check of the status register
+ *  - dwt_isr(): SYS_STATUS read and clear, plus the frame info read for
+ *    a received frame
+ *
+ * Not modelled: preamble timeout, double buffer mode, STS, CIR.
+ *
+ * @bug No known bugs.
+ */
+
+#include "fake_dw3000.h"
+#include "host_stubs.h"
+
+#include "sit/sit_config.h"
+#include "sit/sit_ts.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <deca_device_api.h>
+#include <deca_regs.h>
+#include <dw3000_hw.h>
+#include <dw3000_spi.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/hwinfo.h>
+
+/* Time of a frame on air, the sys time moves on by this after TX and RX */
+#define FAKE_FRAME_UUS 200
+/* Calls of host_idle() without event until the fake gives up */
+#define FAKE_IDLE_LIMIT 1000
+#define FAKE_AIR_FRAMES 8
+#define FAKE_FRAME_MAX_LEN 127
+
+typedef struct {
+    uint8_t data[FAKE_FRAME_MAX_LEN];
+    uint16_t length;
+    uint64_t rx_ts;
+} fake_frame_t;
+
+static struct {
+    uint8_t tx_buffer[TX_BUFFER_LEN];
+    uint8_t rx_buffer[FAKE_FRAME_MAX_LEN];
+    uint16_t rx_length;
+    uint16_t tx_length;
+    uint16_t tx_offset;
+    uint64_t sys_time;
+    uint64_t tx_ts;
+    uint64_t rx_ts;
+    uint64_t rx_on_time;
+    uint32_t dx_time;
+    uint32_t status;
+    uint32_t int_mask;
+    uint32_t rx_after_tx_uus;
+    uint32_t rx_timeout_uus;
+    uint16_t tx_ant_dly;
+    uint16_t rx_ant_dly;
+    uint16_t address;
+    bool filter;
+    bool tx_pending;
+    bool rx_on;
+    bool in_isr;
+    uint32_t lose_irqs;
+    uint32_t idle;
+    dwt_cb_t cb_tx_done;
+    dwt_cb_t cb_rx_ok;
+    dwt_cb_t cb_rx_to;
+    dwt_cb_t cb_rx_err;
+    fake_dw3000_peer_t peer;
+    fake_frame_t air[FAKE_AIR_FRAMES];
+    uint32_t air_count;
+    fake_dw3000_stats_t stats;
+} fake;
+
+static void spi(void) {
+	if (fake.in_isr) {
+		fake.stats.isr_spi++;
+	} else {
+		fake.stats.spi++;
+	}
+}
+
+static void ts_write(uint8_t *ts_tab, uint64_t ts) {
+	for (int i = 0; i < 5; i++) {
+		ts_tab[i] = (uint8_t)(ts >> (8 * i));
+	}
+}
+
+void fake_dw3000_reset(void) {
+	memset(&fake, 0, sizeof(fake));
+	fake.sys_time = 0x0100000000ULL;
+	fake.tx_ant_dly = 16385;
+	fake.rx_ant_dly = 16385;
+}
+
+void fake_dw3000_set_peer(fake_dw3000_peer_t peer) {
+	fake.peer = peer;
+}
+
+void fake_dw3000_air(const void *frame, uint16_t length, uint64_t rx_ts) {
+	if (fake.air_count == FAKE_AIR_FRAMES || length > FAKE_FRAME_MAX_LEN) {
+		printf("fake_dw3000: frame of %u bytes does not fit on air\n", length);
+		abort();
+	}
+	fake_frame_t *air = &fake.air[fake.air_count++];
+	memcpy(air->data, frame, length);
+	air->length = length;
+	air->rx_ts = rx_ts & SIT_TS_MASK;
+}
+
+void fake_dw3000_lose_irqs(uint32_t count) {
+	fake.lose_irqs = count;
+}
+
+uint64_t fake_dw3000_time(void) {
+	return fake.sys_time;
+}
+
+uint16_t fake_dw3000_last_tx(uint8_t *frame) {
+	if (fake.stats.tx_frames == 0) {
+		return 0;
+	}
+	memcpy(frame, &fake.tx_buffer[fake.tx_offset], fake.tx_length);
+	return fake.tx_length;
+}
+
+void fake_dw3000_get_stats(fake_dw3000_stats_t *stats) {
+	*stats = fake.stats;
+}
+
+void fake_dw3000_reset_stats(void) {
+	memset(&fake.stats, 0, sizeof(fake.stats));
+}
+
+static void fake_transmit(uint64_t tx_ts, bool response) {
+	fake.tx_ts = tx_ts & SIT_TS_MASK;
+	fake.sys_time = sit_ts_add_uus(fake.tx_ts, FAKE_FRAME_UUS);
+	fake.tx_pending = true;
+	fake.rx_on = response;
+	fake.rx_on_time = sit_ts_add_uus(fake.sys_time, fake.rx_after_tx_uus);
+	fake.stats.tx_frames++;
+	if (fake.peer != NULL) {
+		fake.peer(&fake.tx_buffer[fake.tx_offset], fake.tx_length, fake.tx_ts);
+	}
+}
+
+static bool fake_late(void) {
+	return (int32_t)(fake.dx_time - (uint32_t)(fake.sys_time >> 8)) <= 0;
+}
+
+static void fake_air_drop(uint32_t count) {
+	fake.air_count -= count;
+	memmove(&fake.air[0], &fake.air[count], fake.air_count * sizeof(fake_frame_t));
+}
+
+static bool fake_addressed(const fake_frame_t *frame) {
+	const header_t *header = (const header_t *)frame->data;
+	uint16_t dest = header->dest | (header->dest_hi << 8);
+	return !fake.filter || dest == 0xFFFF || dest == fake.address;
+}
+
+/* Next interrupt of the chip, the receiver only takes frames sent after it was turned on */
+static uint32_t fake_next_event(void) {
+	if (fake.tx_pending) {
+		fake.tx_pending = false;
+		return DWT_INT_TXFRS_BIT_MASK;
+	}
+	if (!fake.rx_on) {
+		return 0;
+	}
+	while (fake.air_count > 0 && sit_ts_before(fake.air[0].rx_ts, fake.rx_on_time)) {
+		fake_air_drop(1);
+	}
+	sit_ts_t rx_end = sit_ts_add_uus(fake.rx_on_time, fake.rx_timeout_uus);
+	if (fake.air_count > 0 && (fake.rx_timeout_uus == 0 || !sit_ts_before(rx_end, fake.air[0].rx_ts))) {
+		fake_frame_t *frame = &fake.air[0];
+		fake.rx_on = false;
+		fake.sys_time = sit_ts_add_uus(frame->rx_ts, FAKE_FRAME_UUS);
+		if (!fake_addressed(frame)) {
+			fake_air_drop(1);
+			return DWT_INT_ARFE_BIT_MASK;
+		}
+		memcpy(fake.rx_buffer, frame->data, frame->length);
+		fake.rx_length = frame->length;
+		fake.rx_ts = frame->rx_ts;
+		fake.stats.rx_frames++;
+		fake_air_drop(1);
+		return DWT_INT_RXFCG_BIT_MASK;
+	}
+	if (fake.rx_timeout_uus != 0) {
+		fake.rx_on = false;
+		fake.sys_time = rx_end;
+		return DWT_INT_RXFTO_BIT_MASK;
+	}
+	return 0;
+}
+
+/* dwt_isr() of the Qorvo driver, one event per call */
+static void fake_isr(void) {
+	fake.in_isr = true;
+	fake.stats.irqs++;
+	spi();
+	dwt_cb_data_t cb_data = {
+		.status = fake.status,
+		.datalength = fake.rx_length,
+	};
+	dwt_cb_t cb = NULL;
+	if (fake.status & DWT_INT_RXFCG_BIT_MASK) {
+		spi();
+		cb = fake.cb_rx_ok;
+	} else if (fake.status & DWT_INT_TXFRS_BIT_MASK) {
+		cb = fake.cb_tx_done;
+	} else if (fake.status & SYS_STATUS_ALL_RX_TO) {
+		cb = fake.cb_rx_to;
+	} else if (fake.status & SYS_STATUS_ALL_RX_ERR) {
+		cb = fake.cb_rx_err;
+	}
+	spi();
+	fake.status = 0;
+	if (cb != NULL) {
+		cb(&cb_data);
+	}
+	fake.in_isr = false;
+}
+
+void host_idle(void) {
+	uint32_t event = fake_next_event();
+	if (event == 0) {
+		if (++fake.idle > FAKE_IDLE_LIMIT) {
+			printf("fake_dw3000: no event pending, the receiver waits forever\n");
+			abort();
+		}
+		return;
+	}
+	fake.idle = 0;
+	fake.status |= event;
+	if (!(event & fake.int_mask)) {
+		return;
+	}
+	if (fake.lose_irqs > 0) {
+		fake.lose_irqs--;
+		return;
+	}
+	fake_isr();
+}
+
+/* Qorvo driver */
+
+int dwt_configure(dwt_config_t *config) {
+	ARG_UNUSED(config);
+	spi();
+	return DWT_SUCCESS;
+}
+
+void dwt_setcallbacks(dwt_cb_t cbTxDone, dwt_cb_t cbRxOk, dwt_cb_t cbRxTo, dwt_cb_t cbRxErr,
+		      dwt_cb_t cbSPIErr, dwt_cb_t cbSPIRdy, dwt_cb_t cbDualSPIEv) {
+	ARG_UNUSED(cbSPIErr);
+	ARG_UNUSED(cbSPIRdy);
+	ARG_UNUSED(cbDualSPIEv);
+	fake.cb_tx_done = cbTxDone;
+	fake.cb_rx_ok = cbRxOk;
+	fake.cb_rx_to = cbRxTo;
+	fake.cb_rx_err = cbRxErr;
+}
+
+void dwt_setinterrupt(uint32_t bitmask_lo, uint32_t bitmask_hi, dwt_INT_options_e INT_options) {
+	ARG_UNUSED(bitmask_hi);
+	spi();
+	fake.int_mask = INT_options == DWT_DISABLE_INT ? fake.int_mask & ~bitmask_lo : bitmask_lo;
+}
+
+uint32_t dwt_readsysstatuslo(void) {
+	spi();
+	if (!fake.in_isr) {
+		fake.stats.status_reads++;
+	}
+	return fake.status;
+}
+
+uint32_t dwt_readsysstatushi(void) {
+	spi();
+	if (!fake.in_isr) {
+		fake.stats.status_reads++;
+	}
+	return 0;
+}
+
+void dwt_writesysstatuslo(uint32_t mask) {
+	spi();
+	fake.status &= ~mask;
+}
+
+uint32_t dwt_readsystimestamphi32(void) {
+	spi();
+	return (uint32_t)(fake.sys_time >> 8);
+}
+
+void dwt_setrxantennadelay(uint16_t antennaDly) {
+	spi();
+	fake.rx_ant_dly = antennaDly;
+}
+
+uint16_t dwt_getrxantennadelay(void) {
+	spi();
+	return fake.rx_ant_dly;
+}
+
+void dwt_settxantennadelay(uint16_t antennaDly) {
+	spi();
+	fake.tx_ant_dly = antennaDly;
+}
+
+uint16_t dwt_gettxantennadelay(void) {
+	spi();
+	return fake.tx_ant_dly;
+}
+
+int dwt_writetxdata(uint16_t txDataLength, uint8_t *txDataBytes, uint16_t txBufferOffset) {
+	spi();
+	memcpy(&fake.tx_buffer[txBufferOffset], txDataBytes, txDataLength);
+	return DWT_SUCCESS;
+}
+
+void dwt_writetxfctrl(uint16_t txFrameLength, uint16_t txBufferOffset, uint8_t ranging) {
+	ARG_UNUSED(ranging);
+	spi();
+	fake.tx_length = txFrameLength;
+	fake.tx_offset = txBufferOffset;
+}
+
+void dwt_setdelayedtrxtime(uint32_t starttime) {
+	spi();
+	fake.dx_time = starttime;
+}
+
+int dwt_starttx(uint8_t mode) {
+	spi();
+	if (mode & DWT_START_TX_DELAYED) {
+		spi();
+		if (fake_late()) {
+			return DWT_ERROR;
+		}
+		/* the low 9 bits of the TX time are ignored, the antenna delay is added */
+		fake_transmit(((uint64_t)(fake.dx_time & 0xFFFFFFFEUL) << 8) + fake.tx_ant_dly,
+			      mode & DWT_RESPONSE_EXPECTED);
+	} else {
+		fake_transmit(fake.sys_time + fake.tx_ant_dly, mode & DWT_RESPONSE_EXPECTED);
+	}
+	return DWT_SUCCESS;
+}
+
+int dwt_rxenable(int mode) {
+	spi();
+	if (mode & DWT_START_RX_DELAYED) {
+		spi();
+		if (fake_late() && (mode & DWT_IDLE_ON_DLY_ERR)) {
+			return DWT_ERROR;
+		}
+		fake.rx_on_time = fake_late() ? fake.sys_time : (uint64_t)fake.dx_time << 8;
+	} else {
+		fake.rx_on_time = fake.sys_time;
+	}
+	fake.rx_on = true;
+	return DWT_SUCCESS;
+}
+
+void dwt_forcetrxoff(void) {
+	spi();
+	fake.rx_on = false;
+	fake.tx_pending = false;
+}
+
+void dwt_setrxaftertxdelay(uint32_t rxDelayTime) {
+	spi();
+	fake.rx_after_tx_uus = rxDelayTime;
+}
+
+void dwt_setrxtimeout(uint32_t time) {
+	spi();
+	fake.rx_timeout_uus = time;
+}
+
+void dwt_setpreambledetecttimeout(uint16_t timeout) {
+	ARG_UNUSED(timeout);
+	spi();
+}
+
+void dwt_setpanid(uint16_t panID) {
+	ARG_UNUSED(panID);
+	spi();
+}
+
+void dwt_setaddress16(uint16_t shortAddress) {
+	spi();
+	fake.address = shortAddress;
+}
+
+void dwt_configureframefilter(uint16_t enabletype, uint16_t filtermode) {
+	ARG_UNUSED(filtermode);
+	spi();
+	fake.filter = enabletype != DWT_FF_DISABLE;
+}
+
+uint16_t dwt_getframelength(void) {
+	spi();
+	return fake.rx_length;
+}
+
+void dwt_readrxdata(uint8_t *buffer, uint16_t length, uint16_t rxBufferOffset) {
+	spi();
+	memcpy(buffer, &fake.rx_buffer[rxBufferOffset], length);
+}
+
+void dwt_readtxtimestamp(uint8_t *timestamp) {
+	spi();
+	ts_write(timestamp, fake.tx_ts);
+}
+
+void dwt_readrxtimestamp(uint8_t *timestamp) {
+	spi();
+	ts_write(timestamp, fake.rx_ts);
+}
+
+/* Platform layer */
+
+int dw3000_spi_read_reg(uint32_t reg_id, uint16_t length, uint8_t *buffer) {
+	spi();
+	memset(buffer, 0, length);
+	if (reg_id >= RX_BUFFER_0_ID && reg_id + length <= RX_BUFFER_0_ID + sizeof(fake.rx_buffer)) {
+		memcpy(buffer, &fake.rx_buffer[reg_id - RX_BUFFER_0_ID], length);
+		return 0;
+	}
+	/* register file 0 with frame info and timestamps */
+	uint8_t regs[TX_TIME_LO_ID + 5] = {0};
+	if (reg_id + length > sizeof(regs)) {
+		return -1;
+	}
+	regs[RX_FINFO_ID] = (uint8_t)fake.rx_length;
+	regs[RX_FINFO_ID + 1] = (uint8_t)(fake.rx_length >> 8) & (RX_FINFO_RXFLEN_BIT_MASK >> 8);
+	ts_write(&regs[RX_TIME_0_ID], fake.rx_ts);
+	ts_write(&regs[TX_TIME_LO_ID], fake.tx_ts);
+	memcpy(buffer, &regs[reg_id], length);
+	return 0;
+}
+
+int dw3000_spi_write_reg(uint32_t reg_id, uint16_t length, const uint8_t *buffer) {
+	spi();
+	if (reg_id < TX_BUFFER_ID || reg_id + length > TX_BUFFER_ID + TX_BUFFER_LEN) {
+		return -1;
+	}
+	memcpy(&fake.tx_buffer[reg_id - TX_BUFFER_ID], buffer, length);
+	return 0;
+}
+
+int dw3000_hw_init_interrupt(void) {
+	return 0;
+}
+
+ssize_t hwinfo_get_device_id(uint8_t *buffer, size_t length) {
+	memset(buffer, 0x5A, length);
+	return (ssize_t)length;
+}
@@ -0,0 +1,116 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file fake_dw3000.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Fake DW3000 for the host tests.
+ *
+ * The fake implements the part of the Qorvo driver and of the platform
+ * SPI layer the SIT radio code uses, with the TX buffer, the RX buffer
+ * and the timestamps of the chip. A peer function answers the sent
+ * frames, its frames are received when the receiver is on. Pending
+ * interrupts are run by host_idle(), which k_msgq_get() calls while the
+ * ranging thread waits for an event, like dwt_isr() in dw3000_hw.c.
+ *
+ * Every access of the driver to the chip is counted as SPI transaction,
+ * see the cost model in fake_dw3000.c.
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __FAKE_DW3000_H__
+#define __FAKE_DW3000_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t spi;           ///< SPI transactions of the ranging thread
+    uint32_t isr_spi;       ///< SPI transactions of the dwt_isr() model
+    uint32_t status_reads;  ///< SYS_STATUS reads of the ranging thread
+    uint32_t irqs;          ///< interrupts handled by the dwt_isr() model
+    uint32_t tx_frames;     ///< frames sent
+    uint32_t rx_frames;     ///< frames received
+} fake_dw3000_stats_t;
+
+/***************************************************************************
+ * Peer of the fake, called for every sent frame. It answers with
+ * fake_dw3000_air().
+ *
+ * @param frame     ->  sent frame, the FCS is not filled in
+ * @param length    ->  frame length incl. FCS
+ * @param tx_ts     ->  40 bit TX time
+ *
+****************************************************************************/
+typedef void (*fake_dw3000_peer_t)(const uint8_t *frame, uint16_t length, uint64_t tx_ts);
+
+/***************************************************************************
+ * Power up state: no frames on air, no peer, stats cleared, the antenna
+ * delays are the defaults of sit_config.c
+ *
+ * @return None
+ *
+****************************************************************************/
+void fake_dw3000_reset(void);
+
+void fake_dw3000_set_peer(fake_dw3000_peer_t peer);
+
+/***************************************************************************
+ * Put a frame on air. It is received if the receiver is on at rx_ts,
+ * frames are taken in the order they are put on air.
+ *
+ * @param frame     ->  frame, the last 2 bytes are the FCS
+ * @param length    ->  frame length incl. FCS
+ * @param rx_ts     ->  40 bit RX time of the frame in the fake's time
+ *
+ * @return None
+ *
+****************************************************************************/
+void fake_dw3000_air(const void *frame, uint16_t length, uint64_t rx_ts);
+
+/***************************************************************************
+ * Lose the IRQ edge of the next count interrupts, the events are only
+ * in the status register
+ *
+ * @return None
+ *
+****************************************************************************/
+void fake_dw3000_lose_irqs(uint32_t count);
+
+/* 40 bit system time of the fake */
+uint64_t fake_dw3000_time(void);
+
+/***************************************************************************
+ * Copy the last sent frame
+ *
+ * @param frame     ->  buffer of at least 127 bytes
+ *
+ * @return length of the frame incl. FCS, 0 if nothing was sent
+ *
+****************************************************************************/
+uint16_t fake_dw3000_last_tx(uint8_t *frame);
+
+void fake_dw3000_get_stats(fake_dw3000_stats_t *stats);
+
+void fake_dw3000_reset_stats(void);
+
+#endif // __FAKE_DW3000_H__
@@ -0,0 +1,73 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file host_stubs.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Kernel fakes and settings of the host tests, the radio is
+ *        fake_dw3000.c.
+ *
+ * @bug No known bugs.
+ */
+
+#include "host_stubs.h"
+
+#include "sit/sit.h"
+#include "sit/sit_config.h"
+
+#include <deca_device_api.h>
+
+device_settings_t device_settings = {
+	.deviceID = 1,
+	.tx_ant_dly = 16385,
+	.rx_ant_dly = 16385,
+};
+
+/* the default profile of sit_config.c */
+dwt_config_t sit_device_config = {
+	.chan = 9,
+	.txPreambLength = DWT_PLEN_512,
+	.rxPAC = DWT_PAC32,
+	.txCode = 9,
+	.rxCode = 9,
+	.sfdType = DWT_SFD_DW_8,
+	.dataRate = DWT_BR_6M8,
+	.phrMode = DWT_PHRMODE_STD,
+	.phrRate = DWT_PHRRATE_STD,
+	.sfdTO = (512 + 1 + 8 - 32),
+	.stsMode = DWT_STS_MODE_OFF,
+	.stsLength = DWT_STS_LEN_64,
+	.pdoaMode = DWT_PDOA_M0,
+};
+
+static int64_t uptime_ms;
+
+void host_set_uptime(int64_t ms) {
+	uptime_ms = ms;
+}
+
+int64_t k_uptime_get(void) {
+	return uptime_ms;
+}
+
+/* sit.c is not part of the host build */
+void sit_radio_restore(void) {
+}
@@ -0,0 +1,43 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file host_stubs.h
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Kernel fakes and settings of the host tests.
+ *
+ * device_settings and sit_device_config are the defaults of sit_config.c
+ * with device ID 1, the uptime only moves with host_set_uptime().
+ *
+ * @bug No known bugs.
+ */
+
+#ifndef __HOST_STUBS_H__
+#define __HOST_STUBS_H__
+
+#include <stdint.h>
+
+void host_set_uptime(int64_t ms);
+
+/* Called by k_msgq_get() on an empty queue, runs the next interrupt of the fake DW3000 */
+void host_idle(void);
+
+#endif // __HOST_STUBS_H__
@@ -0,0 +1,11 @@
+/*
+ * Host stub of <zephyr/data/json.h> for tests/host, the tested modules
+ * only need the headers that include it
+ */
+
+#ifndef __HOST_ZEPHYR_JSON_H__
+#define __HOST_ZEPHYR_JSON_H__
+
+#include <zephyr/kernel.h>
+
+#endif // __HOST_ZEPHYR_JSON_H__
@@ -0,0 +1,15 @@
+/*
+ * Host stub of <zephyr/drivers/hwinfo.h> for tests/host, implemented by
+ * the fake DW3000 (fake_dw3000.c)
+ */
+
+#ifndef __HOST_ZEPHYR_HWINFO_H__
+#define __HOST_ZEPHYR_HWINFO_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+ssize_t hwinfo_get_device_id(uint8_t *buffer, size_t length);
+
+#endif // __HOST_ZEPHYR_HWINFO_H__
@@ -0,0 +1,102 @@
+/*
+ * Host stub of <zephyr/kernel.h> for tests/host, only what the
+ * SIT modules use. The tests run single threaded, the mutex is a no-op
+ * and the uptime is set by the test. A message queue which is empty on
+ * k_msgq_get() calls host_idle() once, the fake DW3000 runs its ISR there.
+ */
+
+#ifndef __HOST_ZEPHYR_KERNEL_H__
+#define __HOST_ZEPHYR_KERNEL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <zephyr/toolchain.h>
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define BIT(n) (1UL << (n))
+#define ARG_UNUSED(x) (void)(x)
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define CLAMP(val, low, high) (((val) <= (low)) ? (low) : MIN(val, high))
+#define ROUND_UP(x, align) ((((x) + (align) - 1) / (align)) * (align))
+#define __ASSERT_NO_MSG(test) assert(test)
+#define IS_ENABLED(config) 0
+
+typedef struct {
+    int64_t ticks;
+} k_timeout_t;
+
+#define K_NO_WAIT ((k_timeout_t){0})
+#define K_FOREVER ((k_timeout_t){-1})
+#define K_MSEC(ms) ((k_timeout_t){(ms)})
+
+struct k_mutex {
+    int locked;
+};
+
+#define K_MUTEX_DEFINE(name) struct k_mutex name
+
+static inline int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout) {
+    ARG_UNUSED(timeout);
+    mutex->locked++;
+    return 0;
+}
+
+static inline int k_mutex_unlock(struct k_mutex *mutex) {
+    mutex->locked--;
+    return 0;
+}
+
+/* Uptime in ms, see host_stubs.h */
+int64_t k_uptime_get(void);
+
+/* Called by k_msgq_get() on an empty queue, see host_stubs.h */
+void host_idle(void);
+
+struct k_msgq {
+    char *buffer;
+    size_t msg_size;
+    uint32_t max_msgs;
+    uint32_t read;
+    uint32_t used;
+};
+
+#define K_MSGQ_DEFINE(name, size, max, align)                                   \
+    static char name##_buffer[(size) * (max)];                                  \
+    struct k_msgq name = {name##_buffer, (size), (max), 0, 0}
+
+static inline int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout) {
+    ARG_UNUSED(timeout);
+    if (msgq->used == msgq->max_msgs) {
+        return -ENOMSG;
+    }
+    uint32_t write = (msgq->read + msgq->used) % msgq->max_msgs;
+    memcpy(msgq->buffer + write * msgq->msg_size, data, msgq->msg_size);
+    msgq->used++;
+    return 0;
+}
+
+static inline int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout) {
+    if (msgq->used == 0 && timeout.ticks != 0) {
+        host_idle();
+    }
+    if (msgq->used == 0) {
+        return timeout.ticks != 0 ? -EAGAIN : -ENOMSG;
+    }
+    memcpy(data, msgq->buffer + msgq->read * msgq->msg_size, msgq->msg_size);
+    msgq->read = (msgq->read + 1) % msgq->max_msgs;
+    msgq->used--;
+    return 0;
+}
+
+static inline void k_msgq_purge(struct k_msgq *msgq) {
+    msgq->read = 0;
+    msgq->used = 0;
+}
+
+#endif // __HOST_ZEPHYR_KERNEL_H__
@@ -0,0 +1,28 @@
+/*
+ * Host stub of <zephyr/logging/log.h> for tests/host, logging is dropped,
+ * the arguments are still used
+ */
+
+#ifndef __HOST_ZEPHYR_LOG_H__
+#define __HOST_ZEPHYR_LOG_H__
+
+#include <zephyr/kernel.h>
+
+#define LOG_LEVEL_ERR 1
+#define LOG_LEVEL_WRN 2
+#define LOG_LEVEL_INF 3
+#define LOG_LEVEL_DBG 4
+
+#define LOG_MODULE_REGISTER(...)
+#define LOG_MODULE_DECLARE(...)
+
+static inline void host_log(const char *fmt, ...) {
+    ARG_UNUSED(fmt);
+}
+
+#define LOG_ERR(...) host_log(__VA_ARGS__)
+#define LOG_WRN(...) host_log(__VA_ARGS__)
+#define LOG_INF(...) host_log(__VA_ARGS__)
+#define LOG_DBG(...) host_log(__VA_ARGS__)
+
+#endif // __HOST_ZEPHYR_LOG_H__
@@ -0,0 +1,39 @@
+/*
+ * Host stub of <zephyr/sys/atomic.h> for tests/host, the tests run
+ * single threaded, the fake DW3000 ISR runs in the idle hook of the
+ * waiting thread.
+ */
+
+#ifndef __HOST_ZEPHYR_ATOMIC_H__
+#define __HOST_ZEPHYR_ATOMIC_H__
+
+#include <stdbool.h>
+
+typedef long atomic_t;
+typedef atomic_t atomic_val_t;
+
+static inline atomic_val_t atomic_get(const atomic_t *target) {
+    return *target;
+}
+
+static inline atomic_val_t atomic_set(atomic_t *target, atomic_val_t value) {
+    atomic_val_t old = *target;
+    *target = value;
+    return old;
+}
+
+static inline atomic_val_t atomic_add(atomic_t *target, atomic_val_t value) {
+    atomic_val_t old = *target;
+    *target += value;
+    return old;
+}
+
+static inline atomic_val_t atomic_inc(atomic_t *target) {
+    return atomic_add(target, 1);
+}
+
+static inline atomic_val_t atomic_clear(atomic_t *target) {
+    return atomic_set(target, 0);
+}
+
+#endif // __HOST_ZEPHYR_ATOMIC_H__
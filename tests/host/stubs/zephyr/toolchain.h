@@ -0,0 +1,11 @@
+/*
+ * Host stub of <zephyr/toolchain.h> for tests/host
+ */
+
+#ifndef __HOST_ZEPHYR_TOOLCHAIN_H__
+#define __HOST_ZEPHYR_TOOLCHAIN_H__
+
+#define __packed __attribute__((__packed__))
+#define BUILD_ASSERT(cond, ...) _Static_assert(cond, "" __VA_ARGS__)
+
+#endif // __HOST_ZEPHYR_TOOLCHAIN_H__
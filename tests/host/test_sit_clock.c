@@ -0,0 +1,159 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+/**
+ * @file test_sit_clock.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the clock skew filter, CI and sync samples of a
+ *        peer with a known skew.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "host_stubs.h"
+
+#include "sit/sit_clock.h"
+#include "sit/sit_config.h"
+#include "sit/sit_tof.h"
+#include "sit/sit_ts.h"
+
+#include <math.h>
+
+#include <deca_device_api.h>
+
+#define PEER_ID 100
+#define SYNC_PERIOD_MS 250
+/* DW3000 time units per ms */
+#define DTU_PER_MS 63897600ULL
+
+static int64_t now_ms;
+
+/* deterministic noise in [-1, 1] */
+static double noise(void) {
+	static uint32_t state = 12345;
+	state = state * 1103515245U + 12345U;
+	return (double)((state >> 8) & 0xFFFF) / 32767.5 - 1.0;
+}
+
+/* carrier integrator of a frame of a peer with the given skew */
+static int32_t ci_of_skew(double skew) {
+	double hz_to_ppm = (sit_device_config.chan == 5) ? HERTZ_TO_PPM_MULTIPLIER_CHAN_5 : HERTZ_TO_PPM_MULTIPLIER_CHAN_9;
+	return (int32_t)lround(skew / (FREQ_OFFSET_MULTIPLIER * hz_to_ppm / 1.0e6));
+}
+
+/* own and peer clock of the sync samples */
+static uint64_t local_ts;
+static uint64_t peer_ts;
+
+static void sync_start(uint64_t local, uint64_t peer) {
+	local_ts = local;
+	peer_ts = peer;
+}
+
+/* sync samples of a peer with the given skew */
+static void feed_sync(double skew, int count) {
+	for (int i = 0; i < count; i++) {
+		now_ms += SYNC_PERIOD_MS;
+		host_set_uptime(now_ms);
+		local_ts = sit_ts_add(local_ts, SYNC_PERIOD_MS * DTU_PER_MS);
+		peer_ts = sit_ts_add(peer_ts, llround(SYNC_PERIOD_MS * DTU_PER_MS * (1.0 + skew)));
+		/* about 1 dtu noise of the timestamps */
+		sit_clock_update_sync(PEER_ID, sit_ts_add(peer_ts, lround(noise())), local_ts);
+	}
+}
+
+/* filtered skew in ppm */
+static double skew_ppm(void) {
+	return sit_clock_skew(PEER_ID) * 1e6;
+}
+
+static void test_no_peer(void) {
+	sit_clock_reset();
+	SIT_CHECK_NEAR(skew_ppm(), 0.0, 0.0);
+}
+
+static void test_ci(void) {
+	static const double skews_ppm[] = {3.0, -7.0, 0.2};
+
+	for (size_t i = 0; i < ARRAY_SIZE(skews_ppm); i++) {
+		sit_clock_reset();
+		for (int n = 0; n < 50; n++) {
+			now_ms += 10;
+			host_set_uptime(now_ms);
+			/* 0.1 ppm noise of the carrier integrator */
+			sit_clock_update_ci(PEER_ID, ci_of_skew((skews_ppm[i] + 0.1 * noise()) * 1e-6));
+		}
+		SIT_CHECK_NEAR(skew_ppm(), skews_ppm[i], 0.05);
+		/* same sign as the skew of the SS-TWR */
+		SIT_CHECK((skew_ppm() > 0) == (sit_tof_ci_to_skew_q40(ci_of_skew(skews_ppm[i] * 1e-6)) > 0));
+	}
+}
+
+static void test_sync(void) {
+	static const double skews_ppm[] = {5.0, -12.0};
+
+	for (size_t i = 0; i < ARRAY_SIZE(skews_ppm); i++) {
+		sit_clock_reset();
+		sync_start(1000, 5000);
+		/* the first sync only sets the reference */
+		feed_sync(skews_ppm[i] * 1e-6, 1);
+		SIT_CHECK_NEAR(skew_ppm(), 0.0, 0.0);
+
+		feed_sync(skews_ppm[i] * 1e-6, 3);
+		double early_error = fabs(skew_ppm() - skews_ppm[i]);
+		feed_sync(skews_ppm[i] * 1e-6, 40);
+		double error = fabs(skew_ppm() - skews_ppm[i]);
+		SIT_CHECK(error < 0.001);
+		SIT_CHECK(error <= early_error + 0.0005);
+		SIT_CHECK((skew_ppm() > 0) == (skews_ppm[i] > 0));
+	}
+}
+
+static void test_sync_wrap(void) {
+	sit_clock_reset();
+	/* both clocks wrap within the samples */
+	sync_start(SIT_TS_MASK - 5 * SYNC_PERIOD_MS * DTU_PER_MS, SIT_TS_MASK - 7 * SYNC_PERIOD_MS * DTU_PER_MS);
+	feed_sync(8e-6, 20);
+	SIT_CHECK_NEAR(skew_ppm(), 8.0, 0.001);
+}
+
+static void test_ci_then_sync(void) {
+	sit_clock_reset();
+	/* a coarse CI estimate, the sync samples pull it to the exact skew */
+	for (int n = 0; n < 5; n++) {
+		now_ms += 10;
+		host_set_uptime(now_ms);
+		sit_clock_update_ci(PEER_ID, ci_of_skew(4.3e-6));
+	}
+	SIT_CHECK_NEAR(skew_ppm(), 4.3, 0.01);
+	sync_start(0, 0);
+	feed_sync(4.0e-6, 40);
+	SIT_CHECK_NEAR(skew_ppm(), 4.0, 0.01);
+}
+
+int main(void) {
+	test_no_peer();
+	test_ci();
+	test_sync();
+	test_sync_wrap();
+	test_ci_then_sync();
+	return sit_test_result("sit_clock");
+}
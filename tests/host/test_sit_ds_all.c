@@ -0,0 +1,167 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_ds_all.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the all to all DS-TWR between an initiator and a
+ *        responder, across the 40 bit wrap and with too long spans.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+
+#include "sit/sit_ds_all.h"
+#include "sit/sit_profile.h"
+#include "sit/sit_ts.h"
+
+#include <string.h>
+
+#define OWN_ID 1
+#define PEER_ID 100
+#define NODES 2
+/* 10 m */
+#define TOF_DTU 2132
+#define DISTANCE_MM 10000
+
+/* Clocks of the initiator and the responder, own = peer + offset */
+typedef struct {
+    ds_all_ctx_t own;
+    ds_all_ctx_t peer;
+    uint64_t offset;
+} link_t;
+
+static uint64_t to_own(const link_t *link, uint64_t peer_ts) {
+	return sit_ts_add(peer_ts, (int64_t)link->offset);
+}
+
+static uint64_t to_peer(const link_t *link, uint64_t own_ts) {
+	return sit_ts_add(own_ts, -(int64_t)link->offset);
+}
+
+static void link_init(link_t *link, uint64_t offset) {
+	sit_ds_all_init(&link->own, OWN_ID, NODES);
+	sit_ds_all_init(&link->peer, PEER_ID, NODES);
+	link->offset = offset & SIT_TS_MASK;
+}
+
+/* Frame of the peer sent at tx_ts (peer clock), returns the RX time of the own node */
+static bool peer_send(link_t *link, uint64_t tx_ts, uint64_t *rx_ts, ds_all_result_t *result) {
+	msg_ds_all_twr_t msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.header.source = PEER_ID;
+	sit_ds_all_fill(&link->peer, &msg, tx_ts);
+	sit_ds_all_tx_done(&link->peer, tx_ts);
+	*rx_ts = sit_ts_add(to_own(link, tx_ts), TOF_DTU);
+	return sit_ds_all_rx(&link->own, &msg, *rx_ts, result);
+}
+
+/* Frame of the own node sent at tx_ts (own clock), returns the RX time of the peer */
+static bool own_send(link_t *link, uint64_t tx_ts, uint64_t *rx_ts, ds_all_result_t *result) {
+	msg_ds_all_twr_t msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.header.source = OWN_ID;
+	sit_ds_all_fill(&link->own, &msg, tx_ts);
+	sit_ds_all_tx_done(&link->own, tx_ts);
+	*rx_ts = sit_ts_add(to_peer(link, tx_ts), TOF_DTU);
+	return sit_ds_all_rx(&link->peer, &msg, *rx_ts, result);
+}
+
+/* peer -> own -> peer -> own, both nodes get a distance from the last two frames */
+static void test_exchange(uint64_t start, uint64_t offset, uint32_t reply) {
+	link_t link;
+	ds_all_result_t result;
+	uint64_t rx_ts;
+
+	link_init(&link, offset);
+	SIT_CHECK(!peer_send(&link, start, &rx_ts, &result));
+	SIT_CHECK(!own_send(&link, sit_ts_add(rx_ts, reply), &rx_ts, &result));
+
+	memset(&result, 0, sizeof(result));
+	SIT_CHECK(peer_send(&link, sit_ts_add(rx_ts, reply), &rx_ts, &result));
+	SIT_CHECK_EQ(result.peer_id, PEER_ID);
+	SIT_CHECK_EQ(result.time_round_1, 2 * TOF_DTU + reply);
+	SIT_CHECK_EQ(result.time_reply_1, reply);
+	SIT_CHECK_EQ(result.distance_mm, DISTANCE_MM);
+
+	memset(&result, 0, sizeof(result));
+	SIT_CHECK(own_send(&link, sit_ts_add(rx_ts, reply), &rx_ts, &result));
+	SIT_CHECK_EQ(result.peer_id, OWN_ID);
+	SIT_CHECK_EQ(result.distance_mm, DISTANCE_MM);
+}
+
+/* a reply beyond 32 bit is dropped, the next exchange is taken again */
+static void test_long_span(void) {
+	link_t link;
+	ds_all_result_t result;
+	uint64_t rx_ts;
+	uint32_t reply = 1000000;
+
+	link_init(&link, 0x7000000000ULL);
+	SIT_CHECK(!peer_send(&link, SIT_TS_MASK - 1000, &rx_ts, &result));
+	SIT_CHECK(!own_send(&link, sit_ts_add(rx_ts, (int64_t)UINT32_MAX + 1), &rx_ts, &result));
+	SIT_CHECK(!peer_send(&link, sit_ts_add(rx_ts, reply), &rx_ts, &result));
+	SIT_CHECK(own_send(&link, sit_ts_add(rx_ts, reply), &rx_ts, &result));
+	SIT_CHECK_EQ(result.distance_mm, DISTANCE_MM);
+
+	SIT_CHECK(sit_ds_all_span_valid(UINT32_MAX));
+	SIT_CHECK(!sit_ds_all_span_valid((uint64_t)UINT32_MAX + 1));
+}
+
+/* frames out of order in one of the clocks are no exchange */
+static void test_order(void) {
+	link_t link;
+	ds_all_result_t result;
+	uint64_t rx_ts;
+
+	link_init(&link, 0);
+	SIT_CHECK(!peer_send(&link, 1000000, &rx_ts, &result));
+	/* own frame before the RX of the first peer frame */
+	SIT_CHECK(!own_send(&link, rx_ts - 500000, &rx_ts, &result));
+	SIT_CHECK(!peer_send(&link, sit_ts_add(rx_ts, 1000000), &rx_ts, &result));
+}
+
+static void test_slots(void) {
+	uint32_t airtime_uus = sit_profile_airtime_uus(sizeof(msg_ds_all_twr_t));
+
+	SIT_CHECK_EQ(sit_ds_all_node_index(OWN_ID), 0);
+	SIT_CHECK_EQ(sit_ds_all_node_index(100), 1);
+	SIT_CHECK_EQ(sit_ds_all_node_index(107), 8);
+
+	SIT_CHECK_EQ(sit_ds_all_slot_uus(0, 3), 0);
+	SIT_CHECK_EQ(sit_ds_all_slot_uus(1, 3), DS_ALL_RESP_DLY_UUS);
+	SIT_CHECK_EQ(sit_ds_all_slot_uus(2, 3), DS_ALL_RESP_DLY_UUS + DS_ALL_SLOT_GAP_UUS + airtime_uus);
+	SIT_CHECK_EQ(sit_ds_all_slot_uus(3, 3),
+		     DS_ALL_RESP_DLY_UUS + 2 * (DS_ALL_SLOT_GAP_UUS + airtime_uus) + DS_ALL_FINAL_DLY_UUS);
+}
+
+int main(void) {
+	test_exchange(1000000, 0, 1000000);
+	/* own clock wraps between the frames */
+	test_exchange(0x1000, SIT_TS_MASK - 0x100000, 1000000);
+	/* peer clock wraps, long replies */
+	test_exchange(SIT_TS_MASK - 5000000, 0x4000000000ULL, 40000000);
+	test_long_span();
+	test_order();
+	test_slots();
+	return sit_test_result("sit_ds_all");
+}
@@ -0,0 +1,184 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_event.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the interrupt driven event path, a DS-TWR cycle on
+ *        the fake DW3000 with the SPI transactions it costs.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "fake_dw3000.h"
+
+#include "sit/sit.h"
+#include "sit/sit_config.h"
+#include "sit/sit_event.h"
+#include "sit/sit_frame.h"
+#include "sit/sit_reply.h"
+#include "sit/sit_shadow.h"
+#include "sit/sit_ts.h"
+#include "sit/sit_twr.h"
+#include "sit/sit_tx_template.h"
+
+#include <math.h>
+
+#include <deca_device_api.h>
+
+#define RESPONDER_ID 100
+#define RESPONDER_REPLY_UUS 1000
+#define DISTANCE_MM 5000
+
+/*
+ * SPI transactions of the ranging thread in a DS-TWR cycle, no register
+ * of the shadow changes:
+ *  poll:           status clear, TX data, TX frame control, TX start  4
+ *  response:       status clear, frame info and timestamps, RX data   3
+ *  final:          antenna delay, template update, TX frame control,
+ *                  delayed time, system time, TX start with late
+ *                  check, status clear                                 8
+ *  final response: status clear, frame info and timestamps, RX data   3
+ */
+#define DS_TWR_CYCLE_SPI 18
+/* dwt_isr() of two TX and two RX events */
+#define DS_TWR_CYCLE_ISR_SPI (2 * 2 + 2 * 3)
+
+static sit_ts_t tof_dtu;
+static sit_ts_t poll_rx_ts;
+static sit_ts_t resp_tx_ts;
+
+/* DS-TWR responder on the clock of the fake */
+static void responder_peer(const uint8_t *frame, uint16_t length, uint64_t tx_ts) {
+	ARG_UNUSED(length);
+	const header_t *header = (const header_t *)frame;
+	sit_ts_t rx_ts = sit_ts_add(tx_ts, tof_dtu);
+
+	if (header->dest != RESPONDER_ID) {
+		return;
+	}
+	if (sit_frame_id(header) == twr_1_poll) {
+		msg_simple_t resp = {SIT_HEADER(ds_twr_2_resp, header->sequence, RESPONDER_ID, header->source), 0};
+		poll_rx_ts = rx_ts;
+		resp_tx_ts = sit_ts_add_uus(rx_ts, RESPONDER_REPLY_UUS);
+		fake_dw3000_air(&resp, sizeof(resp), sit_ts_add(resp_tx_ts, tof_dtu));
+	} else if (sit_frame_id(header) == ds_twr_3_final) {
+		msg_ds_twr_resp_t final_resp = {SIT_HEADER(ds_twr_4_final, header->sequence, RESPONDER_ID, header->source),
+			{{0}}, {{0}}, {{0}}, 0};
+		sit_ts_pack(&final_resp.poll_rx_ts, poll_rx_ts);
+		sit_ts_pack(&final_resp.resp_tx_ts, resp_tx_ts);
+		sit_ts_pack(&final_resp.final_rx_ts, rx_ts);
+		fake_dw3000_air(&final_resp, sizeof(final_resp),
+				sit_ts_add(sit_ts_add_uus(rx_ts, RESPONDER_REPLY_UUS), tof_dtu));
+	}
+}
+
+static void radio_init(void) {
+	fake_dw3000_reset();
+	sit_shadow_reset();
+	sit_reply_reset();
+	sit_tpl_init();
+	SIT_CHECK_EQ(sit_event_init(), 0);
+	tof_dtu = (sit_ts_t)llround(DISTANCE_MM / 1000.0 / SPEED_OF_LIGHT / DWT_TIME_UNITS);
+}
+
+static void test_ds_twr_cycle(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+	fake_dw3000_stats_t stats;
+	sit_event_stats_t events_before, events;
+
+	radio_init();
+	fake_dw3000_set_peer(responder_peer);
+	sit_twr_init(ctx, RESPONDER_ID, true);
+
+	/* the first cycle also writes the RX timing registers */
+	SIT_CHECK(sit_twr_run(&ctx[0], 1, 0));
+	SIT_CHECK_NEAR(ctx[0].distance_mm, DISTANCE_MM, 10);
+
+	sit_event_get_stats(&events_before);
+	fake_dw3000_reset_stats();
+	SIT_CHECK(sit_twr_run(&ctx[0], 2, 0));
+	SIT_CHECK_NEAR(ctx[0].distance_mm, DISTANCE_MM, 10);
+	fake_dw3000_get_stats(&stats);
+	sit_event_get_stats(&events);
+	printf("DS-TWR cycle: %u SPI transactions, %u in dwt_isr(), %u status reads\n",
+	       stats.spi, stats.isr_spi, stats.status_reads);
+
+	SIT_CHECK_EQ(stats.tx_frames, 2);
+	SIT_CHECK_EQ(stats.rx_frames, 2);
+	SIT_CHECK_EQ(stats.irqs, 4);
+	/* the thread sleeps on the event queue, SYS_STATUS is only read by dwt_isr() */
+	SIT_CHECK_EQ(stats.status_reads, 0);
+	SIT_CHECK_EQ(stats.spi, DS_TWR_CYCLE_SPI);
+	SIT_CHECK_EQ(stats.isr_spi, DS_TWR_CYCLE_ISR_SPI);
+	SIT_CHECK_EQ(events.events - events_before.events, 4);
+	SIT_CHECK_EQ(events.timeouts, 0);
+	SIT_CHECK_EQ(events.lost, 0);
+	SIT_CHECK_EQ(events.dropped, 0);
+}
+
+static void test_lost_irq(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+	fake_dw3000_stats_t stats;
+	sit_event_stats_t events_before, events;
+
+	radio_init();
+	fake_dw3000_set_peer(responder_peer);
+	sit_twr_init(ctx, RESPONDER_ID, true);
+	sit_event_get_stats(&events_before);
+	fake_dw3000_reset_stats();
+
+	/* IRQ edges of the poll TX and the response RX are lost */
+	fake_dw3000_lose_irqs(2);
+	SIT_CHECK(sit_twr_run(&ctx[0], 1, 0));
+	SIT_CHECK_NEAR(ctx[0].distance_mm, DISTANCE_MM, 10);
+	fake_dw3000_get_stats(&stats);
+	sit_event_get_stats(&events);
+
+	/* both event timeouts read SYS_STATUS low and high, the second one finds the response */
+	SIT_CHECK_EQ(events.timeouts - events_before.timeouts, 2);
+	SIT_CHECK_EQ(events.lost - events_before.lost, 1);
+	SIT_CHECK_EQ(stats.status_reads, 2 * 2);
+}
+
+static void test_no_response(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+	fake_dw3000_stats_t stats;
+
+	radio_init();
+	sit_twr_init(ctx, RESPONDER_ID, true);
+	fake_dw3000_reset_stats();
+
+	/* the RX timeout event ends the exchange */
+	SIT_CHECK(!sit_twr_run(&ctx[0], 1, 0));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_timeout);
+	fake_dw3000_get_stats(&stats);
+	SIT_CHECK_EQ(stats.irqs, 2);
+	SIT_CHECK_EQ(stats.rx_frames, 0);
+}
+
+int main(void) {
+	test_ds_twr_cycle();
+	test_lost_irq();
+	test_no_response();
+	return sit_test_result("sit_event");
+}
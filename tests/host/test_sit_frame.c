@@ -0,0 +1,115 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_frame.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the frame check and the airtime calculation.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "fake_dw3000.h"
+
+#include "sit/sit_frame.h"
+#include "sit/sit_config.h"
+#include "sit/sit_distance.h"
+#include "sit/sit_event.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static void test_valid(void) {
+	msg_simple_t msg = {SIT_HEADER(simple_poll, 7, 1, 100), 0};
+
+	SIT_CHECK(sit_frame_valid((const uint8_t *)&msg, sizeof(msg)));
+	SIT_CHECK(!sit_frame_valid((const uint8_t *)&msg, sizeof(header_t) + 1));
+
+	msg.header.msg = SIT_MSG_BYTE(simple_poll, SIT_FRAME_VERSION + 1);
+	SIT_CHECK(!sit_frame_valid((const uint8_t *)&msg, sizeof(msg)));
+
+	msg.header.msg = SIT_MSG_BYTE(simple_poll, SIT_FRAME_VERSION);
+	/* no PAN ID compression */
+	msg.header.frame_ctrl[0] = 0x01;
+	SIT_CHECK(!sit_frame_valid((const uint8_t *)&msg, sizeof(msg)));
+}
+
+/* The message byte follows the MAC header, ID in bits 0..5 and version in bits 6..7 */
+static void test_wire(void) {
+	msg_simple_t msg = {SIT_HEADER(ds_twr_2_resp, 7, 1, 100), 0};
+	uint8_t frame[127];
+
+	SIT_CHECK_EQ(offsetof(header_t, msg), 9);
+	SIT_CHECK_EQ(sizeof(header_t), 10);
+
+	fake_dw3000_reset();
+	SIT_CHECK_EQ(sit_event_init(), 0);
+	sit_send_now((uint8_t *)&msg, sizeof(msg));
+	SIT_CHECK_EQ(fake_dw3000_last_tx(frame), sizeof(msg));
+	SIT_CHECK_EQ(frame[9], ds_twr_2_resp | (SIT_FRAME_VERSION << 6));
+	SIT_CHECK_EQ(frame[5], 100);
+	SIT_CHECK_EQ(frame[7], 1);
+
+	for (uint8_t id = 0; id <= SIT_MSG_ID_MASK; id++) {
+		header_t header = {.msg = SIT_MSG_BYTE(id, SIT_FRAME_VERSION)};
+		SIT_CHECK_EQ(sit_frame_id(&header), id);
+		SIT_CHECK_EQ(sit_frame_version(&header), SIT_FRAME_VERSION);
+	}
+}
+
+static void test_airtime(void) {
+	dwt_config_t config = sit_device_config;
+
+	/* 520 preamble and SFD symbols, 19 PHR bits at 850 kb/s, 96 + 48 data bits at 6.8 Mb/s */
+	SIT_CHECK_EQ(sizeof(msg_simple_t), 12);
+	SIT_CHECK_EQ(sit_frame_airtime_ns(&config, sizeof(msg_simple_t)), 567117);
+
+	/* a second Reed-Solomon block from 42 bytes on, 56 bits more */
+	SIT_CHECK_NEAR(sit_frame_airtime_ns(&config, 42) - sit_frame_airtime_ns(&config, 41), 7180, 1);
+
+	/* 64 STS symbols */
+	config.stsMode = DWT_STS_MODE_1;
+	config.stsLength = DWT_STS_LEN_64;
+	SIT_CHECK_NEAR(sit_frame_airtime_ns(&config, 12) - 567117, 65128, 1);
+
+	/* 16 MHz PRF preamble code, shorter symbols */
+	config = sit_device_config;
+	config.txCode = 3;
+	SIT_CHECK(sit_frame_airtime_ns(&config, 12) < 567117);
+
+	/* a shorter preamble */
+	config = sit_device_config;
+	config.txPreambLength = DWT_PLEN_128;
+	SIT_CHECK_NEAR(567117 - sit_frame_airtime_ns(&config, 12), 384 * 1017.63, 1);
+
+	/* 850 kb/s data rate */
+	config = sit_device_config;
+	config.dataRate = DWT_BR_850K;
+	SIT_CHECK_NEAR(sit_frame_airtime_ns(&config, 12) - 567117, 144 * (1025.64 - 128.21), 1);
+}
+
+int main(void) {
+	test_valid();
+	test_wire();
+	test_airtime();
+	return sit_test_result("sit_frame");
+}
@@ -0,0 +1,158 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_position.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the position solver on a synthetic geometry, built
+ *        for 2D and for 3D (CONFIG_SIT_POSITION_3D).
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "host_stubs.h"
+
+#include "sit/sit_position.h"
+
+#include <errno.h>
+#include <math.h>
+
+#ifdef CONFIG_SIT_POSITION_3D
+#define DIM 3
+/* not coplanar, z is solved */
+static const float anchor_pos[][3] = {{0.0f, 0.0f, 0.0f}, {10.0f, 0.0f, 3.0f}, {10.0f, 10.0f, 0.0f}, {0.0f, 10.0f, 3.0f}};
+static const float tag[3] = {3.0f, 4.0f, 1.0f};
+/* the anchors span 3 m in z and 10 m in x and y, z is less accurate */
+#define NOISE_Z_MAX 0.2
+#else
+#define DIM 2
+/* tag in the plane of the anchors, CONFIG_SIT_POSITION_TAG_Z_MM is 0 */
+static const float anchor_pos[][3] = {{0.0f, 0.0f, 0.0f}, {10.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 0.0f}, {0.0f, 10.0f, 0.0f}};
+static const float tag[3] = {3.0f, 4.0f, 0.0f};
+#define NOISE_Z_MAX 0.0
+#endif
+
+#define ANCHORS ARRAY_SIZE(anchor_pos)
+
+static int32_t range_mm(const float *anchor, const float *p, int32_t noise_mm) {
+	float dx = p[0] - anchor[0];
+	float dy = p[1] - anchor[1];
+	float dz = p[2] - anchor[2];
+	return (int32_t)lroundf(sqrtf(dx * dx + dy * dy + dz * dz) * 1000.0f) + noise_mm;
+}
+
+static void set_anchors(void) {
+	sit_position_reset();
+	for (uint8_t i = 0; i < ANCHORS; i++) {
+		SIT_CHECK_EQ(sit_position_set_anchor(i, anchor_pos[i][0], anchor_pos[i][1], anchor_pos[i][2]), 0);
+	}
+}
+
+static void test_anchors(void) {
+	sit_position_reset();
+	SIT_CHECK(!sit_position_enabled());
+	for (uint8_t i = 0; i < DIM; i++) {
+		sit_position_set_anchor(i, anchor_pos[i][0], anchor_pos[i][1], anchor_pos[i][2]);
+	}
+	/* one anchor more than solved axes */
+	SIT_CHECK(!sit_position_enabled());
+	sit_position_set_anchor(DIM, anchor_pos[DIM][0], anchor_pos[DIM][1], anchor_pos[DIM][2]);
+	SIT_CHECK(sit_position_enabled());
+
+	SIT_CHECK_EQ(sit_position_set_anchor(SIT_POSITION_MAX_ANCHORS, 0.0f, 0.0f, 0.0f), -EINVAL);
+	sit_position_reset();
+	SIT_CHECK(!sit_position_enabled());
+}
+
+static void test_solve(void) {
+	sit_position_t position;
+
+	host_set_uptime(1000);
+	set_anchors();
+	SIT_CHECK(!sit_position_solve(&position));
+
+	for (uint8_t i = 0; i < ANCHORS; i++) {
+		sit_position_add_range(i, range_mm(anchor_pos[i], tag, 0));
+	}
+	/* ranges of anchors that are not set are ignored */
+	sit_position_add_range(ANCHORS, 1000);
+
+	SIT_CHECK(sit_position_solve(&position));
+	SIT_CHECK_NEAR(position.x, tag[0], 0.005);
+	SIT_CHECK_NEAR(position.y, tag[1], 0.005);
+	SIT_CHECK_NEAR(position.z, tag[2], 0.005);
+	SIT_CHECK_NEAR(position.residual, 0.0, 0.005);
+	SIT_CHECK_EQ(position.anchors, ANCHORS);
+	SIT_CHECK(position.iterations >= 1);
+
+	/* the last position is the start value, the tag moved by 10 cm */
+	float moved[3] = {tag[0] + 0.1f, tag[1], tag[2]};
+	for (uint8_t i = 0; i < ANCHORS; i++) {
+		sit_position_add_range(i, range_mm(anchor_pos[i], moved, 0));
+	}
+	SIT_CHECK(sit_position_solve(&position));
+	SIT_CHECK_NEAR(position.x, moved[0], 0.005);
+	SIT_CHECK_NEAR(position.y, moved[1], 0.005);
+
+	/* ranges older than CONFIG_SIT_POSITION_MAX_AGE_MS are not used */
+	host_set_uptime(1000 + CONFIG_SIT_POSITION_MAX_AGE_MS + 1);
+	SIT_CHECK(!sit_position_solve(&position));
+}
+
+static void test_noise(void) {
+	static const int32_t noise_mm[] = {30, -20, 10, -30};
+	sit_position_t position;
+
+	host_set_uptime(2000);
+	set_anchors();
+	for (uint8_t i = 0; i < ANCHORS; i++) {
+		sit_position_add_range(i, range_mm(anchor_pos[i], tag, noise_mm[i]));
+	}
+	SIT_CHECK(sit_position_solve(&position));
+	SIT_CHECK_NEAR(position.x, tag[0], 0.1);
+	SIT_CHECK_NEAR(position.y, tag[1], 0.1);
+	SIT_CHECK_NEAR(position.z, tag[2], NOISE_Z_MAX);
+	SIT_CHECK(position.residual > 0.0f && position.residual < 0.03f);
+}
+
+/* all anchors on the x axis, y can not be solved */
+static void test_singular(void) {
+	sit_position_t position;
+	float line_tag[3] = {3.0f, 0.0f, 0.0f};
+
+	host_set_uptime(3000);
+	sit_position_reset();
+	for (uint8_t i = 0; i <= DIM; i++) {
+		float anchor[3] = {5.0f * i, 0.0f, 0.0f};
+		sit_position_set_anchor(i, anchor[0], anchor[1], anchor[2]);
+		sit_position_add_range(i, range_mm(anchor, line_tag, 0));
+	}
+	SIT_CHECK(!sit_position_solve(&position));
+}
+
+int main(void) {
+	test_anchors();
+	test_solve();
+	test_noise();
+	test_singular();
+	return sit_test_result("sit_position");
+}
@@ -0,0 +1,153 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_range_filter.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the range filter, built once with the Kalman filter
+ *        and once with the median filter.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "host_stubs.h"
+
+#include "sit/sit_range_filter.h"
+
+#include <string.h>
+
+#define RESPONDER 100
+#define PERIOD_MS 100
+
+static int64_t now_ms;
+
+static bool update(uint8_t responder_id, int32_t distance_mm, const diagnostic_info *quality, int32_t *filtered_mm) {
+	now_ms += PERIOD_MS;
+	host_set_uptime(now_ms);
+	return sit_range_filter_update(responder_id, distance_mm, quality, filtered_mm);
+}
+
+/* IDs without a filter, e.g. the initiator, pass the range through */
+static void test_unfiltered(void) {
+	int32_t filtered = 0;
+	sit_range_filter_reset();
+	SIT_CHECK(update(5, 1234, NULL, &filtered));
+	SIT_CHECK_EQ(filtered, 1234);
+	SIT_CHECK(sit_range_filter_decimate(5));
+}
+
+#ifdef CONFIG_SIT_RANGE_FILTER_KALMAN
+static void test_kalman(void) {
+	int32_t filtered = 0;
+	sit_range_filter_stats_t stats;
+
+	sit_range_filter_reset();
+	for (int i = 0; i < 20; i++) {
+		SIT_CHECK(update(RESPONDER, 5000 + ((i & 1) ? 20 : -20), NULL, &filtered));
+	}
+	SIT_CHECK_NEAR(filtered, 5000, 15);
+
+	/* an outlier outside the gate is rejected and does not move the range */
+	SIT_CHECK(!update(RESPONDER, 8000, NULL, &filtered));
+	SIT_CHECK(update(RESPONDER, 5000, NULL, &filtered));
+	SIT_CHECK_NEAR(filtered, 5000, 15);
+
+	/* the tag jumped, the filter restarts after CONFIG_SIT_RANGE_FILTER_MAX_REJECTED ranges */
+	for (int i = 1; i < CONFIG_SIT_RANGE_FILTER_MAX_REJECTED; i++) {
+		SIT_CHECK(!update(RESPONDER, 9000, NULL, &filtered));
+	}
+	SIT_CHECK(update(RESPONDER, 9000, NULL, &filtered));
+	SIT_CHECK_EQ(filtered, 9000);
+
+	sit_range_filter_get_stats(&stats);
+	SIT_CHECK_EQ(stats.accepted, 22);
+	SIT_CHECK_EQ(stats.rejected, CONFIG_SIT_RANGE_FILTER_MAX_REJECTED);
+	SIT_CHECK_EQ(stats.resets, 1);
+}
+
+/* NLOS raises the measurement noise, the gate gets wider */
+static void test_kalman_nlos(void) {
+	diagnostic_info nlos = {.nlos = 100, .rssi = -80.0f, .fpi = -80.0f};
+	int32_t filtered = 0;
+
+	sit_range_filter_reset();
+	for (int i = 0; i < 20; i++) {
+		update(RESPONDER, 5000, NULL, &filtered);
+		update(RESPONDER + 1, 5000, NULL, &filtered);
+	}
+	SIT_CHECK(!update(RESPONDER, 5600, NULL, &filtered));
+	SIT_CHECK(update(RESPONDER + 1, 5600, &nlos, &filtered));
+	/* the NLOS range is weighted less than a LOS range */
+	SIT_CHECK(filtered > 5000 && filtered < 5600);
+}
+#endif
+
+#ifdef CONFIG_SIT_RANGE_FILTER_MEDIAN
+static void test_median(void) {
+	static const int32_t ranges[] = {1000, 1010, 5000, 990, 1005};
+	static const int32_t medians[] = {1000, 1010, 1010, 1010, 1005};
+	int32_t filtered = 0;
+
+	sit_range_filter_reset();
+	for (size_t i = 0; i < ARRAY_SIZE(ranges); i++) {
+		SIT_CHECK(update(RESPONDER, ranges[i], NULL, &filtered));
+		SIT_CHECK_EQ(filtered, medians[i]);
+	}
+	/* the window is full, the oldest range leaves it */
+	SIT_CHECK(update(RESPONDER, 995, NULL, &filtered));
+	SIT_CHECK_EQ(filtered, 1005);
+}
+
+/* NLOS ranges are only taken if the path stays NLOS for a whole window */
+static void test_median_nlos(void) {
+	diagnostic_info nlos = {.nlos = 100, .rssi = -80.0f, .fpi = -80.0f};
+	int32_t filtered = 0;
+	sit_range_filter_stats_t stats;
+
+	sit_range_filter_reset();
+	SIT_CHECK(update(RESPONDER, 1000, NULL, &filtered));
+	for (int i = 0; i < CONFIG_SIT_RANGE_FILTER_MEDIAN_K; i++) {
+		SIT_CHECK(!update(RESPONDER, 1500, &nlos, &filtered));
+	}
+	SIT_CHECK(update(RESPONDER, 1500, &nlos, &filtered));
+	/* a LOS range ends the NLOS run */
+	SIT_CHECK(update(RESPONDER, 1000, NULL, &filtered));
+	SIT_CHECK(!update(RESPONDER, 1500, &nlos, &filtered));
+
+	sit_range_filter_get_stats(&stats);
+	SIT_CHECK_EQ(stats.accepted, 3);
+	SIT_CHECK_EQ(stats.rejected, CONFIG_SIT_RANGE_FILTER_MEDIAN_K + 1);
+}
+#endif
+
+int main(void) {
+	test_unfiltered();
+#ifdef CONFIG_SIT_RANGE_FILTER_KALMAN
+	test_kalman();
+	test_kalman_nlos();
+	return sit_test_result("sit_range_filter (Kalman)");
+#else
+	test_median();
+	test_median_nlos();
+	return sit_test_result("sit_range_filter (median)");
+#endif
+}
@@ -0,0 +1,143 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_tdma.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the TDMA slot math, the beacon and the slot timing
+ *        on the fake DW3000.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "fake_dw3000.h"
+
+#include "sit/sit_distance.h"
+#include "sit/sit_event.h"
+#include "sit/sit_frame.h"
+#include "sit/sit_tdma.h"
+#include "sit/sit_ts.h"
+
+/* Delay of the echo peer, the frame comes back after the own TX */
+#define ECHO_DELAY_UUS 1000
+
+static sit_ts_t echo_rx_ts;
+static uint64_t last_tx_ts;
+
+/* Peer which sends the beacon back, like the beacon of another initiator */
+static void echo_peer(const uint8_t *frame, uint16_t length, uint64_t tx_ts) {
+	last_tx_ts = tx_ts;
+	if (sit_frame_id((const header_t *)frame) != tdma_beacon) {
+		return;
+	}
+	echo_rx_ts = sit_ts_add_uus(tx_ts, ECHO_DELAY_UUS);
+	fake_dw3000_air(frame, length, echo_rx_ts);
+}
+
+static void radio_init(void) {
+	fake_dw3000_reset();
+	fake_dw3000_set_peer(echo_peer);
+	SIT_CHECK_EQ(sit_event_init(), 0);
+}
+
+static void test_slots(void) {
+	SIT_CHECK_EQ(sit_tdma_responders(0), 1);
+	SIT_CHECK_EQ(sit_tdma_responders(3), 3);
+	SIT_CHECK_EQ(sit_tdma_responders(255), SIT_TDMA_MAX_RESPONDERS);
+
+	SIT_CHECK_EQ(sit_tdma_slot_uus(0), CONFIG_SIT_TDMA_EXCHANGE_UUS);
+	SIT_CHECK_EQ(sit_tdma_slot_uus(3), 3 * CONFIG_SIT_TDMA_EXCHANGE_UUS);
+	/* the longest slot still fits into msg_tdma_beacon_t.slot_uus */
+	SIT_CHECK_EQ(sit_tdma_slot_uus(255), SIT_TDMA_MAX_RESPONDERS * CONFIG_SIT_TDMA_EXCHANGE_UUS);
+
+	SIT_CHECK_EQ(sit_tdma_superframe_uus(4, 2), CONFIG_SIT_TDMA_GUARD_UUS + 4 * 2 * CONFIG_SIT_TDMA_EXCHANGE_UUS);
+	/* 8 ranges in 66000 uus = 67.7 ms */
+	SIT_CHECK_EQ(sit_tdma_ranges_per_second(4, 2), 118);
+}
+
+static void test_poll_tx_time(void) {
+	msg_tdma_beacon_t beacon = {.slots = 4, .responders = 2, .slot_uus = sit_tdma_slot_uus(2)};
+	static const uint64_t rx_ts[] = {0x1000000000ULL, SIT_TS_MASK - 1000};
+
+	for (size_t i = 0; i < ARRAY_SIZE(rx_ts); i++) {
+		for (uint8_t slot = 0; slot < beacon.slots; slot++) {
+			for (uint8_t exchange = 0; exchange < beacon.responders; exchange++) {
+				uint64_t offset_uus = CONFIG_SIT_TDMA_GUARD_UUS + slot * beacon.slot_uus +
+						      exchange * CONFIG_SIT_TDMA_EXCHANGE_UUS;
+				uint64_t tx_ts = (rx_ts[i] + offset_uus * UUS_TO_DWT_TIME) & SIT_TS_MASK;
+				SIT_CHECK_EQ(sit_tdma_poll_tx_time(rx_ts[i], &beacon, slot, exchange), tx_ts >> 8);
+			}
+		}
+	}
+}
+
+static void test_beacon(void) {
+	msg_tdma_beacon_t beacon;
+	uint64_t beacon_rx_ts = 0;
+
+	radio_init();
+	device_settings.deviceID = SIT_TDMA_BEACON_ID;
+	sit_tdma_send_beacon(5, 4, 3);
+	SIT_CHECK(sit_tdma_wait_beacon(&beacon, &beacon_rx_ts));
+	SIT_CHECK_EQ(beacon.header.sequence, 5);
+	SIT_CHECK_EQ(beacon.slots, 4);
+	SIT_CHECK_EQ(beacon.responders, 3);
+	SIT_CHECK_EQ(beacon.slot_uus, 3 * CONFIG_SIT_TDMA_EXCHANGE_UUS);
+	SIT_CHECK_EQ(beacon_rx_ts, echo_rx_ts);
+
+	/* only the beacon ID sends the beacon */
+	device_settings.deviceID = 1;
+	sit_tdma_send_beacon(6, 4, 3);
+	SIT_CHECK(!sit_tdma_wait_beacon(&beacon, &beacon_rx_ts));
+}
+
+/* the poll of every slot leaves the radio at the TX time of the slot */
+static void test_slot_tx(void) {
+	msg_tdma_beacon_t beacon;
+	uint64_t beacon_rx_ts = 0;
+	msg_simple_t poll = {SIT_HEADER(twr_1_poll, 0, 1, 100), 0};
+
+	radio_init();
+	device_settings.deviceID = SIT_TDMA_BEACON_ID;
+	sit_tdma_send_beacon(7, 3, 2);
+	SIT_CHECK(sit_tdma_wait_beacon(&beacon, &beacon_rx_ts));
+	device_settings.deviceID = 1;
+
+	for (uint8_t slot = 0; slot < beacon.slots; slot++) {
+		for (uint8_t exchange = 0; exchange < beacon.responders; exchange++) {
+			uint32_t tx_time = sit_tdma_poll_tx_time(beacon_rx_ts, &beacon, slot, exchange);
+			SIT_CHECK(sit_send_at((uint8_t *)&poll, sizeof(poll), tx_time));
+			SIT_CHECK_EQ(last_tx_ts, sit_ts_from_tx_time(tx_time));
+		}
+	}
+	/* the slot of the last exchange is over */
+	uint32_t tx_time = sit_tdma_poll_tx_time(beacon_rx_ts, &beacon, 0, 0);
+	SIT_CHECK(!sit_send_at((uint8_t *)&poll, sizeof(poll), tx_time));
+}
+
+int main(void) {
+	test_slots();
+	test_poll_tx_time();
+	test_beacon();
+	test_slot_tx();
+	return sit_test_result("sit_tdma");
+}
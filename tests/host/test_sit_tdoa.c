@@ -0,0 +1,330 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_tdoa.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the uplink TDoA solver and a simulation of the
+ *        blinking tags, built for 2D and for 3D (CONFIG_SIT_POSITION_3D).
+ *
+ * The simulation runs SIM_DURATION_S of blinks with the period and jitter
+ * of sit_tdoa_tag() and the syncs of the reference anchor. Frames which
+ * overlap in the air are lost (no capture), the anchor clocks have an
+ * offset and a 40 bit wrap. Every blink which all anchors receive after
+ * two syncs goes through the records of sit_tdoa_record() into the
+ * solver. It prints the fixes/s for a range of tag counts.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+
+#include "sit/sit.h"
+#include "sit/sit_config.h"
+#include "sit/sit_position.h"
+#include "sit/sit_profile.h"
+#include "sit/sit_ts.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef CONFIG_SIT_POSITION_3D
+#define DIM 3
+/* not coplanar, z is solved */
+static const float anchor_pos[][3] = {{0.0f, 0.0f, 0.0f}, {20.0f, 0.0f, 3.0f}, {20.0f, 10.0f, 0.0f},
+				      {0.0f, 10.0f, 3.0f}, {10.0f, 5.0f, 3.0f}};
+#define TAG_Z 1.0f
+/* the anchors span 3 m in z, z is less accurate */
+#define FIX_ERROR_MAX 0.5
+#define FIX_ERROR_MEAN 0.15
+#else
+#define DIM 2
+static const float anchor_pos[][3] = {{0.0f, 0.0f, 0.0f}, {20.0f, 0.0f, 0.0f}, {20.0f, 10.0f, 0.0f},
+				      {0.0f, 10.0f, 0.0f}};
+#define TAG_Z 0.0f
+#define FIX_ERROR_MAX 0.3
+#define FIX_ERROR_MEAN 0.05
+#endif
+
+#define ANCHORS ARRAY_SIZE(anchor_pos)
+
+/* anchor clock / reference clock - 1, anchor 0 is the reference */
+static const double anchor_offset[] = {0.0, 4.5e-6, -7.0e-6, 10.0e-6, -2.5e-6};
+
+#define SIM_DURATION_S      10.0
+#define SIM_MAX_FRAMES      25000
+/* RX time noise of one anchor, 0.1 ns = 3 cm */
+#define SIM_NOISE_S         0.1e-9
+#define SIM_SYNC_ID         0xFF
+
+#define TS_PERIOD ((double)(SIT_TS_MASK + 1))
+
+typedef struct {
+    double start;       ///< first preamble symbol in s
+    double end;         ///< end of the frame in s
+    uint8_t tag;        ///< tag index or SIM_SYNC_ID
+    bool lost;          ///< overlaps another frame
+} sim_frame_t;
+
+typedef struct {
+    uint32_t blinks;    ///< blinks sent
+    uint32_t lost;      ///< blinks lost in a collision
+    uint32_t fixes;     ///< positions within FIX_ERROR_MAX
+    double error_sum;   ///< sum of the position errors of the fixes in m
+} sim_result_t;
+
+static sim_frame_t frames[SIM_MAX_FRAMES];
+static double anchor_bias[ANCHORS];
+static uint32_t rand_state = 1;
+
+static uint32_t sim_rand(void) {
+	/* xorshift32, the same sequence on every host */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+	return rand_state;
+}
+
+static double sim_uniform(void) {
+	return (sim_rand() + 0.5) / 4294967296.0;
+}
+
+static double sim_gauss(void) {
+	return sqrt(-2.0 * log(sim_uniform())) * cos(2.0 * M_PI * sim_uniform());
+}
+
+static double distance(const float *a, const float *b) {
+	double dx = a[0] - b[0];
+	double dy = a[1] - b[1];
+	double dz = a[2] - b[2];
+	return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/* 40 bit clock of an anchor at the true time t */
+static uint64_t anchor_ts(size_t anchor, double t) {
+	double ticks = anchor_bias[anchor] + t / DWT_TIME_UNITS * (1.0 + anchor_offset[anchor]);
+	return (uint64_t)llround(fmod(ticks, TS_PERIOD)) & SIT_TS_MASK;
+}
+
+static void tag_pos(uint32_t tag, float *p) {
+	p[0] = 2.0f + fmodf(tag * 7.3f, 16.0f);
+	p[1] = 1.0f + fmodf(tag * 3.7f, 8.0f);
+	p[2] = TAG_Z;
+}
+
+static double position_error(const sit_position_t *position, const float *p) {
+	float solved[3] = {position->x, position->y, position->z};
+	return distance(solved, p);
+}
+
+static double airtime_s(void) {
+	return sit_ts_add_uus(0, sit_profile_airtime_uus(sizeof(msg_tdoa_t))) * DWT_TIME_UNITS;
+}
+
+static int frame_cmp(const void *a, const void *b) {
+	double d = ((const sim_frame_t *)a)->start - ((const sim_frame_t *)b)->start;
+	return (d > 0) - (d < 0);
+}
+
+/* Blinks with the period and jitter of sit_tdoa_tag(), syncs every CONFIG_SIT_TDOA_SYNC_PERIOD_MS */
+static size_t sim_frames(uint32_t tags) {
+	const double period = CONFIG_SIT_TDOA_BLINK_PERIOD_MS / 1000.0;
+	const double airtime = airtime_s();
+	size_t count = 0;
+
+	for (uint32_t tag = 0; tag < tags; tag++) {
+		double t = period * sim_uniform();
+		while (t < SIM_DURATION_S && count < SIM_MAX_FRAMES) {
+			frames[count++] = (sim_frame_t){t, t + airtime, (uint8_t)tag, false};
+			uint32_t jitter = sim_rand() % (CONFIG_SIT_TDOA_BLINK_PERIOD_MS / 4 + 1);
+			t += (CONFIG_SIT_TDOA_BLINK_PERIOD_MS - CONFIG_SIT_TDOA_BLINK_PERIOD_MS / 8 + jitter) / 1000.0 +
+			     1e-6 * sim_uniform();
+		}
+	}
+	for (double t = 0.01; t < SIM_DURATION_S && count < SIM_MAX_FRAMES; t += CONFIG_SIT_TDOA_SYNC_PERIOD_MS / 1000.0) {
+		frames[count++] = (sim_frame_t){t, t + airtime, SIM_SYNC_ID, false};
+	}
+	SIT_CHECK(count < SIM_MAX_FRAMES);
+	qsort(frames, count, sizeof(frames[0]), frame_cmp);
+
+	/* every frame which overlaps another one is lost at all anchors */
+	size_t last = 0;
+	for (size_t i = 1; i < count; i++) {
+		if (frames[i].start < frames[last].end) {
+			frames[i].lost = true;
+			frames[last].lost = true;
+		}
+		if (frames[i].end > frames[last].end) {
+			last = i;
+		}
+	}
+	return count;
+}
+
+static sim_result_t sim_run(uint32_t tags) {
+	json_tdoa_data_t clock[ANCHORS];
+	uint32_t syncs[ANCHORS];
+	sim_result_t result = {0};
+
+	memset(clock, 0, sizeof(clock));
+	memset(syncs, 0, sizeof(syncs));
+	for (size_t a = 0; a < ANCHORS; a++) {
+		anchor_bias[a] = TS_PERIOD * sim_uniform();
+	}
+
+	size_t count = sim_frames(tags);
+	for (size_t i = 0; i < count; i++) {
+		const sim_frame_t *frame = &frames[i];
+		if (frame->tag != SIM_SYNC_ID) {
+			result.blinks++;
+			result.lost += frame->lost;
+		}
+		if (frame->lost) {
+			continue;
+		}
+		if (frame->tag == SIM_SYNC_ID) {
+			/* sit_tdoa_clock_reference() and sit_tdoa_clock_update() */
+			uint64_t sync_tx_ts = anchor_ts(0, frame->start);
+			for (size_t a = 0; a < ANCHORS; a++) {
+				double tof = distance(anchor_pos[a], anchor_pos[0]) / SPEED_OF_LIGHT;
+				clock[a].sync_tx_ts = sync_tx_ts;
+				clock[a].sync_rx_ts = anchor_ts(a, frame->start + tof);
+				clock[a].clock_offset = (float)anchor_offset[a];
+				syncs[a]++;
+			}
+			continue;
+		}
+
+		/* the offset of an anchor is known after two syncs */
+		bool synced = true;
+		for (size_t a = 1; a < ANCHORS; a++) {
+			synced &= syncs[a] >= 2;
+		}
+		if (!synced) {
+			continue;
+		}
+
+		float p[3];
+		sit_position_tdoa_t obs[ANCHORS];
+		tag_pos(frame->tag, p);
+		for (size_t a = 0; a < ANCHORS; a++) {
+			double rx = frame->start + distance(p, anchor_pos[a]) / SPEED_OF_LIGHT + SIM_NOISE_S * sim_gauss();
+			json_tdoa_data_t record = clock[a];
+			record.rx_ts = anchor_ts(a, rx);
+			memcpy(obs[a].pos, anchor_pos[a], sizeof(obs[a].pos));
+			obs[a].rx_time = sit_position_tdoa_time(&record, (float)distance(anchor_pos[a], anchor_pos[0]));
+		}
+
+		sit_position_t position;
+		if (sit_position_solve_tdoa(obs, ANCHORS, &position)) {
+			double error = position_error(&position, p);
+			if (error < FIX_ERROR_MAX) {
+				result.fixes++;
+				result.error_sum += error;
+			}
+		}
+	}
+	return result;
+}
+
+static void test_time(void) {
+	/* anchor 1 runs 10 ppm fast, the blink is received 0.5 s after the sync and after the wrap */
+	json_tdoa_data_t record = {
+		.sync_tx_ts = SIT_TS_MASK - 1000,
+		.sync_rx_ts = SIT_TS_MASK - 20000000,
+		.clock_offset = 10e-6f,
+	};
+	double elapsed = 0.5 / DWT_TIME_UNITS;
+	record.rx_ts = (record.sync_rx_ts + (uint64_t)llround(elapsed * (1.0 + 10e-6))) & SIT_TS_MASK;
+
+	/* sync 10 m away */
+	double expected = (record.sync_tx_ts + 10.0 / SPEED_OF_LIGHT / DWT_TIME_UNITS + elapsed) * DWT_TIME_UNITS;
+	expected = fmod(expected, TS_PERIOD * DWT_TIME_UNITS);
+	SIT_CHECK_NEAR(sit_position_tdoa_time(&record, 10.0f), expected, 20e-12);
+	/* the reference clock wrapped as well */
+	SIT_CHECK(expected < 1.0);
+}
+
+static void test_solve(void) {
+	sit_position_t position;
+	sit_position_tdoa_t obs[ANCHORS];
+	const float p[3] = {7.0f, 3.0f, TAG_Z};
+	/* the blink is sent just before the 40 bit wrap of the reference clock */
+	double t0 = TS_PERIOD * DWT_TIME_UNITS - 30e-9;
+
+	for (size_t a = 0; a < ANCHORS; a++) {
+		memcpy(obs[a].pos, anchor_pos[a], sizeof(obs[a].pos));
+		obs[a].rx_time = fmod(t0 + distance(p, anchor_pos[a]) / SPEED_OF_LIGHT, TS_PERIOD * DWT_TIME_UNITS);
+	}
+	SIT_CHECK(obs[0].rx_time > obs[1].rx_time);
+	SIT_CHECK(sit_position_solve_tdoa(obs, ANCHORS, &position));
+	SIT_CHECK_NEAR(position.x, p[0], 0.005);
+	SIT_CHECK_NEAR(position.y, p[1], 0.005);
+	SIT_CHECK_NEAR(position.z, p[2], 0.005);
+	SIT_CHECK_NEAR(position.residual, 0.0, 0.005);
+	SIT_CHECK_EQ(position.anchors, ANCHORS);
+
+	/* one range difference per solved axis is not enough */
+	SIT_CHECK(!sit_position_solve_tdoa(obs, DIM + 1, &position));
+}
+
+static void test_simulation(void) {
+	static const uint32_t tag_counts[] = {1, 10, 50, 100, 200};
+	double per_tag[ARRAY_SIZE(tag_counts)];
+	double fixes_s[ARRAY_SIZE(tag_counts)];
+	double period = CONFIG_SIT_TDOA_BLINK_PERIOD_MS / 1000.0;
+
+	printf("TDoA %dD, %d anchors, blink every %d ms, airtime %.0f us, %.0f s:\n", DIM, (int)ANCHORS,
+	       CONFIG_SIT_TDOA_BLINK_PERIOD_MS, airtime_s() * 1e6, SIM_DURATION_S);
+	printf("  tags  fixes/s  per tag  lost   ALOHA  error\n");
+	for (size_t i = 0; i < ARRAY_SIZE(tag_counts); i++) {
+		sim_result_t result = sim_run(tag_counts[i]);
+		/* pure ALOHA loss with the offered load of the blinks */
+		double aloha = 1.0 - exp(-2.0 * tag_counts[i] * airtime_s() / period);
+		double lost = (double)result.lost / result.blinks;
+		double error = result.fixes ? result.error_sum / result.fixes : 0.0;
+
+		fixes_s[i] = result.fixes / SIM_DURATION_S;
+		per_tag[i] = fixes_s[i] / tag_counts[i];
+		printf("  %4u  %7.1f  %7.2f  %4.1f%%  %4.1f%%  %.3f m\n", tag_counts[i], fixes_s[i], per_tag[i],
+		       100.0 * lost, 100.0 * aloha, error);
+
+		SIT_CHECK_NEAR(lost, aloha, 0.05);
+		if (tag_counts[i] == 1) {
+			/* no collisions, only the blinks before the second sync have no fix */
+			SIT_CHECK(fixes_s[i] > 0.9 / period && fixes_s[i] <= 1.0 / period + 1.0);
+			SIT_CHECK(error < FIX_ERROR_MEAN);
+		}
+	}
+	for (size_t i = 1; i < ARRAY_SIZE(tag_counts); i++) {
+		SIT_CHECK(per_tag[i] < per_tag[i - 1]);
+	}
+	SIT_CHECK(fixes_s[1] > fixes_s[0]);
+	SIT_CHECK(fixes_s[2] > fixes_s[1]);
+}
+
+int main(void) {
+	test_time();
+	test_solve();
+	test_simulation();
+	return sit_test_result("sit_tdoa");
+}
@@ -0,0 +1,138 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_tof.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the fixed point ToF, known answers and the double
+ *        formulas the fixed point code replaced.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+
+#include "sit/sit_tof.h"
+#include "sit/sit.h"
+#include "sit/sit_config.h"
+
+#include <math.h>
+
+#include <deca_device_api.h>
+
+/* Reference of sit_tof_ds_q8 without overflow */
+static int64_t ds_q8_ref(uint32_t round_1, uint32_t reply_1, uint32_t round_2, uint32_t reply_2) {
+	__int128 num = (__int128)round_1 * round_2 - (__int128)reply_1 * reply_2;
+	__int128 den = (__int128)round_1 + round_2 + reply_1 + reply_2;
+	num *= 256;
+	return (int64_t)((num >= 0) ? (num + den / 2) / den : (num - den / 2) / den);
+}
+
+/* Double formula of the SS-TWR initiator before the fixed point version */
+static double ss_tof_double(uint32_t round, uint32_t reply, int32_t ci) {
+	double hz_to_ppm = (sit_device_config.chan == 5) ? HERTZ_TO_PPM_MULTIPLIER_CHAN_5 : HERTZ_TO_PPM_MULTIPLIER_CHAN_9;
+	double clock_offset_ratio = ci * (FREQ_OFFSET_MULTIPLIER * hz_to_ppm / 1.0e6);
+	return (round - reply * (1.0 - clock_offset_ratio)) / 2.0;
+}
+
+static void test_ci_to_skew(void) {
+	static const int32_t cis[] = {0, 1, -1, 1000, -1000, 13000, 123456, -654321, 1 << 20, -(1 << 20)};
+	static const uint8_t channels[] = {5, 9};
+
+	sit_device_config.chan = 9;
+	SIT_CHECK_EQ(sit_tof_ci_to_skew_q40(1000), -512000);
+	sit_device_config.chan = 5;
+	SIT_CHECK_EQ(sit_tof_ci_to_skew_q40(13000), -8192000);
+
+	for (size_t c = 0; c < ARRAY_SIZE(channels); c++) {
+		sit_device_config.chan = channels[c];
+		double hz_to_ppm = (channels[c] == 5) ? HERTZ_TO_PPM_MULTIPLIER_CHAN_5 : HERTZ_TO_PPM_MULTIPLIER_CHAN_9;
+		for (size_t i = 0; i < ARRAY_SIZE(cis); i++) {
+			double skew = cis[i] * (FREQ_OFFSET_MULTIPLIER * hz_to_ppm / 1.0e6);
+			SIT_CHECK_NEAR(sit_tof_ci_to_skew_q40(cis[i]), skew * SIT_TOF_SKEW_ONE, 0.5);
+		}
+	}
+	sit_device_config.chan = 9;
+}
+
+static void test_ds(void) {
+	/* symmetric exchange, ToF = (round - reply) / 2 */
+	SIT_CHECK_EQ(sit_tof_ds_q8(1004264, 1000000, 1004264, 1000000), 2132 * 256);
+	SIT_CHECK_EQ(sit_tof_ds_q8(0, 0, 0, 0), 0);
+	/* negative ToF of a responder close to the initiator */
+	SIT_CHECK_EQ(sit_tof_ds_q8(999900, 1000000, 999900, 1000000), -50 * 256);
+
+	/* asymmetric replies, 10 ppm clock offset */
+	SIT_CHECK_EQ(sit_tof_ds_q8(70004264, 35000000, 35004614, 70000700),
+		     ds_q8_ref(70004264, 35000000, 35004614, 70000700));
+
+	/* spans close to 32 bit take the divide first path, half a dtu */
+	SIT_CHECK_NEAR(sit_tof_ds_q8(4000004264UL, 3999990000UL, 3999995000UL, 3999980736UL),
+		       ds_q8_ref(4000004264UL, 3999990000UL, 3999995000UL, 3999980736UL), 128);
+}
+
+static void test_ss(void) {
+	static const struct {
+		uint32_t round;
+		uint32_t reply;
+		int32_t ci;
+	} cases[] = {
+		{1004264, 1000000, 0},
+		{1004264, 1000000, 21475},      /* ~10 ppm */
+		{1004264, 1000000, -21475},
+		{70004264, 70000000, 42950},    /* ~20 ppm, long reply */
+		{70004264, 70000000, -42950},
+		{4000004264UL, 4000000000UL, 85900},
+	};
+	static const uint8_t channels[] = {5, 9};
+
+	SIT_CHECK_EQ(sit_tof_ss_q8(1004264, 1000000, 0), 2132 * 256);
+
+	for (size_t c = 0; c < ARRAY_SIZE(channels); c++) {
+		sit_device_config.chan = channels[c];
+		for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+			int64_t tof_q8 = sit_tof_ss_q8(cases[i].round, cases[i].reply,
+						       sit_tof_ci_to_skew_q40(cases[i].ci));
+			/* the Q40 skew is rounded, 1 / 2^40 of the reply */
+			SIT_CHECK_NEAR(tof_q8 / 256.0, ss_tof_double(cases[i].round, cases[i].reply, cases[i].ci), 0.01);
+		}
+	}
+	sit_device_config.chan = 9;
+}
+
+static void test_to_mm(void) {
+	SIT_CHECK_EQ(sit_tof_to_mm(0), 0);
+	SIT_CHECK_EQ(sit_tof_to_mm(256), 5);
+	SIT_CHECK_EQ(sit_tof_to_mm(-256), -5);
+	SIT_CHECK_EQ(sit_tof_to_mm(2132 * 256), 10000);
+	for (int64_t dtu = 0; dtu < 100000; dtu += 997) {
+		double mm = dtu * DWT_TIME_UNITS * SPEED_OF_LIGHT * 1000.0;
+		SIT_CHECK_NEAR(sit_tof_to_mm(dtu * 256), mm, 0.5);
+	}
+}
+
+int main(void) {
+	test_ci_to_skew();
+	test_ds();
+	test_ss();
+	test_to_mm();
+	return sit_test_result("sit_tof");
+}
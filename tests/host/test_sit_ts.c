@@ -0,0 +1,94 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_ts.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the 40 bit timestamp arithmetic around the wrap.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "fake_dw3000.h"
+
+#include "sit/sit_ts.h"
+#include "sit/sit_config.h"
+#include "sit/sit_device.h"
+
+static void test_add(void) {
+	SIT_CHECK_EQ(sit_ts_add(100, 20), 120);
+	SIT_CHECK_EQ(sit_ts_add(SIT_TS_MASK - 9, 20), 10);
+	SIT_CHECK_EQ(sit_ts_add(5, -10), SIT_TS_MASK - 4);
+	SIT_CHECK_EQ(sit_ts_add_uus(0, 1), UUS_TO_DWT_TIME);
+	SIT_CHECK_EQ(sit_ts_add_uus(SIT_TS_MASK, 1), UUS_TO_DWT_TIME - 1);
+}
+
+static void test_diff(void) {
+	SIT_CHECK_EQ(sit_ts_diff(120, 100), 20);
+	SIT_CHECK_EQ(sit_ts_diff(10, SIT_TS_MASK - 9), 20);
+	SIT_CHECK_EQ(sit_ts_diff(SIT_TS_MASK - 9, 10), SIT_TS_MASK - 19);
+	SIT_CHECK_EQ(sit_ts_sdiff(10, SIT_TS_MASK - 9), 20);
+	SIT_CHECK_EQ(sit_ts_sdiff(SIT_TS_MASK - 9, 10), -20);
+	/* half the range is the limit of the signed difference */
+	SIT_CHECK_EQ(sit_ts_sdiff(1ULL << 39, 0), -(1LL << 39));
+	SIT_CHECK_EQ(sit_ts_sdiff((1ULL << 39) - 1, 0), (1LL << 39) - 1);
+
+	SIT_CHECK(sit_ts_before(SIT_TS_MASK - 9, 10));
+	SIT_CHECK(!sit_ts_before(10, SIT_TS_MASK - 9));
+	SIT_CHECK(!sit_ts_before(10, 10));
+}
+
+static void test_tx_time(void) {
+	SIT_CHECK_EQ(sit_ts_to_tx_time(0xFFFFFFFF00ULL), 0xFFFFFFFFUL);
+	SIT_CHECK_EQ(sit_ts_to_tx_time(0x1FFFFFFFFFFULL), 0xFFFFFFFFUL);
+	/* the 32 bit TX time wraps with the 40 bit time */
+	SIT_CHECK_EQ(sit_ts_tx_time_after(SIT_TS_MASK - 100, 1), (UUS_TO_DWT_TIME - 101) >> 8);
+
+	/* bit 0 of the TX time is ignored by the DW3000, the antenna delay is added */
+	SIT_CHECK_EQ(sit_ts_from_tx_time(0x12345679UL), (0x12345678ULL << 8) + get_tx_ant_dly());
+	SIT_CHECK_EQ(sit_ts_from_tx_time(0xFFFFFFFEUL), get_tx_ant_dly() - 512);
+}
+
+static void test_pack(void) {
+	sit_ts40_t packed;
+
+	sit_ts_pack(&packed, 0x0102030405ULL);
+	SIT_CHECK_EQ(packed.b[0], 0x05);
+	SIT_CHECK_EQ(packed.b[4], 0x01);
+	SIT_CHECK_EQ(sit_ts_unpack(&packed), 0x0102030405ULL);
+
+	sit_ts_pack(&packed, 0xAB0102030405ULL);
+	SIT_CHECK_EQ(sit_ts_unpack(&packed), 0x0102030405ULL);
+
+	sit_ts_pack(&packed, SIT_TS_MASK);
+	SIT_CHECK_EQ(sit_ts_unpack(&packed), SIT_TS_MASK);
+}
+
+int main(void) {
+	/* get_tx_ant_dly() reads the antenna delay of the fake DW3000 */
+	fake_dw3000_reset();
+	test_add();
+	test_diff();
+	test_tx_time();
+	test_pack();
+	return sit_test_result("sit_ts");
+}
@@ -0,0 +1,246 @@
+/**********************************************************************************
+ *
+ *  Copyright (C) 2023  Sven Hoyer
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+***********************************************************************************/
+
+
+/**
+ * @file test_sit_twr.c
+ * @author Sven Hoyer (svhoy)
+ * @date 17.10.2026
+ * @brief Host test of the DS-TWR initiator state machine against a
+ *        responder on the fake DW3000.
+ *
+ * @bug No known bugs.
+ */
+
+#include "sit_test.h"
+#include "fake_dw3000.h"
+
+#include "sit/sit.h"
+#include "sit/sit_config.h"
+#include "sit/sit_distance.h"
+#include "sit/sit_event.h"
+#include "sit/sit_frame.h"
+#include "sit/sit_reply.h"
+#include "sit/sit_shadow.h"
+#include "sit/sit_ts.h"
+#include "sit/sit_twr.h"
+#include "sit/sit_tx_template.h"
+
+#include <math.h>
+
+#include <deca_device_api.h>
+
+#define RESPONDER_ID 100
+#define RESPONDER_REPLY_UUS 1000
+#define DISTANCE_MM 3000
+
+/* Behaviour of the simulated responder */
+static struct {
+    uint8_t source;         ///< source ID of its frames
+    uint8_t dest;           ///< destination of the response, 0 -> the initiator
+    bool answer_final;      ///< send the final response (ds_4_twr)
+    sit_ts_t tof_dtu;
+    sit_ts_t poll_rx_ts;
+    sit_ts_t resp_tx_ts;
+    uint32_t finals;        ///< finals received
+} peer;
+
+static void responder_peer(const uint8_t *frame, uint16_t length, uint64_t tx_ts) {
+	ARG_UNUSED(length);
+	const header_t *header = (const header_t *)frame;
+	sit_ts_t rx_ts = sit_ts_add(tx_ts, peer.tof_dtu);
+	uint8_t dest = peer.dest ? peer.dest : header->source;
+
+	if (header->dest != RESPONDER_ID) {
+		return;
+	}
+	if (sit_frame_id(header) == twr_1_poll) {
+		msg_simple_t resp = {SIT_HEADER(ds_twr_2_resp, header->sequence, peer.source, dest), 0};
+		peer.poll_rx_ts = rx_ts;
+		peer.resp_tx_ts = sit_ts_add_uus(rx_ts, RESPONDER_REPLY_UUS);
+		fake_dw3000_air(&resp, sizeof(resp), sit_ts_add(peer.resp_tx_ts, peer.tof_dtu));
+	} else if (sit_frame_id(header) == ds_twr_3_final) {
+		peer.finals++;
+		if (!peer.answer_final) {
+			return;
+		}
+		msg_ds_twr_resp_t final_resp = {SIT_HEADER(ds_twr_4_final, header->sequence, peer.source, dest),
+			{{0}}, {{0}}, {{0}}, 0};
+		sit_ts_pack(&final_resp.poll_rx_ts, peer.poll_rx_ts);
+		sit_ts_pack(&final_resp.resp_tx_ts, peer.resp_tx_ts);
+		sit_ts_pack(&final_resp.final_rx_ts, rx_ts);
+		fake_dw3000_air(&final_resp, sizeof(final_resp),
+				sit_ts_add(sit_ts_add_uus(rx_ts, RESPONDER_REPLY_UUS), peer.tof_dtu));
+	}
+}
+
+static void radio_init(void) {
+	fake_dw3000_reset();
+	fake_dw3000_set_peer(responder_peer);
+	sit_shadow_reset();
+	sit_reply_reset();
+	sit_tpl_init();
+	SIT_CHECK_EQ(sit_event_init(), 0);
+	peer = (typeof(peer)){
+		.source = RESPONDER_ID,
+		.answer_final = true,
+		.tof_dtu = (sit_ts_t)llround(DISTANCE_MM / 1000.0 / SPEED_OF_LIGHT / DWT_TIME_UNITS),
+	};
+}
+
+static void test_ds_4_twr(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+
+	radio_init();
+	SIT_CHECK_EQ(sit_twr_init(ctx, RESPONDER_ID + 2, true), 3);
+	SIT_CHECK_EQ(ctx[2].responder_id, RESPONDER_ID + 2);
+
+	SIT_CHECK(sit_twr_start(&ctx[0], 1, 0));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_poll);
+	/* response in, final out in the same step */
+	SIT_CHECK(!sit_twr_step(&ctx[0], sit_msg_receive()));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_final);
+	SIT_CHECK(sit_twr_step(&ctx[0], sit_msg_receive()));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_report);
+	SIT_CHECK_EQ(ctx[0].ranges, 1);
+	SIT_CHECK_NEAR(ctx[0].distance_mm, DISTANCE_MM, 10);
+	/* both round and reply times come from the timestamps of the frames */
+	SIT_CHECK_EQ(ctx[0].poll_rx_ts, peer.poll_rx_ts);
+	SIT_CHECK_EQ(ctx[0].resp_tx_ts, peer.resp_tx_ts);
+	SIT_CHECK_EQ(ctx[0].time_reply_1, sit_ts_diff(peer.resp_tx_ts, peer.poll_rx_ts));
+}
+
+/* ds_3_twr ends with the final, the receiver is not turned on after it */
+static void test_ds_3_twr(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+	fake_dw3000_stats_t stats;
+
+	radio_init();
+	peer.answer_final = false;
+	sit_twr_init(ctx, RESPONDER_ID, false);
+	fake_dw3000_reset_stats();
+
+	SIT_CHECK(!sit_twr_run(&ctx[0], 1, 0));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_sent);
+	SIT_CHECK(sit_twr_done(&ctx[0]));
+	SIT_CHECK_EQ(peer.finals, 1);
+	fake_dw3000_get_stats(&stats);
+	SIT_CHECK_EQ(stats.tx_frames, 2);
+	SIT_CHECK_EQ(stats.rx_frames, 1);
+	/* poll TX, response RX, final TX, no RX timeout */
+	SIT_CHECK_EQ(stats.irqs, 3);
+}
+
+/* a response of the right responder to another initiator is not taken */
+static void test_response_other_initiator(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+
+	radio_init();
+	peer.dest = device_settings.deviceID + 1;
+	sit_twr_init(ctx, RESPONDER_ID, true);
+
+	SIT_CHECK(!sit_twr_run(&ctx[0], 1, 0));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_timeout);
+	SIT_CHECK_EQ(peer.finals, 0);
+}
+
+static void test_response_other_responder(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+
+	radio_init();
+	peer.source = RESPONDER_ID + 1;
+	sit_twr_init(ctx, RESPONDER_ID, true);
+
+	SIT_CHECK(!sit_twr_run(&ctx[0], 1, 0));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_timeout);
+	SIT_CHECK_EQ(peer.finals, 0);
+}
+
+static void test_no_final_response(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+
+	radio_init();
+	peer.answer_final = false;
+	sit_twr_init(ctx, RESPONDER_ID, true);
+
+	SIT_CHECK(!sit_twr_run(&ctx[0], 1, 0));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_timeout);
+	SIT_CHECK_EQ(peer.finals, 1);
+	SIT_CHECK_EQ(ctx[0].ranges, 0);
+}
+
+/* a delayed poll whose TX time has passed is not sent */
+static void test_missed_poll_slot(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+	fake_dw3000_stats_t stats;
+
+	radio_init();
+	sit_twr_init(ctx, RESPONDER_ID, true);
+	fake_dw3000_reset_stats();
+
+	uint32_t past = sit_ts_to_tx_time(fake_dw3000_time()) - 1;
+	SIT_CHECK(!sit_twr_start(&ctx[0], 1, past));
+	SIT_CHECK_EQ(ctx[0].state, twr_state_timeout);
+	SIT_CHECK(sit_twr_done(&ctx[0]));
+	fake_dw3000_get_stats(&stats);
+	SIT_CHECK_EQ(stats.tx_frames, 0);
+
+	/* a poll in the future is sent at its TX time */
+	uint32_t future = sit_ts_tx_time_after(fake_dw3000_time(), 5000);
+	SIT_CHECK(sit_twr_run(&ctx[0], 2, future));
+	SIT_CHECK_EQ(ctx[0].poll_tx_ts, sit_ts_from_tx_time(future));
+}
+
+static void test_backoff(void) {
+	twr_ctx_t ctx[SIT_TWR_MAX_RESPONDER];
+	static const uint16_t backoffs[] = {1, 2, 4, 8, 8};
+
+	sit_twr_init(ctx, RESPONDER_ID, true);
+	for (size_t i = 0; i < ARRAY_SIZE(backoffs); i++) {
+		ctx[0].state = twr_state_timeout;
+		twr_scheduler_backoff.update(&ctx[0]);
+		SIT_CHECK_EQ(ctx[0].backoff, backoffs[i]);
+		/* skipped for backoff rounds, then ready again */
+		for (uint16_t round = 0; round < backoffs[i]; round++) {
+			SIT_CHECK(!twr_scheduler_backoff.ready(&ctx[0]));
+		}
+		SIT_CHECK(twr_scheduler_backoff.ready(&ctx[0]));
+	}
+
+	/* ds_3_twr exchanges count as success */
+	ctx[0].state = twr_state_sent;
+	twr_scheduler_backoff.update(&ctx[0]);
+	SIT_CHECK_EQ(ctx[0].failures, 0);
+	SIT_CHECK(twr_scheduler_backoff.ready(&ctx[0]));
+
+	ctx[0].state = twr_state_timeout;
+	twr_scheduler_round_robin.update(&ctx[0]);
+	SIT_CHECK(twr_scheduler_round_robin.ready(&ctx[0]));
+}
+
+int main(void) {
+	test_ds_4_twr();
+	test_ds_3_twr();
+	test_response_other_initiator();
+	test_response_other_responder();
+	test_no_final_response();
+	test_missed_poll_slot();
+	test_backoff();
+	return sit_test_result("sit_twr");
+}